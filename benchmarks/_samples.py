@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+벤치마크용 샘플 레코드
+
+실제 DLL 응답과 같은 레이아웃(공백 패딩 + 속성 바이트)의 bytes를 생성합니다.
+"""
+import sys
+from pathlib import Path
+
+# 설치하지 않은 소스 트리에서도 실행 가능하도록 src 경로 추가
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "src"))
+
+from pynamuh.structures.inv.j8 import CTj8OutBlock
+from pynamuh.structures.ord.c8201 import CTc8201OutBlock, CTc8201OutBlock1
+from pynamuh.wmca_simulator import render_record
+
+
+J8_TICK = render_record(CTj8OutBlock, {
+    "code": "005930", "time": "09001234", "sign": "2", "change": "500",
+    "price": "70000", "chrate": "0.72", "high": "71000", "low": "69000",
+    "offer": "70100", "bid": "70000", "volume": "123456", "volrate": "99.12",
+    "movolume": "10", "value": "86420", "open": "69500", "avgprice": "70010",
+    "janggubun": "1",
+})
+
+C8201_SUMMARY = render_record(CTc8201OutBlock, {
+    "dpsit_amtz16": "1000000", "chgm_pos_amtz16": "950000", "coltr_ratez6": "123.45",
+    "order_pos_csamtz16": "900000", "bal_buy_ttamtz16": "650000", "bal_ass_ttamtz16": "700000",
+    "asset_tot_amtz16": "1700000", "tot_eal_plsz18": "50000", "pft_rtz15": "7.69",
+})
+
+C8201_HOLDING = render_record(CTc8201OutBlock1, {
+    "issue_codez6": "005930", "issue_namez40": "삼성전자", "bal_typez6": "현금",
+    "bal_qtyz16": "10", "slby_amtz16": "65000", "prsnt_pricez16": "70000",
+    "lsnpf_amtz16": "50", "earn_ratez9": "7.69", "jan_qtyz16": "10", "ass_amtz16": "700000",
+})
+
+# 보유종목 20건 (c8201OutBlock1 최대 반복 수)
+C8201_HOLDINGS = C8201_HOLDING * 20
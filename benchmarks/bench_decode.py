@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+OutBlock 디코딩 벤치마크
+
+리플렉션 경로(from_buffer_copy + OutBlock._from_c_struct_reflect, 이전 구현)와
+블록 전용 디코더(BlockDecoder)의 레코드당 디코딩 비용을 비교합니다.
+("cols"는 반복 블록을 컬럼(Columns)으로 디코딩하는 경우,
+ "typed"는 리플렉션 결과를 소비자가 숫자로 다시 변환하는 비용과 typed 디코더를 비교)
+
+마지막 표는 틱에서 필드 3개(code, price, volume)만 읽는 경우
+전체 디코딩(decode)과 BlockView(view, decode="view")를 비교합니다.
+
+실행:
+    python benchmarks/bench_decode.py
+"""
+import ctypes
+import dataclasses
+import timeit
+from typing import Union, get_args, get_origin
+
+from _samples import J8_TICK, C8201_HOLDING, C8201_HOLDINGS
+
+from pynamuh.structures.decoder import get_decoder, FIELD_CONVERTERS
+from pynamuh.structures.inv.j8 import CTj8OutBlock, Tj8OutBlock
+from pynamuh.structures.ord.c8201 import CTc8201OutBlock1, Tc8201OutBlock1
+
+
+def reflect_single(data, struct_class, model_class):
+    return model_class._from_c_struct_reflect(struct_class.from_buffer_copy(data[:ctypes.sizeof(struct_class)]))
+
+
+def reflect_array(data, struct_class, model_class):
+    size = ctypes.sizeof(struct_class)
+    return [
+        model_class._from_c_struct_reflect(struct_class.from_buffer_copy(data[i:i + size]))
+        for i in range(0, len(data) // size * size, size)
+    ]
+
+
+def field_type(annotation):
+    """Optional[X] → X"""
+    if get_origin(annotation) is Union:
+        return next(arg for arg in get_args(annotation) if arg is not type(None))
+    return annotation
+
+
+def reflect_typed(data, struct_class, model_class):
+    """리플렉션 결과(str)를 소비자가 어노테이션 타입으로 다시 변환하는 경우 (부호 적용 포함)"""
+    record = reflect_single(data, struct_class, model_class)
+    values = {}
+    for f in dataclasses.fields(model_class):
+        converter = FIELD_CONVERTERS.get(field_type(f.type))
+        value = getattr(record, f.name)
+        values[f.name] = converter(value) if converter is not None else value
+    if model_class.SIGN_FIELD and values[model_class.SIGN_FIELD] in model_class.NEGATIVE_SIGNS:
+        for name in model_class.SIGNED_FIELDS:
+            if values[name] is not None:
+                values[name] = -abs(values[name])
+    return model_class(**values)
+
+
+def read_three(record):
+    return record.code, record.price, record.volume
+
+
+def measure(func, number: int) -> float:
+    """호출당 평균 시간 (마이크로초, 5회 반복 중 최소값)"""
+    return min(timeit.repeat(func, number=number, repeat=5)) / number * 1e6
+
+
+def main():
+    j8 = get_decoder(CTj8OutBlock, Tj8OutBlock, typed=False)
+    c1 = get_decoder(CTc8201OutBlock1, Tc8201OutBlock1, typed=False)
+    j8_typed = get_decoder(CTj8OutBlock, Tj8OutBlock)
+    c1_typed = get_decoder(CTc8201OutBlock1, Tc8201OutBlock1)
+
+    assert j8.decode(J8_TICK) == reflect_single(J8_TICK, CTj8OutBlock, Tj8OutBlock)
+    assert c1.decode_array(C8201_HOLDINGS, 20) == reflect_array(C8201_HOLDINGS, CTc8201OutBlock1, Tc8201OutBlock1)
+    assert c1.decode_columns(C8201_HOLDINGS, 20).rows() == c1.decode_array(C8201_HOLDINGS, 20)
+    assert j8_typed.decode(J8_TICK) == reflect_typed(J8_TICK, CTj8OutBlock, Tj8OutBlock)
+    assert c1_typed.decode(C8201_HOLDING) == reflect_typed(C8201_HOLDING, CTc8201OutBlock1, Tc8201OutBlock1)
+
+    cases = [
+        ("j8 tick", 20000,
+         lambda: reflect_single(J8_TICK, CTj8OutBlock, Tj8OutBlock),
+         lambda: j8.decode(J8_TICK)),
+        ("c8201OutBlock1 x1", 20000,
+         lambda: reflect_single(C8201_HOLDING, CTc8201OutBlock1, Tc8201OutBlock1),
+         lambda: c1.decode(C8201_HOLDING)),
+        ("c8201OutBlock1 x20", 1000,
+         lambda: reflect_array(C8201_HOLDINGS, CTc8201OutBlock1, Tc8201OutBlock1),
+         lambda: c1.decode_array(C8201_HOLDINGS, 20)),
+        ("c8201OutBlock1 cols", 1000,
+         lambda: reflect_array(C8201_HOLDINGS, CTc8201OutBlock1, Tc8201OutBlock1),
+         lambda: c1.decode_columns(C8201_HOLDINGS, 20)),
+        ("j8 tick typed", 20000,
+         lambda: reflect_typed(J8_TICK, CTj8OutBlock, Tj8OutBlock),
+         lambda: j8_typed.decode(J8_TICK)),
+        ("c8201OutBlock1 typed", 20000,
+         lambda: reflect_typed(C8201_HOLDING, CTc8201OutBlock1, Tc8201OutBlock1),
+         lambda: c1_typed.decode(C8201_HOLDING)),
+    ]
+
+    print(f"{'case':<22}{'reflect(us)':>14}{'decoder(us)':>14}{'speedup':>10}")
+    for name, number, reflect, decoder in cases:
+        before = measure(reflect, number)
+        after = measure(decoder, number)
+        print(f"{name:<22}{before:>14.2f}{after:>14.2f}{before / after:>9.1f}x")
+
+    assert read_three(j8_typed.view(J8_TICK)) == read_three(j8_typed.decode(J8_TICK))
+    views = [
+        ("j8 read 3 fields", 20000,
+         lambda: read_three(j8_typed.decode(J8_TICK)),
+         lambda: read_three(j8_typed.view(J8_TICK))),
+        ("c8201OutBlock1 x20 1f", 1000,
+         lambda: [r.jan_qtyz16 for r in c1_typed.decode_array(C8201_HOLDINGS, 20)],
+         lambda: [r.jan_qtyz16 for r in c1_typed.view_array(C8201_HOLDINGS, 20)]),
+    ]
+
+    print()
+    print(f"{'case':<22}{'decode(us)':>14}{'view(us)':>14}{'speedup':>10}")
+    for name, number, decode, view in views:
+        before = measure(decode, number)
+        after = measure(view, number)
+        print(f"{name:<22}{before:>14.2f}{after:>14.2f}{before / after:>9.1f}x")
+
+
+if __name__ == "__main__":
+    main()
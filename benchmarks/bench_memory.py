@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+틱 보관 메모리 벤치마크
+
+j8 틱 N건을 리스트에 보관했을 때 틱당 메모리(bytes)를 tracemalloc으로 측정합니다.
+(리스트 원소 포인터 8 bytes 포함)
+
+- dict dataclass: 이전 구현 (@dataclass, 인스턴스별 __dict__)
+- slots: @dataclass(slots=True) OutDataBlock → Received → Tj8OutBlock
+- flat: FlatOutDataBlock (WMCAAgent(envelope=False))
+- szData only: 봉투 없이 Tj8OutBlock만 보관
+- view: BlockView (decode="view", 원시 bytes 포함)
+
+실행:
+    python benchmarks/bench_memory.py
+"""
+import dataclasses
+import gc
+import tracemalloc
+
+from _samples import J8_TICK
+
+from pynamuh.structures.common import OutDataBlock, FlatOutDataBlock, Received
+from pynamuh.structures.decoder import get_decoder
+from pynamuh.structures.inv.j8 import CTj8OutBlock, Tj8OutBlock
+
+TICKS = 20000
+
+
+def unslotted(cls):
+    """같은 필드의 __dict__ 기반 dataclass (이전 구현 재현)"""
+    return dataclasses.make_dataclass(
+        f"Dict{cls.__name__}", [(f.name, f.type) for f in dataclasses.fields(cls)]
+    )
+
+
+DictTj8OutBlock = unslotted(Tj8OutBlock)
+DictReceived = unslotted(Received)
+DictOutDataBlock = unslotted(OutDataBlock)
+J8_FIELDS = [f.name for f in dataclasses.fields(Tj8OutBlock)]
+
+
+def retained_bytes(make_tick) -> float:
+    """make_tick()으로 만든 틱 TICKS건을 보관할 때 틱당 메모리 (bytes)"""
+    gc.collect()
+    tracemalloc.start()
+    before = tracemalloc.get_traced_memory()[0]
+    history = [make_tick() for _ in range(TICKS)]
+    after = tracemalloc.get_traced_memory()[0]
+    tracemalloc.stop()
+    del history
+    return (after - before) / TICKS
+
+
+def main():
+    j8 = get_decoder(CTj8OutBlock, Tj8OutBlock)
+    size = len(J8_TICK)
+
+    def block_name() -> str:
+        return b"j8".decode("cp949")  # 콜백마다 새로 디코딩되는 블록명
+
+    def dict_dataclass():
+        record = j8.decode(J8_TICK)
+        block = DictTj8OutBlock(*[getattr(record, name) for name in J8_FIELDS])
+        return DictOutDataBlock(0, DictReceived(block_name(), block, size))
+
+    def view_read():
+        view = j8.view(bytes(J8_TICK))
+        view.code, view.price, view.volume
+        return view
+
+    cases = [
+        ("dict dataclass", dict_dataclass),
+        ("slots", lambda: OutDataBlock(0, Received(block_name(), j8.decode(J8_TICK), size))),
+        ("flat", lambda: FlatOutDataBlock(0, block_name(), j8.decode(J8_TICK), size)),
+        ("szData only", lambda: j8.decode(J8_TICK)),
+        ("view", lambda: j8.view(bytes(J8_TICK))),
+        ("view (3 fields read)", view_read),
+    ]
+
+    baseline = None
+    print(f"{'case':<24}{'bytes/tick':>12}{'vs dict':>10}")
+    for name, make_tick in cases:
+        per_tick = retained_bytes(make_tick)
+        baseline = baseline or per_tick
+        print(f"{name:<24}{per_tick:>12.0f}{per_tick / baseline:>9.2f}x")
+
+
+if __name__ == "__main__":
+    main()
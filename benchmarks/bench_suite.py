@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+핫패스 벤치마크 모음 (JSON 결과 + 기준선 비교)
+
+측정 항목:
+    parse.*     Received._auto_parse (j8 틱 1건, c8201OutBlock1 20건 / 컬럼 / 뷰)
+    encode.*    InBlock.to_c_struct() + string_at 복사 (query()의 입력 변환)
+    dispatch.*  WMCAAgent._handle_wmca_event (lparam 파싱 + 큐 적재, 소비자 get 포함)
+    e2e.*       SimulatorTransport로 receive_events()/receive_batch() 전체 경로 처리량
+
+us/op 항목은 낮을수록, events/s 항목은 높을수록 좋습니다.
+Windows와 DLL 없이 실행됩니다. (Linux, CI 포함)
+
+실행:
+    python benchmarks/bench_suite.py                                  # 표 출력
+    python benchmarks/bench_suite.py --json result.json               # JSON 저장
+    python benchmarks/bench_suite.py --save-baseline baseline.json    # 기준선 저장
+    python benchmarks/bench_suite.py --baseline baseline.json         # 기준선 대비 비교 (회귀 시 종료 코드 1)
+
+기준선은 측정한 머신/파이썬 버전에서만 의미가 있으므로 같은 환경에서 저장하고 비교하세요.
+"""
+import argparse
+import ctypes
+import json
+import os
+import platform
+import sys
+import time
+import timeit
+from datetime import datetime
+from typing import Callable, Dict, List, Optional
+
+from _samples import J8_TICK, C8201_HOLDINGS
+
+from pynamuh import WMCAAgent, WMCAMessage
+from pynamuh.structures import decoder
+from pynamuh.structures.common import Received
+from pynamuh.structures.ord.c8201 import Tc8201InBlock
+from pynamuh.wmca_logger import configure_logging
+from pynamuh.wmca_simulator import SimulatorTransport
+from pynamuh.wmca_transport import OutDataBlockBuffer
+
+SCHEMA = 1
+DEFAULT_THRESHOLD = 0.20
+
+US_PER_OP = "us/op"
+EVENTS_PER_SEC = "events/s"
+
+
+# ============================================================================
+# 측정
+# ============================================================================
+
+def measure(func: Callable[[], object], number: int) -> float:
+    """호출당 평균 시간 (마이크로초, 5회 반복 중 최소값)"""
+    return min(timeit.repeat(func, number=number, repeat=5)) / number * 1e6
+
+
+def throughput(run: Callable[[], int], repeat: int = 3) -> float:
+    """run()이 처리한 이벤트 수 / 경과 시간 (repeat회 중 최대값)"""
+    best = 0.0
+    for _ in range(repeat):
+        start = time.perf_counter()
+        count = run()
+        best = max(best, count / (time.perf_counter() - start))
+    return best
+
+
+def bench_parse(scale: float) -> Dict[str, float]:
+    j8_len = len(J8_TICK)
+    c1_len = len(C8201_HOLDINGS)
+    n = max(1, int(20000 * scale))
+    m = max(1, int(1000 * scale))
+    return {
+        "parse.j8": measure(lambda: Received._auto_parse("j8", J8_TICK, j8_len), n),
+        "parse.j8.str": measure(lambda: Received._auto_parse("j8", J8_TICK, j8_len, typed=False), n),
+        "parse.c8201OutBlock1x20": measure(
+            lambda: Received._auto_parse("c8201OutBlock1", C8201_HOLDINGS, c1_len), m),
+        "parse.c8201OutBlock1x20.columnar": measure(
+            lambda: Received._auto_parse("c8201OutBlock1", C8201_HOLDINGS, c1_len, columnar=True), m),
+        "parse.c8201OutBlock1x20.view": measure(
+            lambda: Received._auto_parse("c8201OutBlock1", C8201_HOLDINGS, c1_len, view=True), m),
+    }
+
+
+def bench_encode(scale: float) -> Dict[str, float]:
+    inblock = Tc8201InBlock(pswd_noz44="A" * 44, bnc_bse_cdz1="1")
+
+    def encode() -> bytes:
+        # WMCAAgent.query()의 입력 변환과 동일
+        c_struct = inblock.to_c_struct()
+        return ctypes.string_at(ctypes.addressof(c_struct), ctypes.sizeof(c_struct))
+
+    return {"encode.c8201InBlock": measure(encode, max(1, int(20000 * scale)))}
+
+
+def bench_dispatch(scale: float) -> Dict[str, float]:
+    results = {}
+    buffer = OutDataBlockBuffer()
+    sise_data = b"j8|" + J8_TICK
+    sise = WMCAMessage.CA_RECEIVESISE.value
+    data = WMCAMessage.CA_RECEIVEDATA.value
+    n = max(1, int(20000 * scale))
+    m = max(1, int(1000 * scale))
+    for decode in ("eager", "view", "raw"):
+        agent = WMCAAgent(transport=SimulatorTransport(), decode=decode)
+        handle = agent._handle_wmca_event
+        get = agent.message_queue.get_nowait
+        lparam = buffer.fill(0, b"j8", sise_data)
+
+        def dispatch_sise():
+            handle(sise, lparam)
+            return get()
+
+        results[f"dispatch.sise.{decode}"] = measure(dispatch_sise, n)
+
+    agent = WMCAAgent(transport=SimulatorTransport())
+    handle = agent._handle_wmca_event
+    get = agent.message_queue.get_nowait
+    holdings = buffer.fill(1, b"c8201OutBlock1", C8201_HOLDINGS)
+
+    def dispatch_data():
+        handle(data, holdings)
+        return get()
+
+    results["dispatch.c8201OutBlock1x20"] = measure(dispatch_data, m)
+    return results
+
+
+def bench_e2e(scale: float) -> Dict[str, float]:
+    ticks = max(1000, int(50_000 * scale))
+
+    def run(threaded: bool, batch: bool, decode: str = "eager") -> Callable[[], int]:
+        def body() -> int:
+            sim = SimulatorTransport(tick_rate=None, max_ticks=ticks, seed=0)
+            count = 0
+            with WMCAAgent(transport=sim, threaded=threaded, decode=decode) as agent:
+                agent.connect("bench", "pw", "cert")
+                agent.attach("j8", "005930000660035420", 6, 18)
+                if batch:
+                    while events := agent.receive_batch(timeout=1.0):
+                        count += len(events)
+                else:
+                    for _ in agent.receive_events(timeout=60.0):
+                        count += 1
+            return count
+        return body
+
+    return {
+        "e2e.receive_events": throughput(run(False, False)),
+        "e2e.receive_batch": throughput(run(False, True)),
+        "e2e.receive_batch.view": throughput(run(False, True, "view")),
+        "e2e.threaded.receive_batch": throughput(run(True, True)),
+    }
+
+
+GROUPS = {
+    "parse": (bench_parse, US_PER_OP),
+    "encode": (bench_encode, US_PER_OP),
+    "dispatch": (bench_dispatch, US_PER_OP),
+    "e2e": (bench_e2e, EVENTS_PER_SEC),
+}
+
+
+def run_suite(groups: List[str], scale: float) -> dict:
+    results = {}
+    for group in groups:
+        func, unit = GROUPS[group]
+        for name, value in func(scale).items():
+            results[name] = {"value": value, "unit": unit, "higher_is_better": unit == EVENTS_PER_SEC}
+    return {
+        "schema": SCHEMA,
+        "meta": {
+            "timestamp": datetime.now().isoformat(timespec="seconds"),
+            "python": platform.python_version(),
+            "implementation": platform.python_implementation(),
+            "platform": platform.platform(),
+            "machine": platform.machine(),
+            "native_decoder": decoder._fastdecode is not None,
+            "scale": scale,
+        },
+        "results": results,
+    }
+
+
+# ============================================================================
+# 기준선 비교
+# ============================================================================
+
+def compare(current: dict, baseline: dict, threshold: float) -> List[str]:
+    """기준선 대비 표 출력, threshold 이상 느려진 항목 이름 목록 반환"""
+    regressions = []
+    base_results = baseline.get("results", {})
+    print(f"{'case':<36}{'baseline':>14}{'current':>14}{'change':>10}  status")
+    for name, entry in current["results"].items():
+        base = base_results.get(name)
+        value = entry["value"]
+        if base is None:
+            print(f"{name:<36}{'-':>14}{value:>14.2f}{'':>10}  new")
+            continue
+        # 양수면 개선, 음수면 악화 (단위 방향 보정)
+        change = (value - base["value"]) / base["value"]
+        if not entry["higher_is_better"]:
+            change = -change
+        status = "ok"
+        if change < -threshold:
+            status = "REGRESSION"
+            regressions.append(name)
+        elif change > threshold:
+            status = "faster"
+        print(f"{name:<36}{base['value']:>14.2f}{value:>14.2f}{change:>+9.1%}  {status}")
+    for name in base_results.keys() - current["results"].keys():
+        print(f"{name:<36}{base_results[name]['value']:>14.2f}{'-':>14}{'':>10}  missing")
+
+    base_meta, meta = baseline.get("meta", {}), current["meta"]
+    for key in ("python", "machine", "native_decoder"):
+        if base_meta.get(key) != meta.get(key):
+            print(f"주의: 기준선과 환경이 다릅니다 ({key}: {base_meta.get(key)} → {meta.get(key)})")
+    return regressions
+
+
+def print_results(current: dict):
+    print(f"{'case':<36}{'value':>14}  unit")
+    for name, entry in current["results"].items():
+        print(f"{name:<36}{entry['value']:>14.2f}  {entry['unit']}")
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description="pynamuh 핫패스 벤치마크")
+    parser.add_argument("--json", metavar="PATH", help="결과 JSON 저장 경로 (-이면 stdout)")
+    parser.add_argument("--baseline", metavar="PATH", help="비교할 기준선 JSON")
+    parser.add_argument("--save-baseline", metavar="PATH", help="결과를 기준선으로 저장")
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD,
+                        help=f"회귀로 판단할 악화 비율 (기본값 {DEFAULT_THRESHOLD})")
+    parser.add_argument("--only", action="append", choices=sorted(GROUPS),
+                        help="지정한 그룹만 실행 (여러 번 지정 가능)")
+    parser.add_argument("--scale", type=float, default=1.0, help="반복 횟수 배율 (빠른 확인은 0.1)")
+    args = parser.parse_args(argv)
+
+    configure_logging(level="WARNING")
+    current = run_suite(args.only or list(GROUPS), args.scale)
+
+    if args.json == "-":
+        json.dump(current, sys.stdout, indent=2)
+        print()
+    else:
+        if args.json:
+            with open(args.json, "w", encoding="utf-8") as f:
+                json.dump(current, f, indent=2)
+        if not args.baseline:
+            print_results(current)
+
+    if args.save_baseline:
+        os.makedirs(os.path.dirname(os.path.abspath(args.save_baseline)), exist_ok=True)
+        with open(args.save_baseline, "w", encoding="utf-8") as f:
+            json.dump(current, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as f:
+            baseline = json.load(f)
+        regressions = compare(current, baseline, args.threshold)
+        if regressions:
+            print(f"\n회귀 {len(regressions)}건 (threshold {args.threshold:.0%}): {', '.join(regressions)}")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
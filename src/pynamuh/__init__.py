@@ -8,27 +8,43 @@ __license__ = "MIT"
 
 
 import sys
-# Windows 환경 확인
-if sys.platform != "win32":
-    raise ImportError("이 모듈은 Windows 환경에서만 실행 가능합니다.")
-    sys.exit(1)
-
-# 32비트 Python 확인
 import platform
-if platform.architecture()[0] != "32bit":
-    print(f"현재 Python: {platform.architecture()[0]}")
-    print(f"wmca.dll 요구사항: 32bit")
-    print("\n32비트 Python을 설치하고 다음과 같이 실행하세요:")
-    print("  py -3.11-32 wmca_login_with_msg.py")
-    print("=" * 70)
-    raise ImportError("이 모듈은 32비트 Python에서만 실행 가능합니다.")
 
 # Public API
-from .wmca_agent import WMCAAgent, WMCAMessage
-
-
 __all__ = [
     # Main API
     "WMCAAgent",
-    "WMCAMessage"
+    "WMCAMessage",
+    # TR 조회 future / 스케줄러
+    "QueryError",
+    "QueryScheduler",
+    "RateLimit",
+    "Priority",
+    "QueryCache",
+    # 실시간 구독 관리
+    "SubscriptionManager",
+    # asyncio
+    "AsyncWMCAAgent",
+    # 저널 재생 (플랫폼 무관)
+    "ReplayTransport",
 ]
+
+# wmca.dll(Win32Transport)은 Windows 32비트 Python에서만 사용 가능합니다.
+# (structures 등 파싱 모듈과 ReplayTransport 재생은 플랫폼과 무관하게 사용 가능)
+if sys.platform == "win32":
+    # 32비트 Python 확인
+    if platform.architecture()[0] != "32bit":
+        print(f"현재 Python: {platform.architecture()[0]}")
+        print(f"wmca.dll 요구사항: 32bit")
+        print("\n32비트 Python을 설치하고 다음과 같이 실행하세요:")
+        print("  py -3.11-32 wmca_login_with_msg.py")
+        print("=" * 70)
+        raise ImportError("이 모듈은 32비트 Python에서만 실행 가능합니다.")
+
+from .wmca_agent import WMCAAgent, WMCAMessage
+from .wmca_correlator import QueryError
+from .wmca_scheduler import QueryScheduler, RateLimit, Priority
+from .wmca_cache import QueryCache
+from .wmca_subscription import SubscriptionManager
+from .wmca_async import AsyncWMCAAgent
+from .wmca_replay import ReplayTransport
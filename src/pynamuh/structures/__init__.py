@@ -0,0 +1,6 @@
+"""WMCA 구조체 패키지
+
+기본 블록 모듈을 import하여 파서 레지스트리(parser_info)에 등록합니다.
+"""
+from .inv import j8 as _j8  # noqa: F401  (j8 실시간 체결)
+from .ord import c8201 as _c8201  # noqa: F401  (c8201 잔고조회)
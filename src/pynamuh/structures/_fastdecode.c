@@ -0,0 +1,693 @@
+/*
+ * _fastdecode - 고정폭 레코드 디코더 (선택적 C 확장 모듈)
+ *
+ * structures/decoder.py의 BlockDecoder가 이 모듈이 있으면 사용하고, 없으면 순수 Python
+ * 경로를 사용합니다. Windows 의존성이 없으므로 Linux에서도 빌드/실행됩니다.
+ *
+ * 필드 디코딩 규칙은 ctypes c_char 배열 getattr + bytes.decode("cp949", "ignore").strip()과
+ * 동일합니다.
+ *   1. 첫 NUL에서 잘라냄
+ *   2. ASCII면 바로 str 생성 후 공백 제거 (str.strip()의 ASCII 공백 집합과 동일)
+ *   3. 비ASCII면 cp949로 디코딩한 뒤 str.strip() 호출
+ *
+ * 타입 변환 (BlockDecoder typed=True):
+ *   - FIELD_INT: 공백/부호/숫자만 있으면 C에서 바로 int 생성 (빈 필드는 None),
+ *     그 외 형식은 변환 함수(decoder._to_int)에 위임
+ *   - FIELD_TIME: HH:MM:SS / HHMMSS / HHMM / HHMMSSss면 C에서 바로 datetime.time 생성,
+ *     그 외 형식은 변환 함수(decoder._to_time)에 위임
+ *   - FIELD_CALL: 디코딩한 str을 변환 함수에 전달 (Decimal)
+ *   - 형식이 맞지 않는 필드는 변환 함수가 None을 반환 (예외로 레코드를 버리지 않음)
+ *   - signed 필드는 레코드의 부호 필드가 음수 부호면 -abs(값) (부호 필드가 부호를 결정)
+ *
+ * 빌드:
+ *   python tools/build_fastdecode.py
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <datetime.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Py_FALLTHROUGH는 Python 3.13부터 제공 */
+#ifndef Py_FALLTHROUGH
+#  if defined(__has_attribute)
+#    if __has_attribute(fallthrough)
+#      define Py_FALLTHROUGH __attribute__((fallthrough))
+#    endif
+#  endif
+#  ifndef Py_FALLTHROUGH
+#    define Py_FALLTHROUGH do { } while (0)
+#  endif
+#endif
+
+enum {
+    FIELD_STR = 0,
+    FIELD_INT = 1,
+    FIELD_CALL = 2,
+    FIELD_TIME = 3,
+};
+
+typedef struct {
+    Py_ssize_t offset;
+    Py_ssize_t width;
+    int kind;               /* FIELD_STR / FIELD_INT / FIELD_CALL / FIELD_TIME */
+    int is_signed;          /* 부호 필드 적용 여부 */
+    PyObject *converter;    /* FIELD_INT/FIELD_CALL의 변환 함수 (FIELD_STR이면 NULL) */
+} FieldSpec;
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *model;        /* 디코딩 결과로 생성할 클래스 (필드 순서대로 위치 인자) */
+    Py_ssize_t size;        /* 레코드 크기 */
+    Py_ssize_t nfields;
+    FieldSpec *fields;
+    Py_ssize_t sign_offset; /* 부호 필드 오프셋 (없으면 -1) */
+    Py_ssize_t sign_width;
+    char negatives[16];     /* 음수 부호 문자 (NUL 종료) */
+} LayoutObject;
+
+/* str.strip()이 제거하는 ASCII 공백: \t \n \v \f \r, 0x1C-0x1F, ' ' */
+static inline int
+is_ascii_space(unsigned char c)
+{
+    return c == ' ' || (c >= 0x09 && c <= 0x0D) || (c >= 0x1C && c <= 0x1F);
+}
+
+/* PyErr_Format은 ASCII 형식 문자열만 허용하므로 UTF-8 메시지는 snprintf로 만든다 */
+static void
+set_size_error(Py_ssize_t len, Py_ssize_t required)
+{
+    char message[96];
+    snprintf(message, sizeof(message), "데이터 크기 부족: len=%zd, required=%zd", len, required);
+    PyErr_SetString(PyExc_ValueError, message);
+}
+
+static PyObject *
+decode_field(const unsigned char *p, Py_ssize_t n)
+{
+    const unsigned char *nul = memchr(p, 0, (size_t)n);
+    Py_ssize_t i, start, end;
+    PyObject *text, *stripped;
+
+    if (nul != NULL) {
+        n = nul - p;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (p[i] & 0x80) {
+            break;
+        }
+    }
+
+    if (i == n) {
+        /* ASCII 빠른 경로 */
+        start = 0;
+        end = n;
+        while (start < end && is_ascii_space(p[start])) {
+            start++;
+        }
+        while (end > start && is_ascii_space(p[end - 1])) {
+            end--;
+        }
+        text = PyUnicode_New(end - start, 127);
+        if (text == NULL) {
+            return NULL;
+        }
+        memcpy(PyUnicode_1BYTE_DATA(text), p + start, (size_t)(end - start));
+        return text;
+    }
+
+    /* cp949 경로 */
+    text = PyUnicode_Decode((const char *)p, n, "cp949", "ignore");
+    if (text == NULL) {
+        return NULL;
+    }
+    stripped = PyObject_CallMethod(text, "strip", NULL);
+    Py_DECREF(text);
+    return stripped;
+}
+
+/* 공백 + 선택적 부호 + 숫자(18자리 이하)만 있으면 C에서 바로 변환. 그 외는 1 반환 (위임) */
+static int
+parse_int_field(const unsigned char *p, Py_ssize_t n, PyObject **out)
+{
+    const unsigned char *nul = memchr(p, 0, (size_t)n);
+    Py_ssize_t start = 0, end, digits;
+    long long value = 0;
+    int negative = 0;
+
+    if (nul != NULL) {
+        n = nul - p;
+    }
+    end = n;
+    while (start < end && is_ascii_space(p[start])) {
+        start++;
+    }
+    while (end > start && is_ascii_space(p[end - 1])) {
+        end--;
+    }
+    if (start == end) {
+        *out = Py_NewRef(Py_None);
+        return 0;
+    }
+    if (p[start] == '+' || p[start] == '-') {
+        negative = p[start] == '-';
+        start++;
+    }
+    digits = end - start;
+    if (digits == 0 || digits > 18) {
+        return 1;
+    }
+    for (; start < end; start++) {
+        if (p[start] < '0' || p[start] > '9') {
+            return 1;
+        }
+        value = value * 10 + (p[start] - '0');
+    }
+    *out = PyLong_FromLongLong(negative ? -value : value);
+    return *out == NULL ? -1 : 0;
+}
+
+/* HH:MM:SS, HHMMSS, HHMM, HHMMSSss(1/100초)를 C에서 바로 변환. 그 외는 1 반환 (위임) */
+static int
+parse_time_field(const unsigned char *p, Py_ssize_t n, PyObject **out)
+{
+    const unsigned char *nul = memchr(p, 0, (size_t)n);
+    Py_ssize_t start = 0, end, i;
+    int digits[8], count = 0, hour, minute, second = 0, usec = 0;
+
+    if (nul != NULL) {
+        n = nul - p;
+    }
+    end = n;
+    while (start < end && is_ascii_space(p[start])) {
+        start++;
+    }
+    while (end > start && is_ascii_space(p[end - 1])) {
+        end--;
+    }
+    if (start == end) {
+        *out = Py_NewRef(Py_None);
+        return 0;
+    }
+    for (i = start; i < end; i++) {
+        if (p[i] == ':') {
+            continue;
+        }
+        if (p[i] < '0' || p[i] > '9' || count == 8) {
+            return 1;
+        }
+        digits[count++] = p[i] - '0';
+    }
+    if (count != 4 && count != 6 && count != 8) {
+        return 1;
+    }
+    hour = digits[0] * 10 + digits[1];
+    minute = digits[2] * 10 + digits[3];
+    if (count >= 6) {
+        second = digits[4] * 10 + digits[5];
+    }
+    if (count == 8) {
+        usec = (digits[6] * 10 + digits[7]) * 10000;
+    }
+    if (hour > 23 || minute > 59 || second > 59) {
+        return 1;
+    }
+    *out = PyTime_FromTime(hour, minute, second, usec);
+    return *out == NULL ? -1 : 0;
+}
+
+static int
+record_is_negative(LayoutObject *self, const unsigned char *rec)
+{
+    const unsigned char *p;
+    Py_ssize_t start = 0, end;
+
+    if (self->sign_offset < 0) {
+        return 0;
+    }
+    p = rec + self->sign_offset;
+    end = self->sign_width;
+    {
+        const unsigned char *nul = memchr(p, 0, (size_t)end);
+        if (nul != NULL) {
+            end = nul - p;
+        }
+    }
+    while (start < end && is_ascii_space(p[start])) {
+        start++;
+    }
+    while (end > start && is_ascii_space(p[end - 1])) {
+        end--;
+    }
+    return end - start == 1 && p[start] != 0 && strchr(self->negatives, p[start]) != NULL;
+}
+
+/* 필드 1개 디코딩 + 타입 변환 + 부호 적용 (새 참조 반환) */
+static PyObject *
+decode_value(const FieldSpec *field, const unsigned char *rec, int negative)
+{
+    const unsigned char *p = rec + field->offset;
+    PyObject *value = NULL, *text, *magnitude, *negated;
+    int status;
+
+    switch (field->kind) {
+    case FIELD_STR:
+        return decode_field(p, field->width);
+    case FIELD_INT:
+    case FIELD_TIME:
+        status = field->kind == FIELD_INT
+            ? parse_int_field(p, field->width, &value)
+            : parse_time_field(p, field->width, &value);
+        if (status < 0) {
+            return NULL;
+        }
+        if (status == 0) {
+            break;
+        }
+        /* 변환 함수에 위임 */
+        Py_FALLTHROUGH;
+    default:
+        text = decode_field(p, field->width);
+        if (text == NULL) {
+            return NULL;
+        }
+        value = PyObject_CallOneArg(field->converter, text);
+        Py_DECREF(text);
+        if (value == NULL) {
+            return NULL;
+        }
+        break;
+    }
+
+    if (negative && field->is_signed && value != Py_None) {
+        magnitude = PyNumber_Absolute(value);
+        Py_DECREF(value);
+        if (magnitude == NULL) {
+            return NULL;
+        }
+        negated = PyNumber_Negative(magnitude);
+        Py_DECREF(magnitude);
+        return negated;
+    }
+    return value;
+}
+
+static PyObject *
+decode_at(LayoutObject *self, const unsigned char *rec)
+{
+    PyObject *small[32];
+    PyObject **args = small;
+    PyObject *result = NULL;
+    Py_ssize_t i, done = 0;
+    int negative = record_is_negative(self, rec);
+
+    if (self->nfields > 32) {
+        args = PyMem_Malloc(sizeof(PyObject *) * (size_t)self->nfields);
+        if (args == NULL) {
+            return PyErr_NoMemory();
+        }
+    }
+
+    for (i = 0; i < self->nfields; i++) {
+        args[i] = decode_value(&self->fields[i], rec, negative);
+        if (args[i] == NULL) {
+            goto done;
+        }
+        done++;
+    }
+
+    result = PyObject_Vectorcall(self->model, args, (size_t)self->nfields, NULL);
+
+done:
+    for (i = 0; i < done; i++) {
+        Py_DECREF(args[i]);
+    }
+    if (args != small) {
+        PyMem_Free(args);
+    }
+    return result;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Layout 타입                                                               */
+/* ------------------------------------------------------------------------ */
+
+static void
+free_fields(FieldSpec *fields, Py_ssize_t n)
+{
+    Py_ssize_t i;
+
+    if (fields == NULL) {
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        Py_XDECREF(fields[i].converter);
+    }
+    PyMem_Free(fields);
+}
+
+static int
+Layout_init(LayoutObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"model", "size", "fields", "sign", NULL};
+    PyObject *model, *fields_obj, *seq, *sign = Py_None;
+    Py_ssize_t size, n, i;
+    Py_ssize_t sign_offset = -1, sign_width = 0;
+    const char *negatives = "";
+    Py_ssize_t negatives_len = 0;
+    FieldSpec *fields;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OnO|O:Layout", kwlist,
+                                     &model, &size, &fields_obj, &sign)) {
+        return -1;
+    }
+    if (sign != Py_None) {
+        if (!PyArg_ParseTuple(sign, "nny#", &sign_offset, &sign_width, &negatives, &negatives_len)) {
+            return -1;
+        }
+        if (sign_offset < 0 || sign_width <= 0 || sign_offset + sign_width > size
+                || negatives_len <= 0 || negatives_len >= 16
+                || (Py_ssize_t)strlen(negatives) != negatives_len) {
+            PyErr_SetString(PyExc_ValueError,
+                            "sign must be (offset, width, negatives) within the record");
+            return -1;
+        }
+    }
+    if (!PyCallable_Check(model)) {
+        PyErr_SetString(PyExc_TypeError, "model must be callable");
+        return -1;
+    }
+
+    seq = PySequence_Fast(fields_obj,
+                          "fields must be a sequence of (offset, width[, kind, converter, signed])");
+    if (seq == NULL) {
+        return -1;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    fields = PyMem_Calloc((size_t)(n ? n : 1), sizeof(FieldSpec));
+    if (fields == NULL) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        Py_ssize_t off, width;
+        int kind = FIELD_STR, is_signed = 0;
+        PyObject *converter = Py_None;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, i), "nn|iOp",
+                              &off, &width, &kind, &converter, &is_signed)) {
+            goto error;
+        }
+        if (off < 0 || width < 0 || off + width > size) {
+            PyErr_Format(PyExc_ValueError,
+                         "field %zd out of range: offset=%zd, width=%zd, size=%zd",
+                         i, off, width, size);
+            goto error;
+        }
+        if (kind != FIELD_STR && kind != FIELD_INT && kind != FIELD_CALL && kind != FIELD_TIME) {
+            PyErr_Format(PyExc_ValueError, "field %zd: unknown kind %d", i, kind);
+            goto error;
+        }
+        if (kind != FIELD_STR && !PyCallable_Check(converter)) {
+            PyErr_Format(PyExc_TypeError, "field %zd: converter must be callable", i);
+            goto error;
+        }
+        if (is_signed && kind == FIELD_STR) {
+            PyErr_Format(PyExc_ValueError, "field %zd: str field cannot be signed", i);
+            goto error;
+        }
+        fields[i].offset = off;
+        fields[i].width = width;
+        fields[i].kind = kind;
+        fields[i].is_signed = is_signed;
+        fields[i].converter = kind == FIELD_STR ? NULL : Py_NewRef(converter);
+    }
+    Py_DECREF(seq);
+
+    Py_XSETREF(self->model, Py_NewRef(model));
+    free_fields(self->fields, self->nfields);
+    self->fields = fields;
+    self->nfields = n;
+    self->size = size;
+    self->sign_offset = sign_offset;
+    self->sign_width = sign_width;
+    memcpy(self->negatives, negatives, (size_t)negatives_len);
+    self->negatives[negatives_len] = '\0';
+    return 0;
+
+error:
+    Py_DECREF(seq);
+    free_fields(fields, n);
+    return -1;
+}
+
+static void
+Layout_dealloc(LayoutObject *self)
+{
+    Py_XDECREF(self->model);
+    free_fields(self->fields, self->nfields);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+Layout_decode(LayoutObject *self, PyObject *args)
+{
+    Py_buffer view;
+    Py_ssize_t offset = 0;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*|n:decode", &view, &offset)) {
+        return NULL;
+    }
+    if (offset < 0 || view.len - offset < self->size) {
+        set_size_error(offset < 0 ? view.len : view.len - offset, self->size);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    result = decode_at(self, (const unsigned char *)view.buf + offset);
+    PyBuffer_Release(&view);
+    return result;
+}
+
+static PyObject *
+Layout_decode_array(LayoutObject *self, PyObject *args)
+{
+    Py_buffer view;
+    Py_ssize_t count, i;
+    PyObject *list;
+
+    if (!PyArg_ParseTuple(args, "y*n:decode_array", &view, &count)) {
+        return NULL;
+    }
+    if (count < 0 || (self->size && count > view.len / self->size)) {
+        set_size_error(view.len, count * self->size);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    list = PyList_New(count);
+    if (list == NULL) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        PyObject *item = decode_at(self, (const unsigned char *)view.buf + i * self->size);
+        if (item == NULL) {
+            Py_DECREF(list);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    PyBuffer_Release(&view);
+    return list;
+}
+
+static PyObject *
+Layout_decode_columns(LayoutObject *self, PyObject *args)
+{
+    Py_buffer view;
+    Py_ssize_t count, i, j;
+    PyObject *columns;
+
+    if (!PyArg_ParseTuple(args, "y*n:decode_columns", &view, &count)) {
+        return NULL;
+    }
+    if (count < 0 || (self->size && count > view.len / self->size)) {
+        set_size_error(view.len, count * self->size);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    columns = PyList_New(self->nfields);
+    if (columns == NULL) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    for (j = 0; j < self->nfields; j++) {
+        PyObject *column = PyList_New(count);
+        if (column == NULL) {
+            goto error;
+        }
+        PyList_SET_ITEM(columns, j, column);
+    }
+
+    /* 레코드 순서대로 한 번만 훑으면서 필드별 컬럼에 채움 */
+    for (i = 0; i < count; i++) {
+        const unsigned char *rec = (const unsigned char *)view.buf + i * self->size;
+        int negative = record_is_negative(self, rec);
+        for (j = 0; j < self->nfields; j++) {
+            PyObject *value = decode_value(&self->fields[j], rec, negative);
+            if (value == NULL) {
+                goto error;
+            }
+            PyList_SET_ITEM(PyList_GET_ITEM(columns, j), i, value);
+        }
+    }
+    PyBuffer_Release(&view);
+    return columns;
+
+error:
+    Py_DECREF(columns);
+    PyBuffer_Release(&view);
+    return NULL;
+}
+
+/* 뷰(BlockView)용: 레코드 1건의 필드 1개만 디코딩 */
+static PyObject *
+Layout_field(LayoutObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    Py_buffer view;
+    Py_ssize_t base, index;
+    const FieldSpec *field;
+    const unsigned char *rec;
+    PyObject *result;
+
+    if (nargs != 3) {
+        PyErr_SetString(PyExc_TypeError, "field(buf, base, index) takes exactly 3 arguments");
+        return NULL;
+    }
+    base = PyLong_AsSsize_t(args[1]);
+    if (base == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    index = PyLong_AsSsize_t(args[2]);
+    if (index == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (index < 0 || index >= self->nfields) {
+        PyErr_SetString(PyExc_IndexError, "field index out of range");
+        return NULL;
+    }
+    if (PyObject_GetBuffer(args[0], &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    if (base < 0 || view.len - base < self->size) {
+        set_size_error(base < 0 ? view.len : view.len - base, self->size);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    rec = (const unsigned char *)view.buf + base;
+    field = &self->fields[index];
+    result = decode_value(field, rec, field->is_signed ? record_is_negative(self, rec) : 0);
+    PyBuffer_Release(&view);
+    return result;
+}
+
+static PyObject *
+Layout_get_size(LayoutObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSsize_t(self->size);
+}
+
+static PyMethodDef Layout_methods[] = {
+    {"decode", (PyCFunction)Layout_decode, METH_VARARGS,
+     "decode(buf, offset=0) -> model\n\nbuf[offset:offset+size] 레코드 1건을 디코딩"},
+    {"decode_array", (PyCFunction)Layout_decode_array, METH_VARARGS,
+     "decode_array(buf, count) -> list\n\n연속된 레코드 count건을 디코딩"},
+    {"field", (PyCFunction)(void (*)(void))Layout_field, METH_FASTCALL,
+     "field(buf, base, index) -> value\n\nbuf[base:base+size] 레코드의 index번째 필드만 디코딩"},
+    {"decode_columns", (PyCFunction)Layout_decode_columns, METH_VARARGS,
+     "decode_columns(buf, count) -> list[list]\n\n연속된 레코드 count건을 필드별 컬럼으로 디코딩"},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyGetSetDef Layout_getset[] = {
+    {"size", (getter)Layout_get_size, NULL, "레코드 크기", NULL},
+    {NULL, NULL, NULL, NULL, NULL},
+};
+
+static PyTypeObject LayoutType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "pynamuh.structures._fastdecode.Layout",
+    .tp_basicsize = sizeof(LayoutObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Layout(model, size, fields, sign=None)\n\n"
+              "fields: (offset, width[, kind, converter, signed]) 시퀀스. "
+              "model(*decoded_fields)로 결과 생성\n"
+              "sign: (offset, width, negatives) 부호 필드. 음수 부호면 signed 필드의 부호를 뒤집음",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Layout_init,
+    .tp_dealloc = (destructor)Layout_dealloc,
+    .tp_methods = Layout_methods,
+    .tp_getset = Layout_getset,
+};
+
+/* ------------------------------------------------------------------------ */
+/* 모듈                                                                      */
+/* ------------------------------------------------------------------------ */
+
+static PyObject *
+fastdecode_decode_field(PyObject *Py_UNUSED(module), PyObject *args)
+{
+    Py_buffer view;
+    PyObject *result;
+
+    if (!PyArg_ParseTuple(args, "y*:decode_field", &view)) {
+        return NULL;
+    }
+    result = decode_field((const unsigned char *)view.buf, view.len);
+    PyBuffer_Release(&view);
+    return result;
+}
+
+static PyMethodDef fastdecode_methods[] = {
+    {"decode_field", fastdecode_decode_field, METH_VARARGS,
+     "decode_field(buf) -> str\n\nNUL 절단 → ASCII/cp949 디코딩 → strip"},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef fastdecode_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_fastdecode",
+    .m_doc = "고정폭 레코드 디코더 (선택적 C 확장 모듈)",
+    .m_size = -1,
+    .m_methods = fastdecode_methods,
+};
+
+PyMODINIT_FUNC
+PyInit__fastdecode(void)
+{
+    PyObject *module;
+
+    PyDateTime_IMPORT;
+    if (PyDateTimeAPI == NULL) {
+        return NULL;
+    }
+    if (PyType_Ready(&LayoutType) < 0) {
+        return NULL;
+    }
+    module = PyModule_Create(&fastdecode_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&LayoutType);
+    if (PyModule_AddObject(module, "Layout", (PyObject *)&LayoutType) < 0) {
+        Py_DECREF(&LayoutType);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
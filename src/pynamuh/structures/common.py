@@ -7,15 +7,24 @@ C Structures paired with their corresponding Pydantic Models for better readabil
 """
 from abc import ABC
 import ctypes
+import logging
 from ctypes import Structure, POINTER
-from typing import ClassVar, Optional, List, Type, Union, Tuple
-from dataclasses import dataclass
+from typing import ClassVar, Optional, List, Type, Union, Tuple, Literal
+from dataclasses import dataclass, fields
 
 from pydantic import BaseModel, ConfigDict
 
-from .parser_info import get_parser_info
+from .parser_info import BlockInfo, lookup_block
+from .decoder import BlockDecoder, BlockView, get_decoder, Columns
 from ..wmca_logger import logger
 
+# szData 파싱 방식
+#   - "eager": 콜백 안에서 즉시 파싱 (기본값)
+#   - "lazy": 콜백에서는 원시 bytes만 복사, 소비자가 szData에 처음 접근할 때 파싱
+#   - "view": 콜백에서는 원시 bytes만 복사하고 BlockView로 감싸 전달, 필드는 처음 읽을 때 디코딩
+#   - "raw": 파싱하지 않고 원시 bytes 그대로 전달 (레코더용)
+DecodeMode = Literal["eager", "lazy", "view", "raw"]
+
 # ============================================================================
 # 1. AccountInfo
 # ============================================================================
@@ -101,10 +110,10 @@ class LoginInfo:
         szAccountCount = c_struct.szAccountCount.decode('cp949', errors='ignore').strip()
         account_count = int(szAccountCount) if szAccountCount and szAccountCount.isdigit() else 0
 
-        logger.debug(f"접속시간: {c_struct.szDate.decode('cp949', errors='ignore').strip()}")
-        logger.debug(f"서버명: {c_struct.szServerName.decode('cp949', errors='ignore').strip()}")
-        logger.debug(f"사용자ID: {c_struct.szUserID.decode('cp949', errors='ignore').strip()}")
-        logger.debug(f"계좌수: {account_count}")
+        logger.debug("접속시간: %s", c_struct.szDate.decode('cp949', errors='ignore').strip())
+        logger.debug("서버명: %s", c_struct.szServerName.decode('cp949', errors='ignore').strip())
+        logger.debug("사용자ID: %s", c_struct.szUserID.decode('cp949', errors='ignore').strip())
+        logger.debug("계좌수: %s", account_count)
 
         # 계좌 목록 파싱
         accountlist = []
@@ -112,7 +121,7 @@ class LoginInfo:
             acc = AccountInfo.from_c_struct(c_struct.accountlist[i])
             if acc.szAccountNo:  # 계좌번호가 있는 경우만
                 accountlist.append(acc)
-                logger.debug(f"계좌[{i+1}]: {acc.szAccountNo} - {acc.szAccountName}")
+                logger.debug("계좌[%s]: %s - %s", i + 1, acc.szAccountNo, acc.szAccountName)
 
         return cls(
             szDate=c_struct.szDate.decode('cp949', errors='ignore').strip(),
@@ -167,7 +176,7 @@ class LoginBlock:
         try:
             c_block = ctypes.cast(lparam, POINTER(CLoginBlock)).contents
             TrIndex = c_block.TrIndex
-            logger.debug(f"LoginBlock.TrIndex = {TrIndex}")
+            logger.debug("LoginBlock.TrIndex = %s", TrIndex)
 
             if not c_block.pLoginInfo:
                 logger.error("pLoginInfo가 NULL")
@@ -188,7 +197,7 @@ class LoginBlock:
 # szData 공통 클래스
 # ============================================================================
 
-@dataclass
+@dataclass(slots=True)
 class OutBlock:
     """
     OutBlock 기본 클래스 (Python dataclass)
@@ -197,13 +206,46 @@ class OutBlock:
     - Python dataclass: 단순하고 빠른 데이터 컨테이너
     - C_STRUCT: 각 서브클래스에서 Structure 타입 지정 (ClassVar)
     - from_c_struct(): Structure → Python 객체 변환 (공통 구현)
+
+    필드 타입:
+    - 어노테이션으로 선언 (str, int, Decimal, datetime.time). 디코딩할 때 변환되며 빈 필드와 형식이 맞지 않는 필드는 None
+    - SIGN_FIELD: 등락부호 필드명. 값이 NEGATIVE_SIGNS 중 하나면 SIGNED_FIELDS를 음수로 만듦 (-abs)
+      (예: j8 sign '4'(하한), '5'(하락) → change, chrate가 음수)
+    - typed=False로 파싱하면 모든 필드가 str (이전 동작)
+
+    서브클래스도 @dataclass(slots=True)로 선언합니다. (인스턴스별 __dict__가 없어
+    틱 히스토리처럼 대량으로 보관하는 객체의 메모리가 줄어듦. slots=False여도 동작은 동일)
     """
+    SIGN_FIELD: ClassVar[Optional[str]] = None
+    SIGNED_FIELDS: ClassVar[Tuple[str, ...]] = ()
+    NEGATIVE_SIGNS: ClassVar[Tuple[str, ...]] = ("4", "5")
 
     @classmethod
-    def from_c_struct(cls, c_struct: Structure) -> 'OutBlock':
+    def from_c_struct(cls, c_struct: Structure, typed: bool = True) -> 'OutBlock':
         """
         C 구조체 → Python 객체 변환
 
+        (C 구조체, OutBlock) 쌍마다 한 번 생성된 BlockDecoder로 변환합니다.
+        typed=False면 결과는 _from_c_struct_reflect()와 동일합니다.
+
+        Args:
+            typed: False면 필드 타입 변환 없이 모든 필드를 str로 반환
+
+        Returns:
+            OutBlock: 파싱된 데이터 객체
+
+        Example:
+            >>> c_struct = Tc8201OutBlockCStruct(...)
+            >>> outblock = Tc8201OutBlock.from_c_struct(c_struct)
+            >>> print(outblock.dpsit_amtz16)  # 1000000
+        """
+        return get_decoder(type(c_struct), cls, typed).decode(bytes(c_struct))
+
+    @classmethod
+    def _from_c_struct_reflect(cls, c_struct: Structure) -> 'OutBlock':
+        """
+        C 구조체 → Python 객체 변환 (리플렉션 경로)
+
         공통 변환 로직:
         1. dataclass 필드 목록 조회 (__dataclass_fields__)
         2. 각 필드에 대응하는 C 구조체 필드 읽기 (필드명 동일)
@@ -221,9 +263,9 @@ class OutBlock:
         logger.debug("OutBlock 파싱 시작. cls=%s", cls.__name__)
         parsed_data = {}
 
-        # dataclass 필드 순회 (속성 바이트 필드는 자동으로 제외됨)
+        # dataclass 필드 순회 (속성 바이트 필드와 ClassVar는 자동으로 제외됨)
         if hasattr(cls, '__dataclass_fields__'):
-            field_names = cls.__dataclass_fields__.keys()
+            field_names = [f.name for f in fields(cls)]
         else:
             # dataclass가 아닌 경우 (하위 호환성)
             raise TypeError(f"{cls.__name__}은 @dataclass로 정의되어야 합니다")
@@ -232,7 +274,7 @@ class OutBlock:
             try:
                 c_value = getattr(c_struct, field_name)
             except AttributeError:
-                logger.warning(f"C 구조체에 필드 없음: {field_name}")
+                logger.warning("C 구조체에 필드 없음: %s", field_name)
                 continue
 
             # bytes → str 변환 (cp949 디코딩, 공백 제거)
@@ -263,13 +305,17 @@ class CMsgHeader(Structure):
         ("user_msg", ctypes.c_char * 80),   # 사용자 메시지
     ]
 
-@dataclass
+@dataclass(slots=True)
 class MsgHeader(OutBlock):
     """메시지 헤더 DTO"""
     msg_cd: str          # 메시지 코드 (00000: 정상, 기타: 오류)
     user_msg: str        # 사용자 메시지
 
 
+# CA_RECEIVEMESSAGE는 블록명과 무관하게 MsgHeader로 파싱 (레지스트리에 등록하지 않음)
+_MSG_HEADER_BLOCK = BlockInfo("MSGHEADER", CMsgHeader, MsgHeader)
+
+
 # ============================================================================
 # 5. Received
 # ============================================================================
@@ -285,14 +331,16 @@ class CReceived(Structure):
         ("nLen", ctypes.c_int),             # 데이터 길이
     ]
 
-@dataclass
+@dataclass(slots=True)
 class Received:
     """TR 수신 데이터 DTO
 
-    szData의 3가지 상태:
+    szData의 5가지 상태:
         1. 파싱 전: bytes (원시 바이너리)
         2. 단일 레코드 파싱 후: OutBlock (예: Tc8201OutBlock)
         3. 반복 레코드 파싱 후: List[OutBlock] (예: List[Tc8201OutBlock1])
+        4. 반복 레코드 컬럼 파싱 후 (columnar=True): Columns (필드별 리스트)
+        5. 뷰 파싱 후 (view=True): BlockView 또는 List[BlockView] (필드 첫 접근 시 디코딩)
 
     Example:
         >>> # from_c_struct()가 자동으로 파싱
@@ -309,9 +357,9 @@ class Received:
         ...     for stock in stocks:
         ...         print(f"{stock.issue_namez40}: {stock.jan_qtyz16}주")
     """
-    szBlockName: str                                    # 블록 이름
-    szData: Union[OutBlock, List[OutBlock], bytes]     # 파싱된 데이터 또는 bytes
-    nLen: int                                           # 데이터 길이
+    szBlockName: str                                            # 블록 이름
+    szData: Union[OutBlock, List[OutBlock], Columns, BlockView, List[BlockView], bytes]  # 파싱된 데이터 또는 bytes
+    nLen: int                                                   # 데이터 길이
 
     @classmethod
     def from_c_struct(
@@ -319,13 +367,21 @@ class Received:
         c_struct: CReceived,
         is_receivemessage: bool = False,
         is_receivesise: bool = False,
-        auto_parse: bool = True
-    ) -> 'Received':
+        auto_parse: bool = True,
+        lazy: bool = False,
+        columnar: bool = False,
+        typed: bool = True,
+        view: bool = False
+    ) -> Union['Received', 'LazyReceived']:
         """C 구조체로부터 Received 생성
 
         Args:
             c_struct: CReceived C 구조체
             auto_parse: True면 szBlockName에 따라 자동 파싱
+            lazy: True면 원시 bytes만 복사한 LazyReceived 반환 (szData 첫 접근 시 파싱)
+            columnar: True면 반복 블록을 List[OutBlock] 대신 Columns(필드별 리스트)로 파싱
+            typed: False면 필드 타입 변환 없이 모든 필드를 str로 파싱
+            view: True면 OutBlock 대신 원시 bytes 위의 BlockView 반환 (필드 첫 접근 시 디코딩)
 
         Returns:
             Received[T]: 파싱된 데이터 또는 bytes
@@ -338,19 +394,40 @@ class Received:
             >>> # 파싱 안 함 (bytes 그대로)
             >>> received = Received.from_c_struct(c_struct, auto_parse=False)
             >>> # szData는 bytes
+            >>>
+            >>> # 지연 파싱 (bytes만 복사, szData 첫 접근 시 파싱)
+            >>> received = Received.from_c_struct(c_struct, lazy=True)
         """
         if is_receivesise:
             # ca_receivesise는 szBlockName 파싱 시 특수 케이스 -> szBlockName이 가리키는 char 배열에 '\0'이 없어 앞 글자 2개만 추출해야 함.
             szBlockName = ctypes.string_at(c_struct.szBlockName, 2)\
                 .decode('cp949', errors='ignore').strip() if c_struct.szBlockName else ""
-            szData_bytes = ctypes.string_at(c_struct.szData[3:c_struct.nLen]) if c_struct.szData else b""
+            # szData 앞 3바이트(실시간 코드 + 구분자)를 건너뛰고 한 번만 복사
+            if c_struct.szData and c_struct.nLen > 3:
+                data_addr = ctypes.cast(c_struct.szData, ctypes.c_void_p).value
+                szData_bytes = ctypes.string_at(data_addr + 3, c_struct.nLen - 3)
+            else:
+                szData_bytes = b""
+        elif is_receivemessage and lazy:
+            # MsgHeader는 nLen과 무관하게 구조체 크기만큼 읽어야 함 (즉시 파싱 경로와 동일)
+            szBlockName = ctypes.string_at(c_struct.szBlockName)\
+                .decode('cp949', errors='ignore').strip() if c_struct.szBlockName else ""
+            szData_bytes = ctypes.string_at(c_struct.szData, ctypes.sizeof(CMsgHeader)) if c_struct.szData else b""
         else:
             szBlockName = ctypes.string_at(c_struct.szBlockName)\
                 .decode('cp949', errors='ignore').strip() if c_struct.szBlockName else ""
             szData_bytes = ctypes.string_at(c_struct.szData, c_struct.nLen) if c_struct.szData else b""
         
         nLen = c_struct.nLen
-        logger.debug("Received.from_c_struct(szBlockName=%s, szData_bytes=%s, nLen=%d, auto_parse=%s)", szBlockName, szData_bytes, nLen, auto_parse)
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "Received.from_c_struct(szBlockName=%s, szData_bytes=%r, nLen=%d, auto_parse=%s)",
+                szBlockName, szData_bytes, nLen, auto_parse
+            )
+        if lazy and auto_parse:
+            # 지연 파싱 (bytes만 보관, szData 첫 접근 시 파싱)
+            return LazyReceived(szBlockName, szData_bytes, nLen, is_receivemessage, columnar, typed)
+
         if not auto_parse:
             # 파싱 안 함 (bytes 그대로 반환)
             return cls(
@@ -362,7 +439,6 @@ class Received:
             # ca_receivemessage는 특수 케이스 -> szData를 MsgHeader로 파싱
             if is_receivemessage:
                 szData = MsgHeader.from_c_struct(ctypes.cast(c_struct.szData, POINTER(CMsgHeader)).contents)
-                logger.debug("Received 파싱 완료. type(szData)=%s", type(szData).__name__)
                 return cls(
                     szBlockName=szBlockName,
                     szData=szData,
@@ -370,51 +446,55 @@ class Received:
                 )
 
             # szBlockName에 따라 자동 파싱
-            return cls._auto_parse(szBlockName, szData_bytes, nLen, is_receivemessage)
+            return cls._auto_parse(szBlockName, szData_bytes, nLen, is_receivemessage, columnar, typed, view)
 
     @classmethod
-    def _auto_parse(cls, block_name: str, data_bytes: bytes, nLen: int, is_receivemessage: bool = False) -> 'Received':
+    def _auto_parse(
+        cls,
+        block_name: str,
+        data_bytes: bytes,
+        nLen: int,
+        is_receivemessage: bool = False,
+        columnar: bool = False,
+        typed: bool = True,
+        view: bool = False
+    ) -> 'Received':
         """블록 이름에 따라 자동 파싱
 
         Args:
             block_name: szBlockName (예: "c8201OutBlock")
             data_bytes: szData (bytes)
             nLen: 데이터 길이
+            columnar: True면 반복 블록을 Columns로 파싱 (view보다 우선)
+            typed: False면 모든 필드를 str로 파싱
+            view: True면 BlockView(반복 블록은 List[BlockView])로 감싸서 반환
 
         Returns:
             Received[T]: 파싱된 데이터를 담은 Received 인스턴스
         """
-        # 파서 정보 조회
-        if is_receivemessage:
-            parser_info = (CMsgHeader, MsgHeader, False)
-        else:
-            try:
-                parser_info = get_parser_info(block_name)
-            except ValueError:
-                logger.debug("파서 미등록: %s, bytes로 반환. nLen=%d, szData=%s", block_name, nLen, data_bytes)
-                parser_info = None
+        # 파서 정보 조회 (dict 조회, 미등록 블록도 예외 없음)
+        info = _MSG_HEADER_BLOCK if is_receivemessage else lookup_block(block_name)
 
-        if not parser_info:
-            # parser_info가 None인 경우 → bytes 그대로
+        if info is None:
+            # 미등록 블록 → bytes 그대로
+            if logger.isEnabledFor(logging.DEBUG):
+                logger.debug("파서 미등록: %s, bytes로 반환. nLen=%d", block_name, nLen)
             return cls(
                 szBlockName=block_name,
                 szData=data_bytes,
                 nLen=nLen
             )
 
-        struct_class, model_class, is_array = parser_info
-
-        if is_array:
+        if info.is_array:
             # 반복 레코드 파싱
             parsed_data = cls._parse_array_internal(
-                data_bytes, nLen, struct_class, model_class
+                data_bytes, nLen, info.decoder(typed), columnar, view
             )
         else:
             # 단일 레코드 파싱
-            parsed_data = cls._parse_single_internal(
-                data_bytes, struct_class, model_class
-            )
-        logger.debug("Received _auto_parse 완료. type(szData)=%s", type(parsed_data).__name__)
+            parsed_data = cls._parse_single_internal(data_bytes, info.decoder(typed), view)
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug("Received _auto_parse 완료. type(szData)=%s", type(parsed_data).__name__)
 
         return cls(
             szBlockName=block_name,
@@ -426,87 +506,139 @@ class Received:
     @staticmethod
     def _parse_single_internal(
         data_bytes: bytes,
-        struct_class: Type[Structure],
-        model_class: Type['OutBlock']
-    ) -> 'OutBlock':
+        decoder: BlockDecoder,
+        view: bool = False
+    ) -> Union['OutBlock', BlockView]:
         """단일 레코드 내부 파싱 로직
 
         Args:
             data_bytes: 원시 바이너리 데이터
-            struct_class: Structure 클래스
-            model_class: OutBlock 서브클래스
+            decoder: 블록 전용 디코더 (BlockInfo.decoder())
+            view: True면 BlockView 반환
 
         Returns:
-            OutBlock 인스턴스
+            OutBlock 인스턴스 (view=True면 BlockView)
         """
-        struct_size = ctypes.sizeof(struct_class)
+        struct_size = decoder.size
 
         if len(data_bytes) < struct_size:
             raise ValueError(
                 f"데이터 크기 부족: len={len(data_bytes)}, "
-                f"required={struct_size} (struct={struct_class.__name__})"
+                f"required={struct_size} (struct={decoder.struct_class.__name__})"
             )
 
-        # bytes → Structure
-        c_struct = struct_class.from_buffer_copy(data_bytes[:struct_size])
+        if view:
+            return decoder.view(data_bytes)
 
-        # Structure → OutBlock (OutBlock.from_c_struct 공통 메서드 사용)
-        parsed_model = model_class.from_c_struct(c_struct)
-
-        return parsed_model
+        # bytes → OutBlock (블록 전용 디코더 사용)
+        return decoder.decode(data_bytes)
 
     @staticmethod
     def _parse_array_internal(
         data_bytes: bytes,
         nLen: int,
-        struct_class: Type[Structure],
-        model_class: Type['OutBlock']
-    ) -> List['OutBlock']:
+        decoder: BlockDecoder,
+        columnar: bool = False,
+        view: bool = False
+    ) -> Union[List['OutBlock'], Columns, List[BlockView]]:
         """반복 레코드 내부 파싱 로직
 
         Args:
             data_bytes: 원시 바이너리 데이터
             nLen: 데이터 길이
-            struct_class: Structure 클래스
-            model_class: OutBlock 서브클래스
+            decoder: 블록 전용 디코더 (BlockInfo.decoder())
+            columnar: True면 필드별 컬럼(Columns)으로 파싱
+            view: True면 레코드별 BlockView 리스트 반환 (columnar가 우선)
 
         Returns:
-            List[OutBlock]: 파싱된 모델 리스트
+            List[OutBlock]: 파싱된 모델 리스트 (columnar=True면 Columns, view=True면 List[BlockView])
         """
-        struct_size = ctypes.sizeof(struct_class)
+        struct_size = decoder.size
 
         if struct_size == 0:
-            raise ValueError(f"구조체 크기가 0: {struct_class.__name__}")
+            raise ValueError(f"구조체 크기가 0: {decoder.struct_class.__name__}")
 
         # 반복 횟수 계산 (C++ 예제와 동일)
         occurs_count = nLen // struct_size
 
-        logger.debug(
-            f"parse_array_internal: struct={struct_class.__name__}, "
-            f"struct_size={struct_size}, nLen={nLen}, "
-            f"occurs_count={occurs_count}"
-        )
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "parse_array_internal: struct=%s, struct_size=%d, nLen=%d, occurs_count=%d",
+                decoder.struct_class.__name__, struct_size, nLen, occurs_count
+            )
 
         if occurs_count == 0:
-            logger.warning(f"반복 레코드 없음 (nLen={nLen} < struct_size={struct_size})")
-            return []
+            logger.warning("반복 레코드 없음 (nLen=%d < struct_size=%d)", nLen, struct_size)
+            return decoder.decode_columns(b"", 0) if columnar else []
+
+        # 배열 파싱 (블록 전용 디코더 사용)
+        if columnar:
+            return decoder.decode_columns(data_bytes, occurs_count)
+        if view:
+            return decoder.view_array(data_bytes, occurs_count)
+        return decoder.decode_array(data_bytes, occurs_count)
+
+
+class LazyReceived:
+    """지연 파싱 Received
+
+    윈도우 프로시저 안에서는 szBlockName과 원시 szData bytes만 복사하고,
+    소비자가 szData에 처음 접근할 때 Received._auto_parse()로 파싱한 뒤 결과를 캐시합니다.
+    소비자가 걸러내는 이벤트는 파싱 비용이 전혀 들지 않습니다.
 
-        # 배열 파싱
-        parsed_list = []
-        offset = 0
+    Attributes:
+        szBlockName: 블록 이름
+        nLen: 데이터 길이
+        raw: 원시 szData bytes
+        szData: 파싱된 데이터 (첫 접근 시 파싱)
+    """
+    __slots__ = ("szBlockName", "nLen", "raw", "_is_receivemessage", "_columnar", "_typed", "_parsed")
 
-        for i in range(occurs_count):
-            # bytes 슬라이스 → Structure
-            record_bytes = data_bytes[offset:offset + struct_size]
-            c_struct = struct_class.from_buffer_copy(record_bytes)
+    _UNPARSED = object()
 
-            # Structure → OutBlock (OutBlock.from_c_struct 공통 메서드 사용)
-            parsed_model = model_class.from_c_struct(c_struct)
-            parsed_list.append(parsed_model)
+    def __init__(
+        self,
+        szBlockName: str,
+        raw: bytes,
+        nLen: int,
+        is_receivemessage: bool = False,
+        columnar: bool = False,
+        typed: bool = True
+    ):
+        self.szBlockName = szBlockName
+        self.raw = raw
+        self.nLen = nLen
+        self._is_receivemessage = is_receivemessage
+        self._columnar = columnar
+        self._typed = typed
+        self._parsed = LazyReceived._UNPARSED
+
+    @property
+    def is_parsed(self) -> bool:
+        """szData 파싱 여부"""
+        return self._parsed is not LazyReceived._UNPARSED
+
+    @property
+    def szData(self) -> Union[OutBlock, List[OutBlock], Columns, bytes]:
+        """파싱된 데이터 (첫 접근 시 파싱 후 캐시)"""
+        parsed = self._parsed
+        if parsed is LazyReceived._UNPARSED:
+            parsed = self._parsed = self.parse().szData
+        return parsed
+
+    def parse(self) -> Received:
+        """즉시 파싱 경로와 동일한 Received로 변환"""
+        if self.is_parsed:
+            return Received(szBlockName=self.szBlockName, szData=self._parsed, nLen=self.nLen)
+        return Received._auto_parse(
+            self.szBlockName, self.raw, self.nLen, self._is_receivemessage, self._columnar,
+            self._typed
+        )
 
-            offset += struct_size
+    def __repr__(self) -> str:
+        state = "parsed" if self.is_parsed else "unparsed"
+        return f"LazyReceived(szBlockName={self.szBlockName!r}, nLen={self.nLen}, {state})"
 
-        return parsed_list
 
 # ============================================================================
 # 6. OutDataBlock
@@ -523,44 +655,144 @@ class COutDataBlock(Structure):
     ]
 
 
-@dataclass
+@dataclass(slots=True)
 class OutDataBlock:
     """TR 출력 데이터 블록 DTO"""
-    TrIndex: int                        # 트랜잭션 인덱스
-    pData: Optional[Received]           # 수신 데이터 (NULL일 수 있음)
+    TrIndex: int                                        # 트랜잭션 인덱스
+    pData: Optional[Union[Received, LazyReceived]]      # 수신 데이터 (NULL일 수 있음)
 
     @classmethod
-    def from_lparam(cls, lparam: int, is_receivemessage: bool = False, is_receivesise: bool = False) -> 'OutDataBlock':
+    def from_lparam(
+        cls,
+        lparam: int,
+        is_receivemessage: bool = False,
+        is_receivesise: bool = False,
+        decode: DecodeMode = "eager",
+        columnar: bool = False,
+        typed: bool = True
+    ) -> 'OutDataBlock':
         """lparam으로부터 파싱
 
         Args:
             lparam: OUTDATABLOCK 구조체 포인터
             ca_receivemessage: CA_RECEIVEMESSAGE 메시지 여부
+            decode: szData 파싱 방식 ("eager", "lazy", "view", "raw")
+            columnar: True면 반복 블록을 Columns로 파싱
+            typed: False면 모든 필드를 str로 파싱
 
         Returns:
             OutDataBlock DTO
         """
-        logger.debug("OutDataBlock 파싱 시작. lparam=%s, is_receivemessage=%s", lparam, is_receivemessage)
-
         if not lparam:
             logger.error("lparam이 NULL")
             raise ValueError("lparam이 NULL입니다")
 
         c_block = ctypes.cast(lparam, POINTER(COutDataBlock)).contents
         TrIndex = c_block.TrIndex
-        logger.debug(f"OutDataBlock.TrIndex = {TrIndex}")
         pData = None
 
         if c_block.pData:
-            pData = Received.from_c_struct(c_block.pData.contents, is_receivemessage, is_receivesise)
-            logger.debug("OutDataBlock 파싱 완료. lparam=%s, TrIndex=%d", lparam, TrIndex)
-        
+            pData = Received.from_c_struct(
+                c_block.pData.contents,
+                is_receivemessage,
+                is_receivesise,
+                auto_parse=(decode != "raw"),
+                lazy=(decode == "lazy"),
+                columnar=columnar,
+                typed=typed,
+                view=(decode == "view"),
+            )
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "OutDataBlock 파싱 완료. lparam=%s, TrIndex=%d, is_receivemessage=%s",
+                lparam, TrIndex, is_receivemessage
+            )
+
         return cls(
             TrIndex=TrIndex,
             pData=pData
         )
 
 
+def raw_from_lparam(lparam: int, is_receivesise: bool = False) -> Tuple[int, bytes, bytes]:
+    """OUTDATABLOCK에서 디코딩 없이 (TrIndex, 블록명 bytes, szData bytes) 복사 (저널 기록용)
+
+    실시간 시세의 블록명은 앞 2바이트만, szData는 nLen 바이트 전체(실시간 코드 + 구분자 포함)를 복사합니다.
+    pData가 NULL이면 블록명과 szData는 b"".
+    """
+    c_block = ctypes.cast(lparam, POINTER(COutDataBlock)).contents
+    if not c_block.pData:
+        return c_block.TrIndex, b"", b""
+    c_struct = c_block.pData.contents
+    if not c_struct.szBlockName:
+        name = b""
+    elif is_receivesise:
+        name = ctypes.string_at(c_struct.szBlockName, 2)
+    else:
+        name = ctypes.string_at(c_struct.szBlockName)
+    data = ctypes.string_at(c_struct.szData, c_struct.nLen) if c_struct.szData and c_struct.nLen > 0 else b""
+    return c_block.TrIndex, name, data
+
+
+@dataclass(slots=True)
+class FlatOutDataBlock:
+    """TR 출력 데이터 블록 DTO (평탄화)
+
+    OutDataBlock + Received 두 겹의 봉투를 객체 하나로 합친 형태입니다.
+    실시간 시세처럼 이벤트가 많을 때 이벤트당 객체 수와 메모리를 줄입니다.
+    (WMCAAgent(envelope=False)에서 사용, pData가 NULL이면 szBlockName="", szData=None)
+    """
+    TrIndex: int                                                            # 트랜잭션 인덱스
+    szBlockName: str                                                        # 블록 이름
+    szData: Union[OutBlock, List[OutBlock], Columns, BlockView, List[BlockView], bytes, None]  # 파싱된 데이터
+    nLen: int                                                               # 데이터 길이
+
+    @classmethod
+    def from_lparam(
+        cls,
+        lparam: int,
+        is_receivemessage: bool = False,
+        is_receivesise: bool = False,
+        decode: DecodeMode = "eager",
+        columnar: bool = False,
+        typed: bool = True
+    ) -> 'FlatOutDataBlock':
+        """lparam으로부터 파싱 (decode="lazy"는 지원하지 않음)
+
+        Args:
+            lparam: OUTDATABLOCK 구조체 포인터
+            decode: szData 파싱 방식 ("eager", "view", "raw")
+            columnar: True면 반복 블록을 Columns로 파싱
+            typed: False면 모든 필드를 str로 파싱
+
+        Returns:
+            FlatOutDataBlock DTO
+        """
+        if decode == "lazy":
+            raise ValueError("FlatOutDataBlock은 decode='lazy'를 지원하지 않습니다")
+        if not lparam:
+            logger.error("lparam이 NULL")
+            raise ValueError("lparam이 NULL입니다")
+
+        c_block = ctypes.cast(lparam, POINTER(COutDataBlock)).contents
+        if not c_block.pData:
+            return cls(TrIndex=c_block.TrIndex, szBlockName="", szData=None, nLen=0)
+
+        received = Received.from_c_struct(
+            c_block.pData.contents,
+            is_receivemessage,
+            is_receivesise,
+            auto_parse=(decode != "raw"),
+            columnar=columnar,
+            typed=typed,
+            view=(decode == "view"),
+        )
+        return cls(
+            TrIndex=c_block.TrIndex,
+            szBlockName=received.szBlockName,
+            szData=received.szData,
+            nLen=received.nLen
+        )
 
 
 # ============================================================================
@@ -0,0 +1,730 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+블록별 고정폭 레코드 디코더
+
+C 구조체(_fields_)와 OutBlock dataclass의 필드 오프셋/폭을 한 번만 계산하고,
+블록 전용 디코드 함수를 생성(compile)해 두어 호출마다 리플렉션을 하지 않습니다.
+
+C 확장 모듈(_fastdecode)이 빌드되어 있으면 같은 레이아웃 테이블로 C 디코더를 사용하고,
+없으면 순수 Python 디코더를 사용합니다. (환경변수 PYNAMUH_NO_NATIVE=1로 비활성화 가능)
+
+필드 타입은 OutBlock dataclass의 어노테이션으로 선언합니다. (str, int, Decimal, datetime.time)
+typed 디코더는 디코딩과 같은 단계에서 숫자/시각으로 변환하고, 빈 필드와 형식이 맞지 않는 필드는 None이 됩니다.
+부호 필드(SIGN_FIELD)가 음수 부호인 레코드의 SIGNED_FIELDS는 값 자체의 부호와 관계없이 음수가 됩니다.
+"""
+import ctypes
+import os
+from ctypes import Structure
+from dataclasses import fields as dataclass_fields, is_dataclass, MISSING
+from datetime import time as dtime
+from decimal import Decimal, InvalidOperation
+from typing import (
+    Any, Callable, Dict, FrozenSet, Iterator, List, Optional, Tuple, Type, TYPE_CHECKING,
+    Union, get_args, get_origin, get_type_hints,
+)
+
+from ..wmca_logger import logger
+
+if TYPE_CHECKING:
+    from .common import OutBlock
+
+try:
+    if os.environ.get("PYNAMUH_NO_NATIVE"):
+        raise ImportError("PYNAMUH_NO_NATIVE 설정됨")
+    from . import _fastdecode
+except ImportError:
+    _fastdecode = None
+
+
+# (필드명, 오프셋, 폭)
+FieldLayout = Tuple[str, int, int]
+
+
+def _decode_field(rec: bytes, offset: int, width: int) -> str:
+    """단일 필드 디코딩 (정확 경로)
+
+    ctypes c_char 배열 getattr과 동일하게 첫 NUL에서 잘라낸 뒤 cp949 디코딩, 공백 제거
+    """
+    raw = rec[offset:offset + width]
+    nul = raw.find(b"\0")
+    if nul >= 0:
+        raw = raw[:nul]
+    return raw.decode("cp949", errors="ignore").strip()
+
+
+def _recode_field(text: str) -> str:
+    """latin-1로 디코딩된 필드를 cp949로 다시 디코딩"""
+    return text.encode("latin-1").decode("cp949", errors="ignore").strip()
+
+
+# ============================================================================
+# 필드 타입 변환
+# ============================================================================
+#   - 입력은 공백이 남아 있을 수 있는 필드 문자열 (int()/Decimal()은 앞뒤 공백을 허용)
+#   - 빈 필드는 None
+#   - 형식이 맞지 않는 필드도 None (레코드 전체를 버리지 않도록 예외 대신 debug 로그)
+
+def _malformed(kind: str, text: str) -> None:
+    """변환할 수 없는 필드 (debug 로그 후 None)"""
+    logger.debug("%s 필드 변환 실패, None으로 처리: %r", kind, text)
+    return None
+
+
+def _to_int(text: str) -> Optional[int]:
+    """정수 필드 변환 ("  70000", "-1234", "+0000500", "1,234", "100.00")"""
+    try:
+        return int(text)
+    except ValueError:
+        pass
+    value = text.strip().replace(",", "")
+    if not value:
+        return None
+    try:
+        number = Decimal(value)
+    except InvalidOperation:
+        return _malformed("정수", text)
+    if not number.is_finite() or number != number.to_integral_value():
+        return _malformed("정수", text)
+    return int(number)
+
+
+def _to_decimal(text: str) -> Optional[Decimal]:
+    """고정소수점 필드 변환 ("  0.72", "-1.25", "123.45")"""
+    try:
+        return Decimal(text)
+    except InvalidOperation:
+        pass
+    value = text.strip().replace(",", "")
+    if not value:
+        return None
+    try:
+        number = Decimal(value)
+    except InvalidOperation:
+        return _malformed("소수", text)
+    if not number.is_finite():
+        return _malformed("소수", text)
+    return number
+
+
+def _to_time(text: str) -> Optional[dtime]:
+    """시각 필드 변환 ("HH:MM:SS", "HHMMSS", "HHMM", "HHMMSSss"(1/100초))"""
+    digits = text.strip().replace(":", "")
+    if not digits:
+        return None
+    if not (digits.isascii() and digits.isdigit()) or len(digits) not in (4, 6, 8):
+        return _malformed("시각", text)
+    try:
+        return dtime(
+            int(digits[0:2]),
+            int(digits[2:4]),
+            int(digits[4:6] or 0),
+            int(digits[6:8] or 0) * 10000,
+        )
+    except ValueError:
+        return _malformed("시각", text)
+
+
+def _apply_sign(value: Any, sign: str, negatives: FrozenSet[str]) -> Any:
+    """부호 필드가 음수 부호면 음수로 만듦 (값에 이미 '-'가 있어도 음수, 빈 값은 그대로)"""
+    if value is not None and sign.strip() in negatives:
+        return -abs(value)
+    return value
+
+
+# 어노테이션 타입 → 변환 함수 (str은 변환 없음)
+FIELD_CONVERTERS: Dict[type, Callable[[str], Any]] = {
+    int: _to_int,
+    Decimal: _to_decimal,
+    dtime: _to_time,
+}
+
+# C 확장 모듈 필드 종류 (0: str, 1: int, 3: time (C에서 직접 파싱), 2: 변환 함수 호출)
+_KIND_STR, _KIND_INT, _KIND_CALL, _KIND_TIME = 0, 1, 2, 3
+
+
+def _field_converter(model_class: type, name: str, annotation: Any) -> Optional[Callable[[str], Any]]:
+    """필드 어노테이션에 해당하는 변환 함수 (str이면 None)"""
+    if get_origin(annotation) is Union:
+        args = [arg for arg in get_args(annotation) if arg is not type(None)]
+        if len(args) == 1:
+            annotation = args[0]
+    if annotation is str:
+        return None
+    converter = FIELD_CONVERTERS.get(annotation)
+    if converter is None:
+        raise TypeError(
+            f"지원하지 않는 필드 타입: {model_class.__name__}.{name}: {annotation!r} "
+            f"(str, int, Decimal, datetime.time 중 하나)"
+        )
+    return converter
+
+
+def _char_field_width(ctype: Any) -> int:
+    """c_char 또는 c_char 배열이면 폭을, 아니면 0을 반환"""
+    if ctype is ctypes.c_char:
+        return 1
+    if issubclass(ctype, ctypes.Array) and ctype._type_ is ctypes.c_char:
+        return ctype._length_
+    return 0
+
+
+class Columns:
+    """반복 블록의 컬럼(struct-of-arrays) 결과
+
+    레코드마다 OutBlock 객체를 만들지 않고 필드별 리스트로 보관합니다.
+
+    Attributes:
+        model_class: 원래 레코드의 OutBlock 서브클래스
+        names: 필드명 튜플 (dataclass 필드 순서)
+        count: 레코드 수
+
+    Example:
+        >>> cols = received.szData          # columnar=True로 파싱된 c8201OutBlock1
+        >>> cols["issue_codez6"]            # ['005930', '000660', ...]
+        >>> arrays = cols.to_numpy()        # {'issue_codez6': ndarray, ...}
+        >>> batch = cols.to_arrow()         # pyarrow.RecordBatch
+    """
+
+    __slots__ = ("model_class", "names", "count", "_columns")
+
+    def __init__(self, model_class: Type["OutBlock"], names: Tuple[str, ...], columns: List[list], count: int):
+        self.model_class = model_class
+        self.names = names
+        self.count = count
+        self._columns = dict(zip(names, columns))
+
+    def __getitem__(self, name: str) -> list:
+        return self._columns[name]
+
+    def __len__(self) -> int:
+        return self.count
+
+    def __iter__(self) -> Iterator[str]:
+        return iter(self.names)
+
+    def __eq__(self, other: object) -> bool:
+        if not isinstance(other, Columns):
+            return NotImplemented
+        return self.model_class is other.model_class and self._columns == other._columns
+
+    def as_dict(self) -> Dict[str, list]:
+        """필드명 → 컬럼 리스트"""
+        return dict(self._columns)
+
+    def rows(self) -> List["OutBlock"]:
+        """레코드별 OutBlock 리스트로 변환 (행 기반 결과와 동일)"""
+        names = self.names
+        return [self.model_class(**dict(zip(names, values))) for values in zip(*self._columns.values())]
+
+    def to_numpy(self) -> Dict[str, Any]:
+        """필드명 → numpy 배열 (numpy 필요)"""
+        try:
+            import numpy as np
+        except ImportError as e:
+            raise ImportError("to_numpy()는 numpy가 설치되어 있어야 합니다") from e
+        return {name: np.asarray(column) for name, column in self._columns.items()}
+
+    def to_arrow(self) -> Any:
+        """pyarrow.RecordBatch로 변환 (pyarrow 필요)"""
+        try:
+            import pyarrow as pa
+        except ImportError as e:
+            raise ImportError("to_arrow()는 pyarrow가 설치되어 있어야 합니다") from e
+        return pa.RecordBatch.from_pydict(self._columns)
+
+    def __repr__(self) -> str:
+        return f"Columns(model={self.model_class.__name__}, count={self.count}, fields={len(self.names)})"
+
+
+class BlockView:
+    """블록 버퍼 위의 지연 필드 뷰 (블록별 서브클래스는 BlockDecoder.view_class)
+
+    원시 버퍼를 복사하지 않고 참조만 보관하며, 필드는 처음 접근할 때 디코딩한 뒤 캐시합니다.
+    필드 값은 같은 디코더의 decode() 결과와 동일합니다. (typed 변환/부호 적용 포함)
+    j8 틱에서 price, volume, time처럼 일부 필드만 읽는 경우 전체 디코딩 비용이 들지 않습니다.
+
+    Example:
+        >>> tick = received.szData          # decode="view"로 파싱된 j8 (Tj8OutBlockView)
+        >>> tick.price                      # 이 시점에 price만 디코딩
+        >>> block = tick.to_block()         # 전체 디코딩 (Tj8OutBlock)
+    """
+
+    __slots__ = ("_buf", "_base", "_cache")
+
+    # 블록별 서브클래스에서 지정
+    _decoder: "BlockDecoder"
+    _fields: Tuple[str, ...] = ()
+
+    _MISSING = object()
+
+    def __init__(self, buf: Any, base: int = 0):
+        """
+        Args:
+            buf: 원시 버퍼 (bytes, bytearray, memoryview). 복사하지 않고 참조
+            base: 레코드 시작 오프셋
+        """
+        self._buf = buf
+        self._base = base
+        self._cache = [BlockView._MISSING] * len(self._fields)
+
+    @property
+    def raw(self) -> bytes:
+        """레코드 원시 bytes (복사)"""
+        return bytes(self._buf[self._base:self._base + self._decoder.size])
+
+    def to_block(self) -> "OutBlock":
+        """전체 필드를 디코딩한 OutBlock"""
+        return self._decoder.decode(self.raw)
+
+    def __repr__(self) -> str:
+        values = ", ".join(f"{name}={getattr(self, name)!r}" for name in self._fields)
+        return f"{type(self).__name__}({values})"
+
+
+def _view_field(buf: Any, offset: int, width: int) -> str:
+    """뷰용 단일 필드 디코딩 (memoryview 포함)"""
+    return _decode_field(bytes(buf[offset:offset + width]), 0, width)
+
+
+class BlockDecoder:
+    """OutBlock 전용 디코더
+
+    (C 구조체, OutBlock dataclass, typed) 조합마다 한 번 생성됩니다.
+    모든 필드가 c_char 배열이면 다음 세 경로를 가진 디코드 함수를 생성합니다.
+
+    - 빠른 경로: 레코드가 ASCII이고 NUL이 없으면 레코드 전체를 한 번에 디코딩한 뒤
+      미리 계산한 오프셋으로 잘라서 strip
+    - cp949 경로: NUL은 없지만 한글 등 비ASCII가 있으면 레코드를 latin-1로 한 번에 디코딩한 뒤
+      비ASCII 필드만 cp949로 다시 디코딩
+    - 정확 경로: NUL이 있으면 필드별로 NUL 절단 → cp949 디코딩 → strip
+
+    typed=True면 dataclass 어노테이션(int, Decimal, datetime.time)에 따라 같은 식 안에서 값을 변환하고,
+    SIGN_FIELD 값이 NEGATIVE_SIGNS 중 하나인 레코드는 SIGNED_FIELDS의 부호를 뒤집습니다.
+    typed=False면 모든 필드를 str로 디코딩하며 OutBlock._from_c_struct_reflect()의 결과와 동일합니다.
+    C 확장 모듈이 있으면 같은 규칙을 C로 구현한 _fastdecode.Layout을 사용합니다.
+    c_char 이외의 필드가 있으면 from_buffer_copy + from_c_struct 경로로 동작합니다.
+
+    Attributes:
+        struct_class: C 구조체 클래스
+        model_class: OutBlock 서브클래스
+        size: 레코드 크기 (bytes)
+        layout: dataclass 필드 순서의 (필드명, 오프셋, 폭) 튜플
+        typed: 필드 타입 변환 여부
+        converters: layout 순서의 변환 함수 (str 필드 또는 typed=False면 None)
+        decode: (buf, offset=0) → OutBlock
+        decode_array: (buf, count) → List[OutBlock]
+        native: C 확장 모듈 사용 여부
+    """
+
+    __slots__ = (
+        "struct_class", "model_class", "size", "layout", "typed", "converters",
+        "decode", "decode_array", "native", "_table", "_sign", "_signed", "_view_class",
+        "_char_only",
+    )
+
+    def __init__(self, struct_class: Type[Structure], model_class: Type["OutBlock"], typed: bool = True):
+        if not is_dataclass(model_class):
+            raise TypeError(f"{model_class.__name__}은 @dataclass로 정의되어야 합니다")
+
+        self.struct_class = struct_class
+        self.model_class = model_class
+        self.size = ctypes.sizeof(struct_class)
+        self.typed = typed
+
+        ctypes_fields = dict(struct_class._fields_)
+        hints = get_type_hints(model_class) if typed else {}
+        layout: List[FieldLayout] = []
+        converters: List[Optional[Callable[[str], Any]]] = []
+        char_only = True
+        positional = True  # 모든 dataclass 필드를 순서대로 위치 인자로 채울 수 있는지
+        for f in dataclass_fields(model_class):
+            if not f.init:
+                positional = False
+                continue
+            if f.name not in ctypes_fields:
+                positional = False
+                if f.default is MISSING and f.default_factory is MISSING:
+                    raise TypeError(
+                        f"C 구조체에 필드 없음: {struct_class.__name__}.{f.name} "
+                        f"(model={model_class.__name__})"
+                    )
+                continue
+            width = _char_field_width(ctypes_fields[f.name])
+            if not width:
+                char_only = False
+            layout.append((f.name, getattr(struct_class, f.name).offset, width))
+            converters.append(
+                _field_converter(model_class, f.name, hints.get(f.name, str)) if typed else None
+            )
+        self.layout = tuple(layout)
+        self.converters = tuple(converters)
+
+        self._sign: Optional[Tuple[int, int, FrozenSet[str]]] = None  # (오프셋, 폭, 음수 부호)
+        self._signed: Tuple[int, ...] = ()                            # 부호를 적용할 layout 인덱스
+        if typed:
+            self._resolve_sign(ctypes_fields)
+
+        self.native = False
+        self._table = None
+        self._view_class: Optional[Type[BlockView]] = None
+        self._char_only = char_only
+        if char_only and positional and _fastdecode is not None:
+            self._table = self._native_layout()
+            self.decode, self.decode_array = self._table.decode, self._table.decode_array
+            self.native = True
+        elif char_only:
+            self.decode, self.decode_array = self._compile()
+        else:
+            self.decode, self.decode_array = self._compile_fallback()
+
+    def _resolve_sign(self, ctypes_fields: Dict[str, Any]) -> None:
+        """SIGN_FIELD/SIGNED_FIELDS/NEGATIVE_SIGNS 클래스 변수 해석"""
+        model_name = self.model_class.__name__
+        sign_field = getattr(self.model_class, "SIGN_FIELD", None)
+        signed_fields = tuple(getattr(self.model_class, "SIGNED_FIELDS", ()))
+        if sign_field is None or not signed_fields:
+            return
+
+        sign_width = _char_field_width(ctypes_fields.get(sign_field, ctypes.c_int))
+        if not sign_width:
+            raise TypeError(
+                f"SIGN_FIELD는 C 구조체의 c_char 필드여야 합니다: "
+                f"{self.struct_class.__name__}.{sign_field} (model={model_name})"
+            )
+        negatives = frozenset(getattr(self.model_class, "NEGATIVE_SIGNS", ()))
+        if any(len(sign) != 1 or not sign.isascii() for sign in negatives):
+            raise TypeError(f"NEGATIVE_SIGNS는 ASCII 한 글자 부호여야 합니다: {model_name}")
+
+        index = {name: i for i, (name, _, _) in enumerate(self.layout)}
+        signed = []
+        for name in signed_fields:
+            i = index.get(name)
+            if i is None or self.converters[i] not in (_to_int, _to_decimal):
+                raise TypeError(f"SIGNED_FIELDS는 int/Decimal 필드여야 합니다: {model_name}.{name}")
+            signed.append(i)
+
+        self._sign = (getattr(self.struct_class, sign_field).offset, sign_width, negatives)
+        self._signed = tuple(signed)
+
+    def _native_layout(self) -> Any:
+        """C 확장 모듈 Layout 생성 (int/time 필드는 C에서 직접 파싱, 나머지 변환은 함수 호출)"""
+        fields = []
+        for i, ((_, off, width), converter) in enumerate(zip(self.layout, self.converters)):
+            if converter is None:
+                kind = _KIND_STR
+            elif converter is _to_int:
+                kind = _KIND_INT
+            elif converter is _to_time:
+                kind = _KIND_TIME
+            else:
+                kind = _KIND_CALL
+            fields.append((off, width, kind, converter, i in self._signed))
+
+        sign = None
+        if self._sign is not None:
+            off, width, negatives = self._sign
+            sign = (off, width, "".join(sorted(negatives)).encode("ascii"))
+        return _fastdecode.Layout(self.model_class, self.size, fields, sign)
+
+    def _compile(self) -> Tuple[Callable, Callable]:
+        """블록 전용 디코드 함수 생성"""
+        size = self.size
+        struct_name = self.struct_class.__name__
+
+        def args(text_expr: Callable[[int, int], str], raw_expr: Callable[[int, int], str]) -> str:
+            """경로별 인자 목록 (text_expr: str 필드 식, raw_expr: 변환 함수 입력 식)"""
+            items = []
+            for i, ((name, off, width), converter) in enumerate(zip(self.layout, self.converters)):
+                if converter is None:
+                    items.append(f"{name}={text_expr(off, width)}")
+                    continue
+                expr = f"_c{i}({raw_expr(off, width)})"
+                if i in self._signed:
+                    expr = f"_sign({expr}, {raw_expr(sign_off, sign_width)}, _neg)"
+                items.append(f"{name}={expr}")
+            return ", ".join(items)
+
+        sign_off, sign_width, negatives = self._sign or (0, 0, frozenset())
+
+        def sliced(off: int, width: int) -> str:
+            return f"s[b + {off}:b + {off + width}]"
+
+        fast_args = args(lambda off, width: f"{sliced(off, width)}.strip()", sliced)
+        # latin-1은 1바이트 = 1문자이므로 오프셋이 유지됨. 비ASCII 필드만 cp949로 다시 디코딩
+        # (타입 변환 필드도 str 필드와 같은 디코딩 결과를 변환 함수에 전달)
+        def recoded(off: int, width: int) -> str:
+            return f"(v.strip() if (v := {sliced(off, width)}).isascii() else _recode(v))"
+
+        mbcs_args = args(recoded, recoded)
+        def field(off: int, width: int) -> str:
+            return f"_field(rec, {off}, {width})"
+
+        slow_args = args(field, field)
+        src = f"""
+def decode(buf, offset=0):
+    rec = buf[offset:offset + {size}]
+    if len(rec) < {size}:
+        raise ValueError(
+            f"데이터 크기 부족: len={{len(rec)}}, required={size} (struct={struct_name})"
+        )
+    if b"\\0" in rec:
+        return _model({slow_args})
+    b = 0
+    if rec.isascii():
+        s = rec.decode("ascii")
+        return _model({fast_args})
+    s = rec.decode("latin-1")
+    return _model({mbcs_args})
+
+def decode_array(buf, count):
+    end = count * {size}
+    data = buf[:end]
+    if len(data) < end:
+        raise ValueError(
+            f"데이터 크기 부족: len={{len(data)}}, required={{end}} (struct={struct_name})"
+        )
+    if data.isascii() and b"\\0" not in data:
+        s = data.decode("ascii")
+        return [_model({fast_args}) for b in range(0, end, {size})]
+    return [decode(data, b) for b in range(0, end, {size})]
+"""
+        namespace: Dict[str, Any] = {
+            "_model": self.model_class,
+            "_field": _decode_field,
+            "_recode": _recode_field,
+            "_sign": _apply_sign,
+            "_neg": negatives,
+        }
+        for i, converter in enumerate(self.converters):
+            if converter is not None:
+                namespace[f"_c{i}"] = converter
+        exec(compile(src, f"<decoder {self.model_class.__name__}>", "exec"), namespace)
+        return namespace["decode"], namespace["decode_array"]
+
+    def decode_columns(self, buf: bytes, count: int) -> Columns:
+        """연속된 레코드 count건을 필드별 컬럼으로 디코딩
+
+        레코드 객체를 만들지 않고 버퍼를 한 번만 디코딩한 뒤 필드 오프셋으로 잘라 컬럼을 채웁니다.
+        값은 decode_array()와 동일합니다.
+
+        Args:
+            buf: 원시 바이너리 데이터
+            count: 레코드 수
+
+        Returns:
+            Columns: 필드별 컬럼
+        """
+        names = tuple(name for name, _, _ in self.layout)
+        if self._table is not None:
+            return Columns(self.model_class, names, self._table.decode_columns(buf, count), count)
+
+        size = self.size
+        end = count * size
+        data = memoryview(buf)[:end].tobytes()
+        if len(data) < end:
+            raise ValueError(
+                f"데이터 크기 부족: len={len(data)}, required={end} "
+                f"(struct={self.struct_class.__name__})"
+            )
+        starts = range(0, end, size)
+
+        if b"\0" in data or any(not width for _, _, width in self.layout):
+            # NUL 또는 c_char 이외 필드: 레코드 단위 디코딩 후 전치 (이미 타입 변환됨)
+            records = self.decode_array(data, count)
+            return Columns(
+                self.model_class, names,
+                [[getattr(r, name) for r in records] for name in names], count,
+            )
+
+        if data.isascii():
+            s = data.decode("ascii")
+            columns = [
+                [s[b + off:b + off + width].strip() for b in starts]
+                for _, off, width in self.layout
+            ]
+        else:
+            s = data.decode("latin-1")
+            columns = [
+                [
+                    v.strip() if (v := s[b + off:b + off + width]).isascii() else _recode_field(v)
+                    for b in starts
+                ]
+                for _, off, width in self.layout
+            ]
+
+        if self.typed:
+            columns = [
+                column if converter is None else [converter(v) for v in column]
+                for converter, column in zip(self.converters, columns)
+            ]
+            if self._signed:
+                sign_off, sign_width, negatives = self._sign
+                negative = [s[b + sign_off:b + sign_off + sign_width].strip() in negatives for b in starts]
+                for i in self._signed:
+                    columns[i] = [
+                        -abs(v) if neg and v is not None else v for v, neg in zip(columns[i], negative)
+                    ]
+        return Columns(self.model_class, names, columns, count)
+
+    @property
+    def view_class(self) -> Type[BlockView]:
+        """블록 전용 BlockView 서브클래스 (첫 요청 시 생성)
+
+        필드마다 첫 접근 시 디코딩 → 변환 → 캐시하는 property를 생성합니다.
+        C 확장 모듈이 있으면 필드 1개 디코딩(변환/부호 포함)을 Layout.field()로 처리합니다.
+        """
+        if self._view_class is None:
+            self._view_class = self._compile_view()
+        return self._view_class
+
+    def view(self, buf: Any, offset: int = 0) -> Union[BlockView, "OutBlock"]:
+        """레코드 1건의 지연 필드 뷰 (버퍼를 복사하지 않음)
+
+        c_char 이외의 필드가 있는 블록은 decode()와 같은 OutBlock을 반환합니다.
+
+        Raises:
+            ValueError: 버퍼 크기 부족
+        """
+        if len(buf) - offset < self.size or offset < 0:
+            raise ValueError(
+                f"데이터 크기 부족: len={len(buf) - offset}, required={self.size} "
+                f"(struct={self.struct_class.__name__})"
+            )
+        if not self._char_only:
+            return self.decode(bytes(buf[offset:offset + self.size]))
+        return (self._view_class or self.view_class)(buf, offset)
+
+    def view_array(self, buf: Any, count: int) -> List[Union[BlockView, "OutBlock"]]:
+        """연속된 레코드 count건의 지연 필드 뷰 (모든 뷰가 같은 버퍼를 공유)"""
+        end = count * self.size
+        if len(buf) < end:
+            raise ValueError(
+                f"데이터 크기 부족: len={len(buf)}, required={end} "
+                f"(struct={self.struct_class.__name__})"
+            )
+        if not self._char_only:
+            return self.decode_array(bytes(buf[:end]), count)
+        view_class = self.view_class
+        return [view_class(buf, offset) for offset in range(0, end, self.size)]
+
+    def _compile_view(self) -> Type[BlockView]:
+        """블록 전용 뷰 클래스 생성"""
+        names = tuple(name for name, _, _ in self.layout)
+        reserved = [name for name in names if hasattr(BlockView, name)]
+        if reserved:
+            raise TypeError(f"BlockView 속성과 겹치는 필드명: {self.model_class.__name__}.{reserved}")
+
+        def field(off: int, width: int) -> str:
+            return f"_field(self._buf, b + {off}, {width})"
+
+        sign_off, sign_width, negatives = self._sign or (0, 0, frozenset())
+        getters = []
+        for i, ((name, off, width), converter) in enumerate(zip(self.layout, self.converters)):
+            if self._table is not None:
+                expr = f"_native(self._buf, b, {i})"
+            else:
+                expr = field(off, width)
+                if converter is not None:
+                    expr = f"_c{i}({expr})"
+                if i in self._signed:
+                    expr = f"_sign({expr}, {field(sign_off, sign_width)}, _neg)"
+            getters.append(f"""
+def _get_{name}(self):
+    v = self._cache[{i}]
+    if v is _missing:
+        b = self._base
+        v = self._cache[{i}] = {expr}
+    return v
+""")
+
+        namespace: Dict[str, Any] = {
+            "_missing": BlockView._MISSING,
+            "_field": _view_field,
+            "_native": self._table.field if self._table is not None else None,
+            "_sign": _apply_sign,
+            "_neg": negatives,
+        }
+        for i, converter in enumerate(self.converters):
+            if converter is not None:
+                namespace[f"_c{i}"] = converter
+        exec(compile("".join(getters), f"<view {self.model_class.__name__}>", "exec"), namespace)
+
+        attrs: Dict[str, Any] = {
+            "__slots__": (),
+            "__doc__": f"{self.model_class.__name__}의 지연 필드 뷰",
+            "_decoder": self,
+            "_fields": names,
+        }
+        for name in names:
+            attrs[name] = property(namespace[f"_get_{name}"])
+        return type(f"{self.model_class.__name__}View", (BlockView,), attrs)
+
+    def _compile_fallback(self) -> Tuple[Callable, Callable]:
+        """c_char 이외의 필드가 있는 블록용 디코드 함수 (from_c_struct 경로 + 타입 변환)"""
+        size = self.size
+        struct_class = self.struct_class
+        model_class = self.model_class
+        sign = self._sign
+        signed = self._signed
+        typed_fields = [
+            (i, name, converter)
+            for i, ((name, _, _), converter) in enumerate(zip(self.layout, self.converters))
+            if converter is not None
+        ]
+
+        def decode(buf, offset=0):
+            rec = bytes(buf[offset:offset + size])
+            if len(rec) < size:
+                raise ValueError(
+                    f"데이터 크기 부족: len={len(rec)}, required={size} (struct={struct_class.__name__})"
+                )
+            result = model_class._from_c_struct_reflect(struct_class.from_buffer_copy(rec))
+            if typed_fields:
+                negative = sign is not None and _decode_field(rec, sign[0], sign[1]) in sign[2]
+                for i, name, converter in typed_fields:
+                    value = converter(getattr(result, name))
+                    if negative and i in signed and value is not None:
+                        value = -abs(value)
+                    setattr(result, name, value)
+            return result
+
+        def decode_array(buf, count):
+            return [decode(buf, i * size) for i in range(count)]
+
+        return decode, decode_array
+
+    def __repr__(self) -> str:
+        return (
+            f"BlockDecoder(struct={self.struct_class.__name__}, "
+            f"model={self.model_class.__name__}, size={self.size}, fields={len(self.layout)}, "
+            f"typed={self.typed}, native={self.native})"
+        )
+
+
+# (C 구조체, OutBlock, typed) → BlockDecoder 캐시
+_decoders: Dict[Tuple[type, type, bool], BlockDecoder] = {}
+
+
+def get_decoder(
+    struct_class: Type[Structure], model_class: Type["OutBlock"], typed: bool = True
+) -> BlockDecoder:
+    """(C 구조체, OutBlock) 쌍의 디코더 조회 (최초 1회 생성 후 캐시)
+
+    Args:
+        typed: False면 모든 필드를 str로 디코딩 (타입 변환 이전 동작)
+    """
+    key = (struct_class, model_class, typed)
+    decoder = _decoders.get(key)
+    if decoder is None:
+        decoder = _decoders[key] = BlockDecoder(struct_class, model_class, typed)
+    return decoder
+
+
+__all__ = [
+    "Columns",
+    "BlockView",
+    "BlockDecoder",
+    "FIELD_CONVERTERS",
+    "get_decoder",
+]
@@ -1,7 +1,11 @@
 from ctypes import Structure, c_char
 from dataclasses import dataclass
+from datetime import time as dtime
+from decimal import Decimal
+from typing import ClassVar, Optional, Tuple
 
 from ..common import OutBlock
+from ..parser_info import register_block
 
 
 class CTj8OutBlock(Structure):
@@ -42,9 +46,13 @@ class CTj8OutBlock(Structure):
         ("_janggubun", c_char * 1),
     ]
 
-@dataclass
+@dataclass(slots=True)
 class Tj8OutBlock(OutBlock):
     """코스피/코스닥 체결 시세(j8) 데이터 블록
+
+    sign이 '4'(하한) 또는 '5'(하락)이면 change, chrate는 음수로 변환됩니다.
+    빈 필드는 None입니다. (typed=False로 파싱하면 모든 필드가 str)
+
     Attributes:
         code: 종목코드
         time: 시간
@@ -64,25 +72,35 @@ class Tj8OutBlock(OutBlock):
         avgprice: 가중평균가
         janggubun: 장구분
     """
+    SIGN_FIELD: ClassVar[Optional[str]] = "sign"
+    SIGNED_FIELDS: ClassVar[Tuple[str, ...]] = ("change", "chrate")
+
     code: str
-    time: str
+    time: Optional[dtime]
     sign: str
-    change: str
-    price: str
-    chrate: str
-    high: str
-    low: str
-    offer: str
-    bid: str
-    volume: str
-    volrate: str
-    movolume: str
-    value: str
-    open: str
-    avgprice: str
+    change: Optional[int]
+    price: Optional[int]
+    chrate: Optional[Decimal]
+    high: Optional[int]
+    low: Optional[int]
+    offer: Optional[int]
+    bid: Optional[int]
+    volume: Optional[int]
+    volrate: Optional[Decimal]
+    movolume: Optional[int]
+    value: Optional[int]
+    open: Optional[int]
+    avgprice: Optional[int]
     janggubun: str
 
 
+# ==============================================================================
+# 파서 등록
+# ==============================================================================
+
+register_block("j8", CTj8OutBlock, Tj8OutBlock)
+
+
 __all__ = [
     "CTj8OutBlock",
     "Tj8OutBlock",
@@ -1,13 +1,15 @@
 """주문 관련 TR 구조체 정의 (trio_ord.h 기반)"""
 
-from typing import ClassVar, Type
+from typing import ClassVar, Optional, Type
 from dataclasses import dataclass
+from decimal import Decimal
 import ctypes
 from ctypes import Structure
 
 from pydantic import Field, field_validator
 
 from ..common import InBlock, OutBlock
+from ..parser_info import register_block
 
 
 # ==============================================================================
@@ -146,7 +148,7 @@ class CTc8201OutBlock(ctypes.Structure):
     ]
 
 
-@dataclass
+@dataclass(slots=True)
 class Tc8201OutBlock(OutBlock):
     """c8201 잔고조회 OutBlock (계좌 요약 정보)
 
@@ -156,26 +158,26 @@ class Tc8201OutBlock(OutBlock):
         >>> # Received.from_c_struct()가 자동으로 파싱
         >>> result = agent.query("c8201", input_data, nAccountIndex=1)
         >>> if result.success:
-        ...     # szData는 이미 Tc8201OutBlock 타입
+        ...     # szData는 이미 Tc8201OutBlock 타입 (금액은 int, 비율은 Decimal)
         ...     outblock: Tc8201OutBlock = result.pData.szData
         ...     print(f"예수금: {outblock.dpsit_amtz16}")
         ...     print(f"출금가능금액: {outblock.chgm_pos_amtz16}")
     """
-    dpsit_amtz16: str           # 예수금
-    mrgn_amtz16: str            # 신용융자금
-    mgint_npaid_amtz16: str     # 이자미납금
-    chgm_pos_amtz16: str        # 출금가능금액
-    cash_mrgn_amtz16: str       # 현금증거금
-    subst_mgamt_amtz16: str     # 대용증거금
-    coltr_ratez6: str           # 담보비율
-    rcble_amtz16: str           # 현금미수금
-    order_pos_csamtz16: str     # 주문가능액
-    pos_csamt4z16: str          # 100%주문가능금액
-    bal_buy_ttamtz16: str       # 매입원가
-    bal_ass_ttamtz16: str       # 평가금액
-    asset_tot_amtz16: str       # 순자산액
-    tot_eal_plsz18: str         # 총평가손익
-    pft_rtz15: str              # 수익율
+    dpsit_amtz16: Optional[int]       # 예수금
+    mrgn_amtz16: Optional[int]        # 신용융자금
+    mgint_npaid_amtz16: Optional[int] # 이자미납금
+    chgm_pos_amtz16: Optional[int]    # 출금가능금액
+    cash_mrgn_amtz16: Optional[int]   # 현금증거금
+    subst_mgamt_amtz16: Optional[int] # 대용증거금
+    coltr_ratez6: Optional[Decimal]   # 담보비율
+    rcble_amtz16: Optional[int]       # 현금미수금
+    order_pos_csamtz16: Optional[int] # 주문가능액
+    pos_csamt4z16: Optional[int]      # 100%주문가능금액
+    bal_buy_ttamtz16: Optional[int]   # 매입원가
+    bal_ass_ttamtz16: Optional[int]   # 평가금액
+    asset_tot_amtz16: Optional[int]   # 순자산액
+    tot_eal_plsz18: Optional[int]     # 총평가손익
+    pft_rtz15: Optional[Decimal]      # 수익율
 
 
 class CTc8201OutBlock1(ctypes.Structure):
@@ -221,28 +223,37 @@ class CTc8201OutBlock1(ctypes.Structure):
         ("_post_lsnpf_amtz16", ctypes.c_char * 1),
     ]
 
-@dataclass
+@dataclass(slots=True)
 class Tc8201OutBlock1(OutBlock):
     """c8201 잔고조회 OutBlock1 (보유종목 정보)
     """
 
-    issue_codez6: str
-    issue_namez40: str
-    bal_typez6: str
-    loan_datez10: str
-    bal_qtyz16: str
-    unstl_qtyz16: str
-    slby_amtz16: str
-    prsnt_pricez16: str
-    lsnpf_amtz16: str
-    earn_ratez9: str
-    mrgn_codez4: str
-    jan_qtyz16: str
-    expr_datez10: str
-    ass_amtz16: str
-    issue_mgamt_ratez6: str
-    medo_slby_amtz16: str
-    post_lsnpf_amtz16: str
+    issue_codez6: str                     # 종목번호
+    issue_namez40: str                    # 종목명
+    bal_typez6: str                       # 잔고유형
+    loan_datez10: str                     # 대출일
+    bal_qtyz16: Optional[int]             # 잔고수량
+    unstl_qtyz16: Optional[int]           # 미결제수량
+    slby_amtz16: Optional[Decimal]        # 평균매입가
+    prsnt_pricez16: Optional[int]         # 현재가
+    lsnpf_amtz16: Optional[int]           # 손익(천원)
+    earn_ratez9: Optional[Decimal]        # 손익율
+    mrgn_codez4: str                      # 신용코드
+    jan_qtyz16: Optional[int]             # 잔량
+    expr_datez10: str                     # 만기일
+    ass_amtz16: Optional[int]             # 평가금액
+    issue_mgamt_ratez6: Optional[Decimal] # 증거금율
+    medo_slby_amtz16: Optional[int]       # 매도매입금
+    post_lsnpf_amtz16: Optional[int]      # 매도손익
+
+
+# ==============================================================================
+# 파서 등록
+# ==============================================================================
+
+register_block("c8201OutBlock", CTc8201OutBlock, Tc8201OutBlock)
+register_block("c8201OutBlock1", CTc8201OutBlock1, Tc8201OutBlock1, is_array=True)
+
 
 __all__ = [
     "CTc8201InBlock",
@@ -1,16 +1,139 @@
-"""주문 관련 TR 구조체 정의 (trio_ord.h 기반)"""
+"""블록 파서 레지스트리
+
+szBlockName → (C 구조체, OutBlock 클래스, 반복 여부) 매핑을 dict로 보관합니다.
+각 블록 모듈(inv/j8.py, ord/c8201.py 등)이 모듈 하단에서 register_block()으로 등록하고,
+structures 패키지가 import될 때 기본 블록 모듈을 한 번 import합니다.
+
+사용자 정의 TR 블록도 패키지를 수정하지 않고 등록할 수 있습니다.
+
+    >>> from pynamuh.structures.parser_info import register_block
+    >>> register_block("c1101OutBlock", CTc1101OutBlock, Tc1101OutBlock)
+    >>> register_block("c1101OutBlock2", CTc1101OutBlock2, Tc1101OutBlock2, is_array=True)
+"""
 
-from typing import ClassVar, Type, TYPE_CHECKING
-from dataclasses import dataclass
 import ctypes
 from ctypes import Structure
+from typing import Dict, Optional, Type, TYPE_CHECKING
 
-from pydantic import Field, field_validator
+from .decoder import BlockDecoder, get_decoder
 
 if TYPE_CHECKING:
     from .common import OutBlock
 
 
+class BlockInfo:
+    """등록된 블록 정보
+
+    등록 시점에 구조체 크기와 (typed) 디코더를 한 번 계산해 둡니다.
+
+    Attributes:
+        name: 블록명 (szBlockName)
+        struct_class: C 구조체 클래스
+        model_class: OutBlock 서브클래스
+        is_array: 반복 블록 여부
+        size: 레코드 크기 (bytes)
+    """
+
+    __slots__ = ("name", "struct_class", "model_class", "is_array", "size", "_decoder", "_str_decoder")
+
+    def __init__(
+        self,
+        name: str,
+        struct_class: Type[Structure],
+        model_class: Type["OutBlock"],
+        is_array: bool = False
+    ):
+        self.name = name
+        self.struct_class = struct_class
+        self.model_class = model_class
+        self.is_array = is_array
+        self.size = ctypes.sizeof(struct_class)
+        self._decoder = get_decoder(struct_class, model_class, typed=True)
+        self._str_decoder: Optional[BlockDecoder] = None
+
+    def decoder(self, typed: bool = True) -> BlockDecoder:
+        """블록 디코더 (typed=False 디코더는 첫 요청 시 생성)"""
+        if typed:
+            return self._decoder
+        if self._str_decoder is None:
+            self._str_decoder = get_decoder(self.struct_class, self.model_class, typed=False)
+        return self._str_decoder
+
+    def as_tuple(self) -> tuple[Type[Structure], Type["OutBlock"], bool]:
+        """(C 구조체, OutBlock 클래스, is_array) 튜플 (get_parser_info() 반환 형식)"""
+        return (self.struct_class, self.model_class, self.is_array)
+
+    def __repr__(self) -> str:
+        return (
+            f"BlockInfo(name={self.name!r}, struct={self.struct_class.__name__}, "
+            f"model={self.model_class.__name__}, is_array={self.is_array}, size={self.size})"
+        )
+
+
+# szBlockName → BlockInfo
+_registry: Dict[str, BlockInfo] = {}
+
+# 데이터 없이 TR 코드 자체가 블록명으로 오는 경우 (파싱하지 않고 bytes 그대로)
+_PASSTHROUGH_BLOCKS = frozenset({"c8201"})
+
+
+def register_block(
+    name: str,
+    struct_class: Type[Structure],
+    model_class: Type["OutBlock"],
+    is_array: bool = False,
+    replace: bool = False
+) -> BlockInfo:
+    """블록 파서 등록
+
+    Args:
+        name: 블록명 (szBlockName, 예: "c8201OutBlock1", 실시간은 "j8")
+        struct_class: C 구조체 클래스
+        model_class: OutBlock 서브클래스 (@dataclass)
+        is_array: 반복 블록 여부 (나무증권 API SPEC 문서 참고)
+        replace: True면 같은 이름으로 등록된 다른 블록을 교체
+
+    Returns:
+        BlockInfo: 등록된 블록 정보
+
+    Raises:
+        ValueError: 같은 이름으로 다른 블록이 이미 등록된 경우 (replace=False)
+        TypeError: C 구조체/OutBlock 클래스가 올바르지 않은 경우
+    """
+    if not isinstance(name, str) or not name:
+        raise ValueError(f"블록명은 비어 있지 않은 문자열이어야 합니다: {name!r}")
+    if not (isinstance(struct_class, type) and issubclass(struct_class, Structure)):
+        raise TypeError(f"struct_class는 ctypes.Structure 서브클래스여야 합니다: {struct_class!r}")
+
+    current = _registry.get(name)
+    if current is not None and not replace:
+        if current.as_tuple() == (struct_class, model_class, is_array):
+            return current
+        raise ValueError(
+            f"이미 등록된 블록: {name} ({current.struct_class.__name__}, "
+            f"{current.model_class.__name__}). 교체하려면 replace=True"
+        )
+
+    info = BlockInfo(name, struct_class, model_class, is_array)
+    _registry[name] = info
+    return info
+
+
+def unregister_block(name: str) -> Optional[BlockInfo]:
+    """블록 등록 해제 (등록되지 않은 블록이면 None)"""
+    return _registry.pop(name, None)
+
+
+def lookup_block(block_name: str) -> Optional[BlockInfo]:
+    """블록 정보 조회 (미등록 블록이면 예외 없이 None)"""
+    return _registry.get(block_name)
+
+
+def registered_blocks() -> Dict[str, BlockInfo]:
+    """등록된 블록 목록 (복사본)"""
+    return dict(_registry)
+
+
 def get_parser_info(block_name: str) -> tuple[Type[Structure], Type["OutBlock"], bool]:
     """파서 정보 조회
 
@@ -19,19 +142,24 @@ def get_parser_info(block_name: str) -> tuple[Type[Structure], Type["OutBlock"],
 
     Returns:
         (OutBlock C구조체, OutBlock Python Class, is_array) 튜플
+        (데이터 없는 TR 코드 블록이면 None)
+
+    Raises:
+        ValueError: 등록되지 않은 블록
     """
-    match block_name:
-        case "j8":
-            from .inv.j8 import CTj8OutBlock, Tj8OutBlock
-            return (CTj8OutBlock, Tj8OutBlock, False)
-        case "c8201OutBlock":
-            from .ord.c8201 import CTc8201OutBlock, Tc8201OutBlock
-            return (CTc8201OutBlock, Tc8201OutBlock, False)
-        case "c8201OutBlock1":
-            from .ord.c8201 import CTc8201OutBlock1, Tc8201OutBlock1
-            return (CTc8201OutBlock1, Tc8201OutBlock1, True)
-        case "c8201":
-            return None    
-        case _:
-            raise ValueError(f"아직 Block이 구현되지 않음! : {block_name}")
+    info = _registry.get(block_name)
+    if info is not None:
+        return info.as_tuple()
+    if block_name in _PASSTHROUGH_BLOCKS:
+        return None
+    raise ValueError(f"아직 Block이 구현되지 않음! : {block_name}")
+
 
+__all__ = [
+    "BlockInfo",
+    "register_block",
+    "unregister_block",
+    "lookup_block",
+    "registered_blocks",
+    "get_parser_info",
+]
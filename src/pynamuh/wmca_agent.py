@@ -3,68 +3,100 @@
 """
 WMCA DLL 저수준 클라이언트
 DLL 함수 호출, Windows 메시지 처리, 응답을 Python 객체로 변환
+
+DLL 호출과 메시지 펌프는 Transport(wmca_transport.py)가 담당합니다.
+(기본값 Win32Transport, 저널 재생은 ReplayTransport)
 """
 
-import os
 import sys
-import win32gui
-import win32con
 import ctypes
-from ctypes import c_char_p, c_int, c_char, WINFUNCTYPE
-from ctypes.wintypes import HWND, UINT, WPARAM, LPARAM, DWORD
-from typing import Generator, Optional, Any, Literal, Tuple
+from typing import Dict, Generator, Optional, Any, Iterable, Literal, Tuple, List, Union
 from pathlib import Path
 from enum import IntEnum
+from dataclasses import dataclass, field
+import logging
 import queue
+import threading
+import time
 
-from .wmca_logger import logger
+from .wmca_logger import logger, ensure_configured
 from .wmca_message_parser import WMCAMessageParser
-from .structures.common import InBlock
+from .wmca_ring_buffer import SPSCRingBuffer, HandoffStats
+from .wmca_journal import TickJournal
+from .wmca_latency import LatencyStats
+from .wmca_conflation import LatestValueStore
+from .wmca_event_queue import BoundedEventQueue, DropStats, OverflowPolicy, OVERFLOW_POLICIES
+from .wmca_correlator import QueryCorrelator, QueryFuture
+from .wmca_transport import Transport, WM_USER, CA_WMCAEVENT
+from .structures.common import InBlock, DecodeMode, raw_from_lparam
 
-# Windows 프로시저 콜백 타입 정의
-WNDPROC = WINFUNCTYPE(ctypes.c_long, HWND, UINT, WPARAM, LPARAM)
+PumpMode = Literal["wait", "poll"]
 
-# Windows API
-user32 = ctypes.windll.user32
-kernel32 = ctypes.windll.kernel32
 
+# ============================================================================
+# 응답 메시지 상수 (SDK.pdf 페이지 11)
+# ============================================================================
 
-# MSG 구조체
-class MSG(ctypes.Structure):
-    _fields_ = [
-        ("hWnd", HWND),
-        ("message", UINT),
-        ("wParam", WPARAM),
-        ("lParam", LPARAM),
-        ("time", ctypes.wintypes.DWORD),
-        ("pt", ctypes.wintypes.POINT),
-    ]
+class WMCAMessage(IntEnum):
+    """WMCA 응답 메시지 종류"""
 
+    CA_CONNECTED = WM_USER + 110  # 로그인 성공
+    CA_DISCONNECTED = WM_USER + 120  # 연결 해제
+    CA_SOCKETERROR = WM_USER + 130  # 통신 오류
+    CA_RECEIVEDATA = WM_USER + 210  # TR 결과 수신
+    CA_RECEIVESISE = WM_USER + 220  # 실시간 시세 수신
+    CA_RECEIVEMESSAGE = WM_USER + 230  # 상태 메시지
+    CA_RECEIVECOMPLETE = WM_USER + 240  # 처리 완료
+    CA_RECEIVEERROR = WM_USER + 250  # 처리 실패
 
-# Windows 환경 확인
-if sys.platform != "win32":
-    raise OSError("이 모듈은 Windows 환경에서만 실행 가능합니다.")
+
+# submit_query() 응답으로 QueryCorrelator에 먼저 전달하는 메시지
+_TR_RESPONSES = frozenset((
+    WMCAMessage.CA_RECEIVEMESSAGE,
+    WMCAMessage.CA_RECEIVEDATA,
+    WMCAMessage.CA_RECEIVECOMPLETE,
+    WMCAMessage.CA_RECEIVEERROR,
+))
 
 
 # ============================================================================
-# 응답 메시지 상수 (SDK.pdf 페이지 11)
+# 메시지 펌프 통계
 # ============================================================================
 
-# WMCA 이벤트 메시지 (샘플 코드 참고)
-CA_WMCAEVENT = win32con.WM_USER + 8400  # 중요! wparam에 실제 메시지 타입이 들어있음
 
+@dataclass
+class PumpStats:
+    """receive_events() 메시지 펌프 통계
 
-class WMCAMessage(IntEnum):
-    """WMCA 응답 메시지 종류"""
+    Attributes:
+        events: 소비자에게 전달된 이벤트 수
+        dispatched: transport가 처리한 메시지 수 (Win32: DispatchMessageW)
+        wakeups: 대기(Win32: MsgWaitForMultipleObjectsEx) 후 깨어난 횟수
+        started_at: 통계 수집 시작 시각 (time.monotonic 기준)
+    """
 
-    CA_CONNECTED = win32con.WM_USER + 110  # 로그인 성공
-    CA_DISCONNECTED = win32con.WM_USER + 120  # 연결 해제
-    CA_SOCKETERROR = win32con.WM_USER + 130  # 통신 오류
-    CA_RECEIVEDATA = win32con.WM_USER + 210  # TR 결과 수신
-    CA_RECEIVESISE = win32con.WM_USER + 220  # 실시간 시세 수신
-    CA_RECEIVEMESSAGE = win32con.WM_USER + 230  # 상태 메시지
-    CA_RECEIVECOMPLETE = win32con.WM_USER + 240  # 처리 완료
-    CA_RECEIVEERROR = win32con.WM_USER + 250  # 처리 실패
+    events: int = 0
+    dispatched: int = 0
+    wakeups: int = 0
+    started_at: float = field(default_factory=time.monotonic)
+
+    @property
+    def elapsed(self) -> float:
+        """통계 수집 시작 이후 경과 시간 (초)"""
+        return time.monotonic() - self.started_at
+
+    @property
+    def events_per_sec(self) -> float:
+        """실측 이벤트 처리량 (events/s)"""
+        elapsed = self.elapsed
+        return self.events / elapsed if elapsed > 0 else 0.0
+
+    def reset(self):
+        """통계 초기화"""
+        self.events = 0
+        self.dispatched = 0
+        self.wakeups = 0
+        self.started_at = time.monotonic()
 
 
 # ============================================================================
@@ -82,26 +114,106 @@ class WMCAAgent:
     - 응답 메시지를 Python 객체로 변환
     """
 
-    def __init__(self, dll_path: Optional[str] = None):
+    def __init__(
+        self,
+        dll_path: Optional[str] = None,
+        pump_mode: PumpMode = "wait",
+        threaded: bool = False,
+        ring_capacity: int = 65536,
+        decode: DecodeMode = "eager",
+        columnar: bool = False,
+        typed: bool = True,
+        envelope: bool = True,
+        journal: Union[TickJournal, str, Path, None] = None,
+        transport: Optional[Transport] = None,
+        latency: bool = False,
+        conflate: Union[bool, Iterable[str]] = False,
+        conflate_capacity: int = 4096,
+        queue_capacity: Optional[int] = None,
+        overflow_policy: Union[OverflowPolicy, Dict["WMCAMessage", OverflowPolicy]] = "drop_oldest",
+    ):
         """
         WMCAAgent 초기화
 
         Args:
-            dll_path: wmca.dll 경로 (None이면 자동 탐색)
+            dll_path: wmca.dll 경로 (None이면 자동 탐색, transport를 지정하면 무시)
+            pump_mode: receive_events()의 메시지 펌프 방식
+                - "wait": 메시지가 도착하거나 timeout이 될 때까지 블로킹 대기 후
+                  대기 중인 메시지를 모두 처리 (기본값, 유휴 시 CPU 사용 없음)
+                - "poll": 루프마다 메시지 1개를 처리하고 10ms 대기 (이전 방식)
+            threaded: True면 전용 펌프 스레드가 숨김 윈도우와 메시지 펌프를 소유하고,
+                파싱된 이벤트를 SPSC 링 버퍼로 소비자 스레드에 전달
+                (느린 소비자가 Windows 메시지 큐를 막지 않음)
+            ring_capacity: threaded 모드의 링 버퍼 크기 (가득 차면 펌프 스레드가 대기)
+            decode: OUTDATABLOCK szData 파싱 방식
+                - "eager": 윈도우 프로시저 안에서 즉시 파싱 (기본값)
+                - "lazy": 원시 bytes, 블록명, TrIndex만 복사하고 szData 첫 접근 시 파싱
+                  (pData는 LazyReceived)
+                - "view": 원시 bytes만 복사하고 szData를 BlockView로 감싸 전달.
+                  필드는 처음 읽을 때 디코딩 후 캐시 (몇 개 필드만 읽는 전략용)
+                - "raw": 파싱하지 않고 원시 bytes 그대로 전달 (레코더용, pData.szData는 bytes)
+            columnar: True면 반복 블록(예: c8201OutBlock1)을 List[OutBlock] 대신
+                필드별 컬럼(Columns, to_numpy()/to_arrow() 지원)으로 파싱
+            typed: True면 OutBlock 어노테이션에 따라 가격/수량/등락률/시각을
+                int/Decimal/datetime.time으로 변환 (기본값). False면 모든 필드를 str로 파싱
+            envelope: False면 OUTDATABLOCK 이벤트를 OutDataBlock(pData=Received) 대신
+                FlatOutDataBlock(TrIndex, szBlockName, szData, nLen) 하나로 전달
+                (이벤트당 객체 수 감소, decode="lazy"와 함께 사용할 수 없음)
+            journal: CA_RECEIVESISE 원시 페이로드를 디코딩 전에 기록할 TickJournal
+                (디렉터리 경로를 주면 에이전트가 생성하고 종료 시 닫음)
+            transport: WMCA 함수 호출/이벤트 전달 계층 (None이면 Win32Transport, Windows 전용).
+                ReplayTransport를 주면 저널을 재생하며 Windows 외 환경에서도 동작
+            latency: True면 이벤트마다 윈도우 프로시저 진입/디코딩 완료/큐 적재/소비자 전달
+                시각을 기록하고 메시지 타입별 구간 지연 히스토그램을 집계 (latency_stats)
+            conflate: CA_RECEIVESISE를 큐에 넣지 않고 종목별 최신값 슬롯에 덮어쓸 실시간 코드
+                (예: ("j8",), True면 모든 실시간 코드). 최신값은 latest로 읽음 (wmca_conflation.py 참고)
+            conflate_capacity: conflate 사용 시 실시간 코드별 최대 종목 수 (넘는 종목은 큐로 전달)
+            queue_capacity: message_queue 최대 이벤트 수. 지정하면 BoundedEventQueue를 사용
+                (threaded 모드에서는 ring_capacity 대신). None이면 기존처럼 제한 없음/링 버퍼
+            overflow_policy: queue_capacity가 가득 찼을 때 실시간 시세(CA_RECEIVESISE) 처리 방식
+                - "drop_oldest": 가장 오래된 시세를 버림 (기본값)
+                - "drop_newest": 새 시세를 버림
+                - "conflate": 큐에 있는 같은 종목의 시세를 새 틱으로 교체 (없으면 drop_oldest)
+                - "block": 소비자가 꺼낼 때까지 대기 (threaded 모드 전용)
+                {WMCAMessage: 정책} dict로 메시지 타입별로 지정할 수 있으나, 주문/TR 응답 등
+                시세 외 메시지는 버리지 않으므로 "block"만 가능 (wmca_event_queue.py 참고)
 
         Note:
             - 서버 주소와 포트는 DLL 내장 설정(wmca.ini) 사용
             - 실제 초기화는 __enter__에서 수행됨
+            - 로깅 설정은 pynamuh.wmca_logger.configure_logging() 참고
         """
 
-        # DLL 경로 자동 탐색
-        if dll_path is None:
+        # 로깅이 설정되지 않았으면 기본값(콘솔 INFO, 백그라운드 writer)으로 설정
+        ensure_configured()
+
+        if pump_mode not in ("wait", "poll"):
+            raise ValueError(f"pump_mode는 'wait' 또는 'poll'이어야 합니다: {pump_mode}")
+        if threaded and pump_mode != "wait":
+            raise ValueError("threaded 모드에서는 pump_mode='wait'만 지원합니다")
+        if decode not in ("eager", "lazy", "view", "raw"):
+            raise ValueError(f"decode는 'eager', 'lazy', 'view', 'raw' 중 하나여야 합니다: {decode}")
+        self.pump_mode = pump_mode
+        self.threaded = threaded
+        self.decode = decode
+        self.columnar = columnar
+        if not envelope and decode == "lazy":
+            raise ValueError("envelope=False는 decode='lazy'와 함께 사용할 수 없습니다")
+        self.typed = typed
+        self.envelope = envelope
+        self._owns_journal = journal is not None and not isinstance(journal, TickJournal)
+        self.journal: Optional[TickJournal] = TickJournal(journal) if self._owns_journal else journal
+
+        if transport is None:
+            if sys.platform != "win32":
+                raise OSError("transport를 지정하지 않으면 Windows 환경에서만 실행 가능합니다. (재생: ReplayTransport)")
+            from .wmca_transport_win32 import Win32Transport
             try:
-                dll_path = self._find_dll_path()
+                transport = Win32Transport(dll_path)
             except FileNotFoundError as e:
                 logger.critical("wmca.dll 경로를 찾지 못 함: %s", e)
                 raise
-        self.dll_path = dll_path
+        self.transport = transport
 
         # DLL 관련 변수
         self.dll = None
@@ -110,28 +222,65 @@ class WMCAAgent:
         # DLL 함수 포인터들
         self._init_function_pointers()
 
-        # Windows 메시지 처리용
-        self.hwnd = None
-        self.wnd_class_name = None  # 윈도우 클래스 이름
-        self.wnd_class_atom = None  # 윈도우 클래스 등록 식별자
+        # 이벤트 수신용
+        self._window_open = False
         self.message_thread = None
-        self.message_queue = queue.Queue()
+        self._queue_policies = self._resolve_overflow_policies(queue_capacity, overflow_policy)
+        self.queue_capacity = queue_capacity
+        self.message_queue = self._new_message_queue(ring_capacity)
+        self.pump_stats = PumpStats()
+        self._latency: Optional[LatencyStats] = LatencyStats() if latency else None
+        self.latest: Optional[LatestValueStore] = None
+        if conflate:
+            self.latest = LatestValueStore(
+                None if conflate is True else conflate, capacity=conflate_capacity, typed=typed
+            )
+        self.correlator = QueryCorrelator()
+        self._owner_thread: Optional[int] = None  # 윈도우를 만든(메시지를 펌핑하는) 스레드
+
+        # threaded 모드 펌프 스레드 제어용
+        self._pump_ready = threading.Event()
+        self._pump_stop = False
+        self._pump_error: Optional[BaseException] = None
 
         # DLL 로드 (함수 포인터만 설정)
         self._load_dll()
 
-    def _find_dll_path(self) -> str:
-        """wmca.dll 경로 자동 탐색"""
-        script_dir = Path(__file__).parent
-        wmca_dll_path = script_dir / "dll" / "wmca.dll"
-
-        if wmca_dll_path.exists():
-            return str(wmca_dll_path)
-
-        raise FileNotFoundError(
-            f"wmca.dll을 찾을 수 없습니다.\n"
-            f"NH투자증권 OpenAPI 라이브러리를 다운받은 후 DLL 파일을 {wmca_dll_path} 경로에 배치해주세요."
-        )
+    def _resolve_overflow_policies(
+        self,
+        queue_capacity: Optional[int],
+        overflow_policy: Union[OverflowPolicy, Dict["WMCAMessage", OverflowPolicy]],
+    ) -> Dict[int, OverflowPolicy]:
+        """overflow_policy 인자 → {메시지 타입: 정책} (시세 외 메시지는 "block"만 허용)"""
+        if isinstance(overflow_policy, str):
+            policies = {WMCAMessage.CA_RECEIVESISE: overflow_policy}
+        else:
+            policies = {WMCAMessage(msg_type): policy for msg_type, policy in overflow_policy.items()}
+        for msg_type, policy in policies.items():
+            if policy not in OVERFLOW_POLICIES:
+                raise ValueError(f"overflow_policy는 {OVERFLOW_POLICIES} 중 하나여야 합니다: {policy!r}")
+            if policy != "block" and msg_type != WMCAMessage.CA_RECEIVESISE:
+                raise ValueError(f"{msg_type.name}는 버릴 수 없는 메시지이므로 'block'만 가능합니다: {policy!r}")
+        if (queue_capacity is not None and not self.threaded
+                and policies.get(WMCAMessage.CA_RECEIVESISE, "block") == "block"):
+            raise ValueError("기본 모드(threaded=False)에서는 실시간 시세에 'block' 정책을 쓸 수 없습니다 (생산자=소비자 스레드)")
+        return policies
+
+    def _new_message_queue(self, ring_capacity: int):
+        """message_queue 생성 (queue_capacity 지정 시 BoundedEventQueue)"""
+        if self.queue_capacity is not None:
+            return BoundedEventQueue(self.queue_capacity, self._queue_policies, blocking=self.threaded)
+        return SPSCRingBuffer(ring_capacity) if self.threaded else queue.Queue()
+
+    @property
+    def hwnd(self) -> Optional[int]:
+        """WMCA 함수 호출 시 넘기는 윈도우 핸들 (transport 소유)"""
+        return self.transport.hwnd
+
+    @property
+    def dll_path(self) -> Optional[str]:
+        """로드한 wmca.dll 경로 (transport 소유, DLL을 쓰지 않는 재생/시뮬레이터 transport면 None)"""
+        return getattr(self.transport, "dll_path", None)
 
     def _init_function_pointers(self):
         """DLL 함수 포인터 초기화"""
@@ -148,29 +297,14 @@ class WMCAAgent:
         self.wmca_set_account_index_pwd = None
 
     def _load_dll(self):
-        """DLL 로드 및 함수 포인터 설정
-
-        Reference:
-            - WmcaIntf.h (23-42줄): 모든 함수의 typedef 정의
-            - SDK.pdf: 함수 프로토타입 상세 설명
+        """transport에서 WMCA 함수 테이블을 받아 함수 포인터 설정
 
         Note:
-            모든 WMCA 함수는 __stdcall 규약 사용 → ctypes.WinDLL 사용
+            Win32Transport는 wmca.dll을 로드하고 WmcaIntf.h 기준 시그니처를 설정합니다.
         """
-        try:
-            dll_abs_path = os.path.abspath(self.dll_path)
-            dll_dir = os.path.dirname(dll_abs_path)
-            os.environ["PATH"] = dll_dir + os.pathsep + os.environ.get("PATH", "")
-
-            self.dll = ctypes.WinDLL(dll_abs_path)
-            logger.debug(f"DLL 로드됨: {dll_abs_path}")
-        except OSError as e:
-            raise OSError(f"{self.dll_path} 로드 실패: {e}")
+        self.dll = self.transport.load_dll()
 
         try:
-            # ================================================================
-            # 1. 함수 포인터 획득
-            # ================================================================
             self.wmca_load = self.dll.wmcaLoad
             self.wmca_free = self.dll.wmcaFree
             self.wmca_set_server = self.dll.wmcaSetServer
@@ -182,110 +316,18 @@ class WMCAAgent:
             self.wmca_attach = self.dll.wmcaAttach
             self.wmca_detach = self.dll.wmcaDetach
             self.wmca_set_account_index_pwd = self.dll.wmcaSetAccountIndexPwd
-
-            # ================================================================
-            # 2. 함수 시그니처 설정 (WmcaIntf.h typedef 기준)
-            # ================================================================
-
-            # BOOL wmcaLoad()
-            self.wmca_load.argtypes = []
-            self.wmca_load.restype = ctypes.c_bool
-
-            # BOOL wmcaFree()
-            self.wmca_free.argtypes = []
-            self.wmca_free.restype = ctypes.c_bool
-
-            # BOOL wmcaSetServer(const char* szServer)
-            self.wmca_set_server.argtypes = [c_char_p]
-            self.wmca_set_server.restype = ctypes.c_bool
-
-            # BOOL wmcaSetPort(const int nPort)
-            self.wmca_set_port.argtypes = [c_int]
-            self.wmca_set_port.restype = ctypes.c_bool
-
-            # BOOL wmcaIsConnected()
-            self.wmca_is_connected.argtypes = []
-            self.wmca_is_connected.restype = ctypes.c_bool
-
-            # BOOL wmcaConnect(HWND hWnd, DWORD dwMsg, char cMediaType, char cUserType,
-            #                  const char* pszID, const char* pszPassword, const char* pszSignPassword)
-            self.wmca_connect.argtypes = [HWND, DWORD, c_char, c_char, c_char_p, c_char_p, c_char_p]
-            self.wmca_connect.restype = ctypes.c_bool
-
-            # BOOL wmcaDisconnect()
-            self.wmca_disconnect.argtypes = []
-            self.wmca_disconnect.restype = ctypes.c_bool
-
-            # BOOL wmcaQuery(HWND hWnd, int nTransactionID, const char* pszTrCode,
-            #                const char* pszInputData, int nInputDataSize, int nAccountIndex)
-            self.wmca_query.argtypes = [HWND, c_int, c_char_p, c_char_p, c_int, c_int]
-            self.wmca_query.restype = ctypes.c_bool
-
-            # BOOL wmcaAttach(HWND hWnd, const char* pszSiseName, const char* pszInputCode,
-            #                 int nInputCodeSize, int nInputCodeTotalSize)
-            self.wmca_attach.argtypes = [HWND, c_char_p, c_char_p, c_int, c_int]
-            self.wmca_attach.restype = ctypes.c_bool
-
-            # BOOL wmcaDetach(HWND hWnd, const char* pszSiseName, const char* pszInputCode,
-            #                 int nInputCodeSize, int nInputCodeTotalSize)
-            self.wmca_detach.argtypes = [HWND, c_char_p, c_char_p, c_int, c_int]
-            self.wmca_detach.restype = ctypes.c_bool
-
-            # BOOL wmcaSetAccountIndexPwd(const char* pszHashOut, int nAccountIndex, const char* pszPassword)
-            self.wmca_set_account_index_pwd.argtypes = [c_char_p, c_int, c_char_p]
-            self.wmca_set_account_index_pwd.restype = ctypes.c_bool
-
-            logger.debug("모든 DLL 함수 시그니처 설정 완료")
         except AttributeError as e:
             raise AttributeError(f"함수 포인터 설정 실패: {e}")
 
     # ========================================================================
-    # Windows 메시지 처리
+    # 이벤트 수신 (Transport)
     # ========================================================================
 
     def _create_message_window(self):
-        """메시지 수신용 숨김 윈도우 생성"""
-        # 윈도우 프로시저를 WNDPROC 타입으로 변환 (중요!)
-        self._wnd_proc_callback = WNDPROC(self._wnd_proc)
-
-        # 윈도우 클래스 등록 (인스턴스마다 고유한 이름 사용)
-        import time
-
-        self.wnd_class_name = f"WMCA_WINDOW_{id(self)}_{int(time.time() * 1000)}"
-
-        wc = win32gui.WNDCLASS()
-        wc.lpfnWndProc = self._wnd_proc_callback  # 변환된 콜백 사용
-        wc.lpszClassName = self.wnd_class_name
-        wc.hInstance = win32gui.GetModuleHandle(None)
-
-        try:
-            self.wnd_class_atom = win32gui.RegisterClass(wc)
-            logger.debug(
-                f"윈도우 클래스 등록 성공: name={self.wnd_class_name}, atom={self.wnd_class_atom}"
-            )
-        except Exception as e:
-            logger.error(f"윈도우 클래스 등록 실패: {e}")
-            raise
-
-        # 숨김 윈도우 생성
-        self.hwnd = win32gui.CreateWindow(
-            wc.lpszClassName, "WMCA Message Window", 0, 0, 0, 0, 0, 0, 0, wc.hInstance, None
-        )
-        logger.debug(f"CreateWindow 완료: hwnd={self.hwnd}")
-
-    def _wnd_proc(self, hwnd, msg, wparam, lparam):
-        """Windows 메시지 프로시저 (콜백)"""
-        # CA_WMCAEVENT 메시지만 처리 (샘플 코드 방식)
-        if msg == CA_WMCAEVENT:
-            try:
-                # WMCA 이벤트 처리로 위임
-                self._handle_wmca_event(wparam, lparam)
-            except Exception as e:
-                logger.error(f"메시지 처리 오류: {e}", exc_info=True)
-
-            return 0
-
-        return user32.DefWindowProcW(hwnd, msg, wparam, lparam)
+        """이벤트 수신 시작 (Win32Transport: 숨김 윈도우 생성, CA_WMCAEVENT → _handle_wmca_event)"""
+        self.transport.open(self._handle_wmca_event)
+        self._window_open = True
+        self._owner_thread = threading.get_ident()
 
     def _handle_wmca_event(self, wparam: int, lparam: int):
         """
@@ -297,43 +339,240 @@ class WMCAAgent:
 
         CRITICAL: lparam이 가리키는 메모리는 이 함수가 반환된 후 DLL이 해제합니다.
         따라서 lparam을 즉시 파싱해서 Python 객체로 변환한 후 큐에 저장해야 합니다.
+        decode="lazy"/"view"/"raw"에서는 OUTDATABLOCK의 원시 bytes만 복사합니다.
+        (LOGINBLOCK은 세션당 한 번이므로 항상 즉시 파싱)
+        latency=True면 큐에 (msg_type, data, t0, t1)을 적재합니다. (wmca_latency.py 참고)
         """
+        latency = self._latency
+        if latency is not None:
+            t0 = time.perf_counter_ns()
+
         # wparam을 WMCAMessage IntEnum으로 변환
         try:
             msg_type = WMCAMessage(wparam)
         except ValueError:
-            logger.warning(f"알 수 없는 메시지 타입: wparam={wparam}")
+            logger.warning("알 수 없는 메시지 타입: wparam=%s", wparam)
             return
 
-        logger.debug(
-            "CA_WMCAEVENT 수신: msg_type=%s (%s), lparam=%s", msg_type.name, msg_type.value, lparam
-        )
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug(
+                "CA_WMCAEVENT 수신: msg_type=%s (%s), lparam=%s", msg_type.name, msg_type.value, lparam
+            )
 
         # 메시지 타입에 따라 파싱 (WMCAMessageParser 사용)
         parsed_dto = None
 
         if msg_type == WMCAMessage.CA_DISCONNECTED:
             parsed_dto = None
+            if len(self.correlator):
+                self.correlator.fail_all(ConnectionError("연결이 끊어져 TR 응답을 받지 못했습니다"))
         elif msg_type == WMCAMessage.CA_CONNECTED:
             parsed_dto = WMCAMessageParser.parse_loginblock(lparam)
         elif msg_type == WMCAMessage.CA_RECEIVEMESSAGE:
-            parsed_dto = WMCAMessageParser.parse_outdatablock(lparam, is_receivemessage=True)
-        elif msg_type == WMCAMessage.CA_RECEIVEDATA or msg_type == WMCAMessage.CA_RECEIVECOMPLETE:
-            parsed_dto = WMCAMessageParser.parse_outdatablock(lparam)
+            parsed_dto = WMCAMessageParser.parse_outdatablock(
+                lparam, is_receivemessage=True, decode=self.decode, columnar=self.columnar,
+                typed=self.typed, envelope=self.envelope
+            )
+        elif (msg_type == WMCAMessage.CA_RECEIVEDATA or msg_type == WMCAMessage.CA_RECEIVECOMPLETE
+              or msg_type == WMCAMessage.CA_RECEIVEERROR):
+            parsed_dto = WMCAMessageParser.parse_outdatablock(
+                lparam, decode=self.decode, columnar=self.columnar, typed=self.typed, envelope=self.envelope
+            )
         elif msg_type == WMCAMessage.CA_RECEIVESISE:
-            parsed_dto = WMCAMessageParser.parse_outdatablock(lparam, is_receivesise=True)
+            if self.journal is not None:
+                self._journal_sise(msg_type, lparam)
+            # conflate: 파싱/큐 적재 없이 종목 슬롯에 덮어씀
+            if self.latest is not None and self.latest.update_from_lparam(lparam):
+                return
+            parsed_dto = WMCAMessageParser.parse_outdatablock(
+                lparam, is_receivesise=True, decode=self.decode, columnar=self.columnar,
+                typed=self.typed, envelope=self.envelope
+            )
         else:
             logger.warning("처리되지 않은 메시지 타입: %s", msg_type.name)
-            parsed_dto = WMCAMessageParser.parse_outdatablock(lparam)
+            parsed_dto = WMCAMessageParser.parse_outdatablock(
+                lparam, decode=self.decode, columnar=self.columnar, typed=self.typed, envelope=self.envelope
+            )
+
+        # submit_query()로 보낸 TR의 응답은 요청별 future로 전달 (큐에 넣지 않음)
+        if msg_type in _TR_RESPONSES and self.correlator.route(msg_type, parsed_dto):
+            return
 
         # 파싱된 데이터를 큐에 추가
-        self.message_queue.put((msg_type, parsed_dto))
+        if latency is None:
+            self.message_queue.put((msg_type, parsed_dto))
+        else:
+            t1 = time.perf_counter_ns()
+            self.message_queue.put((msg_type, parsed_dto, t0, t1))
+            latency.produced(msg_type, t0, t1)
+
+    def _journal_sise(self, msg_type: WMCAMessage, lparam: int):
+        """실시간 시세 원시 페이로드를 저널에 기록 (디코딩 전, 실패해도 이벤트 처리는 계속)"""
+        recv_ns = time.monotonic_ns()
+        try:
+            _, block_name, data = raw_from_lparam(lparam, is_receivesise=True)
+            self.journal.append(msg_type.value, block_name, data, recv_ns)
+        except Exception as e:
+            logger.error("저널 기록 실패: %s", e, exc_info=True)
 
     def _start_message_loop(self):
-        """메시지 윈도우 생성 (메인 스레드에서 실행)"""
-        if self.hwnd is None:
+        """메시지 윈도우 생성
+
+        - 기본 모드: 호출한 스레드에서 윈도우 생성 (receive_events()를 호출하는 스레드가 펌핑)
+        - threaded 모드: 전용 펌프 스레드를 시작하고 윈도우 생성이 끝날 때까지 대기
+        """
+        if self._window_open or self.message_thread is not None:
+            return
+        if self.latest is not None:
+            self.latest.open()
+
+        if not self.threaded:
             self._create_message_window()
-            logger.debug(f"메시지 윈도우 생성 완료: hwnd={self.hwnd}")
+            logger.debug("메시지 윈도우 생성 완료: hwnd=%s", self.hwnd)
+            return
+
+        if self.message_queue.closed:
+            # 이전 세션에서 닫힌 링 버퍼는 재사용하지 않음
+            self.message_queue = self._new_message_queue(self.message_queue.capacity)
+
+        self._pump_ready.clear()
+        self._pump_stop = False
+        self._pump_error = None
+        self.message_thread = threading.Thread(
+            target=self._pump_thread_main, name="wmca-pump", daemon=True
+        )
+        self.message_thread.start()
+        self._pump_ready.wait()
+
+        if self._pump_error is not None:
+            self.message_thread.join()
+            self.message_thread = None
+            raise RuntimeError(f"펌프 스레드 시작 실패: {self._pump_error}") from self._pump_error
+        logger.debug("펌프 스레드 시작 완료: hwnd=%s", self.hwnd)
+
+    def _pump_thread_main(self):
+        """threaded 모드 펌프 스레드 본체
+
+        윈도우 생성 → (메시지 대기 → 모두 처리) 반복 → 윈도우 파괴.
+        윈도우는 생성한 스레드에서만 메시지를 받고 파괴할 수 있으므로 모두 이 스레드에서 수행합니다.
+        """
+        try:
+            self._create_message_window()
+        except BaseException as e:
+            self._pump_error = e
+            self._pump_ready.set()
+            return
+        self._pump_ready.set()
+
+        try:
+            while not self._pump_stop:
+                self._dispatch_pending_messages()
+                if self._pump_stop or self.transport.exhausted:
+                    break
+                self._wait_for_messages(None)
+        except Exception as e:
+            logger.error("펌프 스레드 오류: %s", e, exc_info=True)
+        finally:
+            self._destroy_message_window()
+            self.message_queue.close()
+            if self.latest is not None:
+                self.latest.close()
+            logger.debug("펌프 스레드 종료")
+
+    def _stop_message_loop(self):
+        """threaded 모드 펌프 스레드 종료 (윈도우 파괴는 펌프 스레드에서 수행)"""
+        if self.message_thread is None:
+            return
+
+        self._pump_stop = True
+        # 큐가 가득 차 put()에서 대기 중인 펌프 스레드도 깨움 (닫힌 뒤 도착한 이벤트는 버림)
+        self.message_queue.close()
+        # 블로킹 대기 중인 펌프 스레드를 깨움
+        self.transport.wake()
+        self.message_thread.join()
+        self.message_thread = None
+
+    def _pump_finished(self) -> bool:
+        """더 이상 전달할 이벤트가 없는지 여부
+
+        - threaded 모드: 펌프 스레드가 종료되었고 링 버퍼도 비어 있음
+        - 기본 모드: transport가 소진되었고 (재생 종료) 큐도 비어 있음
+        """
+        if self.threaded:
+            return self.message_queue.closed and self.message_queue.empty()
+        return self.transport.exhausted and self.message_queue.empty()
+
+    @property
+    def handoff_stats(self) -> Optional[HandoffStats]:
+        """threaded 모드의 펌프 → 소비자 전달 지연/큐 깊이 통계 (기본 모드에서는 None)"""
+        return self.message_queue.stats if self.threaded else None
+
+    @property
+    def drop_stats(self) -> Optional[DropStats]:
+        """queue_capacity 초과로 버린 이벤트 통계 (queue_capacity=None이면 None)"""
+        return self.message_queue.drops if self.queue_capacity is not None else None
+
+    @property
+    def latency_stats(self) -> Optional[LatencyStats]:
+        """메시지 타입별 구간(decode/enqueue/handoff/total) 지연 히스토그램 (latency=False면 None)"""
+        return self._latency
+
+    @property
+    def queue_depth(self) -> int:
+        """소비자에게 아직 전달되지 않은 이벤트 수"""
+        return self.message_queue.qsize()
+
+    def _dispatch_pending_messages(self) -> int:
+        """transport에 쌓인 이벤트(Win32: Windows 메시지)를 모두 처리
+
+        Returns:
+            int: 처리한 메시지 수
+        """
+        count = self.transport.dispatch_pending()
+        self.pump_stats.dispatched += count
+        return count
+
+    def _wait_for_messages(self, timeout: Optional[float]) -> bool:
+        """이벤트가 도착할 때까지 블로킹 대기
+
+        Args:
+            timeout: 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            bool: 메시지 도착 여부 (False면 timeout)
+        """
+        arrived = self.transport.wait(timeout)
+        self.pump_stats.wakeups += 1
+        return arrived
+
+    def _pump_messages(self, timeout: Optional[float]) -> int:
+        """메시지 펌프 1회 수행
+
+        - "wait" 모드: 대기 중인 메시지를 먼저 모두 처리하고, 없으면 timeout까지 블로킹 대기 후
+          깨어나면 다시 모두 처리
+        - "poll" 모드: 메시지 1개만 처리 (이전 방식, 호출자가 10ms 대기)
+
+        Args:
+            timeout: 메시지가 없을 때 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            int: 처리한 메시지 수
+        """
+        if self.threaded:
+            # 펌프 스레드가 메시지를 처리하므로 링 버퍼에 이벤트가 들어올 때까지만 대기
+            self.message_queue.wait(timeout)
+            return 0
+
+        if self.pump_mode == "poll":
+            count = self.transport.dispatch_one()
+            self.pump_stats.dispatched += count
+            return count
+
+        count = self._dispatch_pending_messages()
+        if count == 0 and self.message_queue.empty():
+            if self._wait_for_messages(timeout):
+                count = self._dispatch_pending_messages()
+        return count
 
     def receive_events(
         self, timeout: Optional[float] = None
@@ -359,40 +598,143 @@ class WMCAAgent:
             ...     if msg_type == WMCAMessage.CA_RECEIVESISE:
             ...         print(f"실시간 시세 수신: {data}")
             ...     # break 없이 계속 수신
+            ...
+            >>> # 처리량 확인
+            >>> print(f"{agent.pump_stats.events_per_sec:.0f} events/s")
 
         Note:
             - Windows 메시지 펌핑을 자동으로 처리
             - timeout이 None이면 무한 루프 (사용자가 명시적으로 break 해야 함)
             - timeout 지정 시 시간 초과 시 StopIteration 발생
             - 각 메시지는 이미 파싱된 Python 객체로 반환됨
+            - pump_mode="wait"(기본값)에서는 메시지가 없으면 sleep 없이 블로킹 대기하고,
+              깨어날 때마다 대기 중인 메시지를 모두 처리한 뒤 큐를 비웁니다.
+            - 처리량은 agent.pump_stats (PumpStats)로 확인할 수 있습니다.
         """
-        import time
-
-        start_time = time.time()
+        deadline = None if timeout is None else time.monotonic() + timeout
+        stats = self.pump_stats
+        latency = self._latency
 
         while True:
             # timeout 체크 (timeout이 None이면 무한 루프)
-            if timeout is not None and time.time() - start_time >= timeout:
+            remaining = None if deadline is None else deadline - time.monotonic()
+            if remaining is not None and remaining <= 0:
                 logger.debug("receive_events: timeout 종료")
                 break
+            if self._pump_finished():
+                logger.debug("receive_events: 펌프 스레드 종료")
+                break
+
+            # Windows 메시지 펌핑 (DLL이 메시지를 보내면 transport가 _handle_wmca_event 호출)
+            self._pump_messages(remaining)
+
+            # 큐에서 파싱된 메시지 확인 (wait 모드에서는 큐가 빌 때까지 모두 전달)
+            while True:
+                try:
+                    item = self.message_queue.get_nowait()
+                except queue.Empty:
+                    break
+                if latency is not None:
+                    item = latency.handoff(item)
+                msg_type, parsed_data = item
+                if logger.isEnabledFor(logging.DEBUG):
+                    logger.debug(
+                        "receive_events: 메시지 수신 - type=%s, data=%s",
+                        msg_type.name, type(parsed_data).__name__
+                    )
+                stats.events += 1
+                yield (msg_type, parsed_data)
+                if self.pump_mode == "poll":
+                    break
+
+            if self.pump_mode == "poll":
+                time.sleep(0.01)  # 10ms 대기
 
-            # Windows 메시지 펌핑 (DLL이 메시지를 보내면 _wnd_proc 호출됨)
-            msg = MSG()
-            if user32.PeekMessageW(ctypes.byref(msg), None, 0, 0, 1):  # PM_REMOVE=1
-                user32.TranslateMessage(ctypes.byref(msg))
-                user32.DispatchMessageW(ctypes.byref(msg))
+    def _drain_queue(self, out: List[Tuple[WMCAMessage, Any]], limit: Optional[int]) -> int:
+        """message_queue에 쌓인 이벤트를 out 리스트로 옮김
 
-            # 큐에서 파싱된 메시지 확인
+        Args:
+            out: 이벤트를 추가할 리스트
+            limit: 최대 개수 (None이면 제한 없음)
+
+        Returns:
+            int: 옮긴 이벤트 수
+        """
+        get_nowait = self.message_queue.get_nowait
+        append = out.append
+        latency = self._latency
+        count = 0
+        while limit is None or count < limit:
             try:
-                msg_type, parsed_data = self.message_queue.get_nowait()
-                logger.debug(
-                    f"receive_events: 메시지 수신 - type={msg_type.name}, data={type(parsed_data).__name__}"
-                )
-                yield (msg_type, parsed_data)
+                item = get_nowait()
             except queue.Empty:
-                pass
+                break
+            append(item if latency is None else latency.handoff(item))
+            count += 1
+        self.pump_stats.events += count
+        return count
+
+    def receive_batch(
+        self,
+        max_events: Optional[int] = None,
+        timeout: Optional[float] = None,
+        window: Optional[float] = None,
+    ) -> List[Tuple[WMCAMessage, Any]]:
+        """
+        대기 중인 이벤트를 한 번에 리스트로 수신
+
+        receive_events()와 달리 이벤트마다 generator를 재개하지 않고,
+        큐에 쌓인 이벤트를 한 번에 꺼내 반환합니다.
+
+        Args:
+            max_events: 한 번에 반환할 최대 이벤트 수 (None이면 제한 없음)
+            timeout: 이벤트가 하나도 없을 때 최대 대기 시간 (초). None이면 이벤트가 올 때까지 대기.
+                0이면 대기하지 않고 현재 쌓인 이벤트만 반환
+            window: 지정 시 호출 시점부터 window초 동안 도착한 이벤트를 모아서 반환
+                (고정 주기 소비자용, 예: 0.001 = 1ms). max_events에 도달하면 즉시 반환
+
+        Returns:
+            List[Tuple[WMCAMessage, Any]]: (메시지 타입, 파싱된 데이터) 리스트.
+                timeout 또는 window 동안 이벤트가 없으면 빈 리스트
 
-            time.sleep(0.01)  # 10ms 대기
+        Example:
+            >>> # 쌓인 이벤트 모두 처리
+            >>> for msg_type, data in agent.receive_batch(timeout=1.0):
+            ...     handle(msg_type, data)
+            >>>
+            >>> # 1ms 주기로 모아서 처리
+            >>> while running:
+            ...     batch = agent.receive_batch(window=0.001)
+            ...     strategy.on_ticks(batch)
+        """
+        if max_events is not None and max_events <= 0:
+            raise ValueError(f"max_events는 1 이상이어야 합니다: {max_events}")
+
+        batch: List[Tuple[WMCAMessage, Any]] = []
+
+        if window is not None:
+            # window 동안 도착한 이벤트를 모두 수집
+            deadline = time.monotonic() + window
+            while True:
+                remaining = deadline - time.monotonic()
+                self._pump_messages(max(remaining, 0.0))
+                limit = None if max_events is None else max_events - len(batch)
+                self._drain_queue(batch, limit)
+                if (max_events is not None and len(batch) >= max_events) or remaining <= 0:
+                    return batch
+                if self.pump_mode == "poll":
+                    time.sleep(min(0.01, remaining))  # 최대 10ms 대기
+
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while True:
+            remaining = None if deadline is None else max(deadline - time.monotonic(), 0.0)
+            self._pump_messages(remaining)
+            if self._drain_queue(batch, max_events) or (remaining is not None and remaining <= 0):
+                return batch
+            if self._pump_finished():
+                return batch
+            if self.pump_mode == "poll":
+                time.sleep(0.01)  # 10ms 대기
 
     # ========================================================================
     # DLL 함수 호출 (저수준)
@@ -443,7 +785,7 @@ class WMCAAgent:
                 "Agent가 초기화되지 않았습니다. with 문으로 사용하거나 initialize()를 먼저 호출하세요."
             )
 
-        logger.info(f"로그인 요청 전송: ID={szID}, MediaType={MediaType}, UserType={UserType}")
+        logger.info("로그인 요청 전송: ID=%s, MediaType=%s, UserType=%s", szID, MediaType, UserType)
 
         # 서버 연결 호출 (요청만 전송)
         id_bytes = szID.encode("utf-8")
@@ -551,10 +893,10 @@ class WMCAAgent:
             - CA_RECEIVEDATA: TR 블록 데이터 (여러 개 가능)
             - CA_RECEIVECOMPLETE: 모든 블록 수신 완료
             - CA_RECEIVEERROR: TR 처리 실패
-            - WMCAClient.query()는 이 함수와 receive_events()를 조합하여 사용
+            - submit_query()는 TrIndex 할당과 응답 모으기까지 처리하여 QueryFuture를 반환
 
         Example:
-            >>> # 저수준 사용 (권장하지 않음)
+            >>> # 저수준 사용 (응답을 직접 골라냄)
             >>> tr_index = agent.get_next_tr_index()
             >>> agent.query(tr_index, "c8201", input_data, nAccountIndex=1)
             >>> for msg_type, data in agent.receive_events():
@@ -562,12 +904,11 @@ class WMCAAgent:
             ...         if msg_type == WMCAMessage.CA_RECEIVECOMPLETE:
             ...             break
             >>>
-            >>> # 고수준 사용 (권장)
-            >>> client = WMCAClient()
-            >>> blocks = client.query(...)  # 내부적으로 receive_events 사용
+            >>> # future 사용 (권장, TrIndex 자동 할당)
+            >>> result = agent.submit_query("c8201", input_data, nAccountIndex=1).result(timeout=5.0)
         """
         logger.info(
-            f"TR 조회 요청 전송: TrCode={szTRCode}, TrIndex={nTRID}, AccountIndex={nAccountIndex}"
+            "TR 조회 요청 전송: TrCode=%s, TrIndex=%s, AccountIndex=%s", szTRCode, nTRID, nAccountIndex
         )
 
         # InputBlock을 C 구조체로 변환
@@ -576,7 +917,7 @@ class WMCAAgent:
         tr_code_bytes = szTRCode.encode("utf-8")
 
         # wmcaQuery 호출 (요청만 전송)
-        logger.debug(f"wmcaQuery() 호출 - hwnd={self.hwnd}, TrIndex={nTRID}, TrCode={szTRCode}")
+        logger.debug("wmcaQuery() 호출 - hwnd=%s, TrIndex=%s, TrCode=%s", self.hwnd, nTRID, szTRCode)
         result = self.wmca_query(
             self.hwnd, nTRID, tr_code_bytes, input_bytes, len(input_bytes), nAccountIndex
         )
@@ -585,9 +926,66 @@ class WMCAAgent:
             logger.error("wmcaQuery() 호출 실패")
             raise RuntimeError("TR 조회 함수 호출 실패")
 
-        logger.debug(f"TR 조회 요청 완료 - TrIndex={nTRID}")
+        logger.debug("TR 조회 요청 완료 - TrIndex=%s", nTRID)
         return bool(result)
 
+    def get_next_tr_index(self) -> int:
+        """대기 중인 submit_query()와 겹치지 않는 다음 TrIndex (query()를 직접 호출할 때 사용)"""
+        return self.correlator.allocate()
+
+    def submit_query(self, szTRCode: str, szInput: InBlock, nAccountIndex: int = 0) -> QueryFuture:
+        """
+        TrIndex를 자동 할당하여 TR 조회 요청을 보내고 결과 future 반환
+
+        같은 TrIndex의 CA_RECEIVEMESSAGE/CA_RECEIVEDATA/CA_RECEIVECOMPLETE/CA_RECEIVEERROR는
+        receive_events()/receive_batch()로 전달되지 않고 future의 QueryResult로 모입니다.
+
+        Args:
+            szTRCode: 서비스 코드 (5자리, 예: "c1101", "c8201")
+            szInput: TR 입력 데이터 (InBlock 기반 Pydantic 모델)
+            nAccountIndex: 계좌 인덱스 (0: 계좌번호 불필요, 1~: 로그인 시 받은 계좌 순서)
+
+        Returns:
+            QueryFuture: result()는 QueryResult (블록명 → szData), CA_RECEIVEERROR면 QueryError,
+                연결이 끊어지면 ConnectionError
+
+        Raises:
+            RuntimeError: wmcaQuery 호출 실패
+
+        Example:
+            >>> futures = {code: agent.submit_query("c1101", Tc1101InBlock(...)) for code in codes}
+            >>> for code, future in futures.items():
+            ...     print(code, future.result(timeout=5.0)["c1101OutBlock"])
+
+        Note:
+            - 기본 모드(threaded=False)에서는 윈도우를 만든 스레드가 result()를 호출하면
+              응답이 올 때까지 메시지 펌프를 직접 돌립니다.
+            - future.cancel()하면 늦게 도착한 응답은 버려집니다.
+        """
+        pump = None if self.threaded else self._pump_until_done
+        future = self.correlator.register(szTRCode, pump)
+        try:
+            self.query(future.tr_index, szTRCode, szInput, nAccountIndex)
+        except BaseException:
+            self.correlator.discard(future.tr_index)
+            raise
+        return future
+
+    def _pump_until_done(self, future: QueryFuture, timeout: Optional[float]):
+        """기본 모드에서 future가 완료될 때까지 메시지 펌프 (윈도우를 만든 스레드에서만)"""
+        if threading.get_ident() != self._owner_thread:
+            return  # 다른 스레드는 윈도우 소유 스레드의 펌프를 기다림
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while not future.done():
+            remaining = None if deadline is None else deadline - time.monotonic()
+            if remaining is not None and remaining <= 0:
+                return
+            if self._dispatch_pending_messages():
+                continue
+            if self.transport.exhausted:
+                return
+            self._wait_for_messages(remaining)
+
     def attach(self, szBCType: str, szInput: str, nCodeLen: int, nInputLen: int) -> bool:
         """
         실시간 시세 등록 (wmcaAttach)
@@ -642,7 +1040,7 @@ class WMCAAgent:
         """
 
         logger.debug(
-            f"실시간 시세 등록: BC={szBCType}, Input={szInput}, CodeLen={nCodeLen}, InputLen={nInputLen}"
+            "실시간 시세 등록: BC=%s, Input=%s, CodeLen=%s, InputLen=%s", szBCType, szInput, nCodeLen, nInputLen
         )
 
         # 입력값을 cp949로 인코딩
@@ -650,13 +1048,13 @@ class WMCAAgent:
         input_bytes = szInput.encode("cp949")
 
         # wmcaAttach 호출
-        logger.debug(f"wmcaAttach() 호출 - hwnd={self.hwnd}, BC={szBCType}")
+        logger.debug("wmcaAttach() 호출 - hwnd=%s, BC=%s", self.hwnd, szBCType)
         result = self.wmca_attach(self.hwnd, bc_type_bytes, input_bytes, nCodeLen, nInputLen)
 
         if result:
-            logger.info(f"실시간 시세 등록 성공: {szBCType} - {szInput}")
+            logger.info("실시간 시세 등록 성공: %s - %s", szBCType, szInput)
         else:
-            logger.error(f"실시간 시세 등록 실패: {szBCType} - {szInput}")
+            logger.error("실시간 시세 등록 실패: %s - %s", szBCType, szInput)
 
         return bool(result)
 
@@ -692,20 +1090,20 @@ class WMCAAgent:
             - SDK.pdf 페이지 8: wmcaDetach() 함수
         """
 
-        logger.info(f"실시간 시세 해제: BC={szBCType}, Input={szInput}")
+        logger.info("실시간 시세 해제: BC=%s, Input=%s", szBCType, szInput)
 
         # 입력값을 cp949로 인코딩
         bc_type_bytes = szBCType.encode("cp949")
         input_bytes = szInput.encode("cp949")
 
         # wmcaDetach 호출
-        logger.debug(f"wmcaDetach() 호출 - hwnd={self.hwnd}, BC={szBCType}")
+        logger.debug("wmcaDetach() 호출 - hwnd=%s, BC=%s", self.hwnd, szBCType)
         result = self.wmca_detach(self.hwnd, bc_type_bytes, input_bytes, nCodeLen, nInputLen)
 
         if result:
-            logger.info(f"실시간 시세 해제 성공: {szBCType} - {szInput}")
+            logger.info("실시간 시세 해제 성공: %s - %s", szBCType, szInput)
         else:
-            logger.error(f"실시간 시세 해제 실패: {szBCType} - {szInput}")
+            logger.error("실시간 시세 해제 실패: %s - %s", szBCType, szInput)
 
         return bool(result)
 
@@ -729,7 +1127,7 @@ class WMCAAgent:
 
         # Windows 메시지 윈도우 생성
         self._start_message_loop()
-        logger.debug(f"메시지 윈도우 생성 완료: hwnd={self.hwnd}")
+        logger.debug("메시지 윈도우 생성 완료: hwnd=%s", self.hwnd)
 
         logger.info("WMCA Agent 초기화 완료")
         self.initialized = True
@@ -752,29 +1150,30 @@ class WMCAAgent:
                 self.wmca_free()
                 logger.debug("WMCA 모듈 해제 완료")
             except Exception as e:
-                logger.error(f"WMCA 모듈 해제 중 오류: {e}")
+                logger.error("WMCA 모듈 해제 중 오류: %s", e)
 
-        # 3. 윈도우 파괴
-        if self.hwnd is not None:
-            try:
-                win32gui.DestroyWindow(self.hwnd)
-                logger.debug(f"윈도우 파괴 완료: hwnd={self.hwnd}")
-                self.hwnd = None
-            except Exception as e:
-                logger.error(f"윈도우 파괴 중 오류: {e}")
+        # 3. 윈도우 파괴 및 클래스 등록 해제 (threaded 모드에서는 펌프 스레드가 수행)
+        if self.threaded:
+            self._stop_message_loop()
+        else:
+            self._destroy_message_window()
+        if self.latest is not None:
+            self.latest.close()
 
-        # 4. 윈도우 클래스 등록 해제
-        if self.wnd_class_atom is not None:
-            try:
-                user32.UnregisterClassW(self.wnd_class_atom, win32gui.GetModuleHandle(None))
-                logger.debug(f"윈도우 클래스 등록 해제 완료: atom={self.wnd_class_atom}")
-                self.wnd_class_atom = None
-            except Exception as e:
-                logger.error(f"윈도우 클래스 등록 해제 중 오류: {e}")
+        # 4. 에이전트가 생성한 저널 닫기 (더 이상 이벤트가 오지 않은 뒤)
+        if self._owns_journal and self.journal is not None:
+            self.journal.close()
+            logger.info("저널 닫음: %s (records=%d)", self.journal.path, self.journal.records)
 
         self.initialized = False
         logger.info("WMCA Agent 리소스 정리 완료")
 
+    def _destroy_message_window(self):
+        """이벤트 수신 종료 (Win32Transport: 윈도우 파괴 및 클래스 등록 해제, 윈도우를 생성한 스레드에서 호출)"""
+        if self._window_open:
+            self.transport.close()
+            self._window_open = False
+
     def __enter__(self):
         """
         컨텍스트 매니저 진입
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+AsyncWMCAAgent - WMCAAgent의 asyncio 인터페이스
+
+WMCAAgent(threaded=True)를 감쌉니다. 전용 펌프 스레드가 윈도우 메시지를 블로킹 대기
+(MsgWaitForMultipleObjectsEx)로 처리하고, 이벤트를 링 버퍼에 넣을 때 대기 중인 이벤트 루프를
+loop.call_soon_threadsafe()로 한 번 깨웁니다. 이벤트 루프는 자기 wakeup 핸들(self-pipe/IOCP)만
+기다리므로 sleep 루프나 폴링이 없습니다.
+
+Example:
+    >>> async def main():
+    ...     async with AsyncWMCAAgent() as agent:
+    ...         agent.connect("id", "pw", "cert_pw")
+    ...         async for msg_type, data in agent.events(timeout=10.0):
+    ...             if msg_type == WMCAMessage.CA_CONNECTED:
+    ...                 break
+    ...         result = await agent.query_async("c8201", inblock, nAccountIndex=1, timeout=5.0)
+    ...         print(result["c8201OutBlock"].dpsit_amtz16)
+    >>> asyncio.run(main())
+
+Note:
+    - events()/receive_batch_async()는 한 코루틴에서만 호출하세요. (링 버퍼는 단일 소비자)
+    - query_async()가 취소되거나 timeout이 나면 해당 TrIndex도 취소되어 늦은 응답은 버려집니다.
+    - connect()/attach() 등 나머지 메서드는 WMCAAgent 것을 그대로 사용합니다. (요청만 보내고 바로 반환)
+"""
+
+import asyncio
+import time
+from typing import Any, AsyncIterator, List, Optional, Tuple
+
+from .wmca_agent import WMCAAgent, WMCAMessage
+from .wmca_correlator import QueryResult
+from .structures.common import InBlock
+
+
+class AsyncWMCAAgent:
+    """asyncio용 WMCAAgent 래퍼
+
+    Args:
+        agent: 감쌀 WMCAAgent (threaded=True여야 함). None이면 **kwargs로 새로 생성
+        **kwargs: WMCAAgent 생성 인자 (threaded는 항상 True)
+
+    Attributes:
+        agent: 내부 WMCAAgent
+    """
+
+    def __init__(self, agent: Optional[WMCAAgent] = None, **kwargs):
+        if agent is None:
+            if kwargs.get("threaded") is False:
+                raise ValueError("AsyncWMCAAgent는 threaded=True WMCAAgent만 지원합니다")
+            kwargs["threaded"] = True
+            agent = WMCAAgent(**kwargs)
+        elif kwargs:
+            raise TypeError("agent를 지정하면 WMCAAgent 생성 인자를 함께 줄 수 없습니다")
+        elif not agent.threaded:
+            raise ValueError("AsyncWMCAAgent는 threaded=True WMCAAgent만 지원합니다")
+        self.agent = agent
+
+    def __getattr__(self, name: str) -> Any:
+        # connect/disconnect/attach/detach/query/pump_stats 등은 WMCAAgent에 위임
+        return getattr(self.agent, name)
+
+    # ========================================================================
+    # 컨텍스트 매니저
+    # ========================================================================
+
+    async def __aenter__(self) -> "AsyncWMCAAgent":
+        self.agent.__enter__()
+        return self
+
+    async def __aexit__(self, exc_type, exc_value, traceback):
+        # 로그아웃/펌프 스레드 join/DLL 해제는 블로킹이므로 이벤트 루프를 막지 않도록 executor에서 수행
+        loop = asyncio.get_running_loop()
+        await loop.run_in_executor(None, self.agent.__exit__, exc_type, exc_value, traceback)
+        return False
+
+    # ========================================================================
+    # TR 조회
+    # ========================================================================
+
+    async def query_async(
+        self,
+        szTRCode: str,
+        szInput: InBlock,
+        nAccountIndex: int = 0,
+        timeout: Optional[float] = None,
+    ) -> QueryResult:
+        """
+        TR 조회 요청을 보내고 CA_RECEIVECOMPLETE까지 기다림 (TrIndex 자동 할당)
+
+        Args:
+            szTRCode: 서비스 코드 (5자리, 예: "c1101", "c8201")
+            szInput: TR 입력 데이터 (InBlock 기반 Pydantic 모델)
+            nAccountIndex: 계좌 인덱스 (0: 계좌번호 불필요, 1~: 로그인 시 받은 계좌 순서)
+            timeout: 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            QueryResult: 블록명 → szData
+
+        Raises:
+            QueryError: CA_RECEIVEERROR
+            ConnectionError: 응답 전에 연결이 끊어짐
+            asyncio.TimeoutError: timeout 초과 (TrIndex는 취소됨)
+            RuntimeError: wmcaQuery 호출 실패
+        """
+        future = self.agent.submit_query(szTRCode, szInput, nAccountIndex)
+        try:
+            return await asyncio.wait_for(asyncio.wrap_future(future), timeout)
+        except BaseException:
+            # 취소/timeout이면 correlator에서 TrIndex를 빼서 늦은 응답을 버림
+            future.cancel()
+            raise
+
+    # ========================================================================
+    # 이벤트 수신
+    # ========================================================================
+
+    async def receive_batch_async(
+        self, max_events: Optional[int] = None, timeout: Optional[float] = None
+    ) -> List[Tuple[WMCAMessage, Any]]:
+        """
+        receive_batch()의 asyncio 버전
+
+        Args:
+            max_events: 한 번에 반환할 최대 이벤트 수 (None이면 제한 없음)
+            timeout: 이벤트가 하나도 없을 때 최대 대기 시간 (초). None이면 이벤트가 올 때까지 대기
+
+        Returns:
+            List[Tuple[WMCAMessage, Any]]: 이벤트 리스트 (timeout 또는 펌프 종료 시 빈 리스트)
+        """
+        agent = self.agent
+        batch = agent.receive_batch(max_events=max_events, timeout=0)
+        if batch or agent._pump_finished():
+            return batch
+        if await agent.message_queue.wait_async(timeout):
+            return agent.receive_batch(max_events=max_events, timeout=0)
+        return batch
+
+    async def events(self, timeout: Optional[float] = None) -> AsyncIterator[Tuple[WMCAMessage, Any]]:
+        """
+        receive_events()의 asyncio 버전 (async for)
+
+        Args:
+            timeout: 최대 대기 시간 (초). None이면 무한 대기 (펌프가 끝나면 종료)
+
+        Yields:
+            Tuple[WMCAMessage, Any]: (메시지 타입, 파싱된 데이터)
+        """
+        agent = self.agent
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while True:
+            for event in agent.receive_batch(timeout=0):
+                yield event
+            if agent._pump_finished():
+                return
+            remaining = None if deadline is None else deadline - time.monotonic()
+            if remaining is not None and remaining <= 0:
+                return
+            await agent.message_queue.wait_async(remaining)
+
+
+__all__ = [
+    "AsyncWMCAAgent",
+]
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryCache - TR 응답 캐시 (TR 코드별 TTL + 진행 중 요청 합치기)
+
+여러 컴포넌트가 같은 c8201 잔고나 같은 기준 정보 TR을 몇 ms 간격으로 요청하면 매번 wmcaQuery
+왕복과 TR 한도를 씁니다. QueryCache는 (TR 코드, 계좌 인덱스, 인코딩된 InBlock bytes)를 키로
+
+    - TTL 안에 받은 결과가 있으면 wmcaQuery 없이 바로 반환 (hit)
+    - 같은 키의 요청이 이미 진행 중이면 그 TrIndex의 결과를 함께 받음 (coalesce)
+    - 둘 다 아니면 submit_query()(또는 QueryScheduler.submit())로 전송 (miss)
+
+Example:
+    >>> cache = QueryCache(agent, ttl={"c8201": 1.0, "c1101": 0.5})
+    >>> a = cache.submit("c8201", balance_input, 1)
+    >>> b = cache.submit("c8201", balance_input, 1)     # a와 같은 TrIndex 결과를 공유 (coalesce)
+    >>> a.result(timeout=5.0) is b.result(timeout=5.0)
+    True
+    >>> cache.invalidate("c8201")                       # 주문 체결 후 잔고 캐시 무효화
+    >>> print(cache.stats)
+
+Note:
+    - 캐시된 QueryResult 객체는 요청자 사이에서 공유되므로 수정하지 마세요.
+    - 실패(QueryError, ConnectionError 등)한 결과는 캐시하지 않습니다.
+    - TTL이 없는 TR 코드도 진행 중 요청 합치기는 적용됩니다.
+    - 반환한 future를 cancel()해도 진행 중인 요청은 취소하지 않습니다. (다른 요청자와 캐시를 위해 완료까지 받음)
+"""
+
+import ctypes
+import threading
+import time
+from collections import OrderedDict
+from concurrent.futures import Future
+from dataclasses import dataclass
+from typing import Callable, Dict, Optional, Tuple
+
+from .wmca_correlator import QueryFuture, QueryResult, forward_future
+from .structures.common import InBlock
+
+# (TR 코드, 계좌 인덱스, InBlock bytes)
+CacheKey = Tuple[str, int, bytes]
+
+
+@dataclass
+class CacheStats:
+    """QueryCache 통계
+
+    Attributes:
+        hits: TTL 안의 결과를 바로 반환한 횟수
+        misses: 실제로 전송한 횟수
+        coalesced: 진행 중인 같은 요청에 합친 횟수
+        evictions: max_entries를 넘어 오래된 항목을 버린 횟수
+    """
+    hits: int = 0
+    misses: int = 0
+    coalesced: int = 0
+    evictions: int = 0
+
+    @property
+    def hit_ratio(self) -> float:
+        """wmcaQuery 없이 처리한 비율 ((hits + coalesced) / 전체)"""
+        total = self.hits + self.misses + self.coalesced
+        return (self.hits + self.coalesced) / total if total else 0.0
+
+
+def encode_inblock(szInput: InBlock) -> bytes:
+    """InBlock을 wmcaQuery에 넘기는 bytes로 인코딩 (WMCAAgent.query()와 동일)"""
+    c_struct = szInput.to_c_struct()
+    return ctypes.string_at(ctypes.addressof(c_struct), ctypes.sizeof(c_struct))
+
+
+class CachedQuery(QueryFuture):
+    """QueryCache.submit()이 반환하는 요청자별 future
+
+    tr_index는 공유하는 요청(inner)에서 읽으므로, scheduler=로 보내 아직 전송 전이면 None이고
+    전송된 뒤에는 할당된 TrIndex입니다.
+
+    Attributes:
+        source: "hit", "coalesced", "miss" 중 하나
+    """
+
+    def __init__(self, tr_code: str, source: str, pump=None, result: Optional[QueryResult] = None,
+                 inner: Optional[Future] = None):
+        self._inner = inner
+        super().__init__(result.tr_index if result is not None else None, tr_code, pump)
+        self.source = source
+
+    @property
+    def tr_index(self) -> Optional[int]:
+        inner = self._inner
+        return self._tr_index if inner is None else inner.tr_index
+
+    @tr_index.setter
+    def tr_index(self, value: Optional[int]) -> None:
+        self._tr_index = value
+
+
+class QueryCache:
+    """TR 응답 캐시
+
+    Args:
+        agent: WMCAAgent
+        ttl: TR 코드별 캐시 유지 시간 (초)
+        default_ttl: ttl에 없는 TR 코드의 유지 시간 (None이면 캐시하지 않고 합치기만)
+        scheduler: 지정하면 agent.submit_query() 대신 scheduler.submit()으로 전송
+        max_entries: 최대 캐시 항목 수 (넘으면 가장 오래 사용하지 않은 항목부터 버림)
+    """
+
+    def __init__(
+        self,
+        agent,
+        ttl: Optional[Dict[str, float]] = None,
+        default_ttl: Optional[float] = None,
+        scheduler=None,
+        max_entries: int = 1024,
+    ):
+        if max_entries <= 0:
+            raise ValueError(f"max_entries는 1 이상이어야 합니다: {max_entries}")
+        self.agent = agent
+        self.ttl = dict(ttl or {})
+        self.default_ttl = default_ttl
+        self.max_entries = max_entries
+        self._send: Callable[[str, InBlock, int], QueryFuture] = (
+            scheduler.submit if scheduler is not None else agent.submit_query
+        )
+        self.stats = CacheStats()
+
+        self._lock = threading.Lock()
+        self._entries: "OrderedDict[CacheKey, Tuple[QueryResult, float]]" = OrderedDict()  # 키 → (결과, 만료 시각)
+        self._inflight: Dict[CacheKey, QueryFuture] = {}
+
+    def __len__(self) -> int:
+        """캐시 항목 수 (만료된 항목 포함)"""
+        return len(self._entries)
+
+    # ========================================================================
+    # 요청
+    # ========================================================================
+
+    def submit(self, szTRCode: str, szInput: InBlock, nAccountIndex: int = 0) -> CachedQuery:
+        """
+        캐시를 거쳐 TR 조회 (submit_query()와 같은 인자/반환값)
+
+        Returns:
+            CachedQuery: source 속성이 "hit", "coalesced", "miss" 중 하나
+        """
+        key = (szTRCode, nAccountIndex, encode_inblock(szInput))
+        now = time.monotonic()
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is not None:
+                if entry[1] > now:
+                    self._entries.move_to_end(key)
+                    self.stats.hits += 1
+                    return self._wrap(key, "hit", result=entry[0])
+                del self._entries[key]
+
+            inflight = self._inflight.get(key)
+            if inflight is not None:
+                self.stats.coalesced += 1
+                return self._wrap(key, "coalesced", inner=inflight)
+            self.stats.misses += 1
+            # 같은 키를 두 번 보내지 않도록 잠근 채 전송 (wmcaQuery/스케줄러 큐 적재는 바로 반환)
+            inner = self._send(szTRCode, szInput, nAccountIndex)
+            self._inflight[key] = inner
+
+        inner.add_done_callback(lambda done: self._on_complete(key, done))
+        return self._wrap(key, "miss", inner=inner)
+
+    def _wrap(self, key: CacheKey, source: str, result: Optional[QueryResult] = None,
+              inner: Optional[Future] = None) -> CachedQuery:
+        """요청자별 future (취소해도 공유 요청에는 영향 없음)"""
+        pump = None if self.agent.threaded else self.agent._pump_until_done
+        future = CachedQuery(key[0], source, pump, result=result, inner=inner)
+        if result is not None:
+            future.set_result(result)
+        else:
+            inner.add_done_callback(lambda done: forward_future(done, future))
+        return future
+
+    def _on_complete(self, key: CacheKey, inner: Future):
+        ttl = self.ttl.get(key[0], self.default_ttl)
+        with self._lock:
+            if self._inflight.get(key) is not inner:
+                return  # invalidate()된 요청: 결과를 캐시하지 않음
+            del self._inflight[key]
+            if inner.cancelled() or inner.exception() is not None or not ttl:
+                return
+            self._entries[key] = (inner.result(), time.monotonic() + ttl)
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+                self.stats.evictions += 1
+
+    # ========================================================================
+    # 무효화
+    # ========================================================================
+
+    def invalidate(self, tr_code: Optional[str] = None, nAccountIndex: Optional[int] = None) -> int:
+        """캐시 항목 삭제
+
+        진행 중인 같은 키의 요청은 결과를 받아도 캐시하지 않고, 이후 요청은 새로 전송합니다.
+        (주문 체결 직전에 보낸 잔고 조회가 체결 후 캐시에 남지 않도록)
+
+        Args:
+            tr_code: 지정하면 해당 TR 코드만 (None이면 전체)
+            nAccountIndex: 지정하면 해당 계좌만
+
+        Returns:
+            int: 삭제한 항목 수
+        """
+        def matches(key: CacheKey) -> bool:
+            return (tr_code is None or key[0] == tr_code) and (nAccountIndex is None or key[1] == nAccountIndex)
+
+        with self._lock:
+            keys = [key for key in self._entries if matches(key)]
+            for key in keys:
+                del self._entries[key]
+            for key in [key for key in self._inflight if matches(key)]:
+                del self._inflight[key]
+        return len(keys)
+
+    def clear(self) -> None:
+        """캐시 전체 삭제"""
+        self.invalidate()
+
+
+__all__ = [
+    "QueryCache",
+    "CachedQuery",
+    "CacheStats",
+    "CacheKey",
+    "encode_inblock",
+]
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+LatestValueStore - 실시간 시세 최신값 저장소 (종목별 덮어쓰기)
+
+현재가만 필요한 소비자에게 j8 틱을 모두 전달하면, 소비자가 느릴 때 message_queue에 지난 틱이
+끝없이 쌓이고 메모리와 지연이 함께 늘어납니다. WMCAAgent(conflate=...)로 생성하면
+CA_RECEIVESISE를 파싱하거나 큐에 넣지 않고, 미리 할당한 종목별 슬롯에 원시 레코드를 그대로
+덮어씁니다. (윈도우 프로시저에서 memmove 1회)
+
+    - 슬롯: 실시간 코드마다 capacity개 × 레코드 크기의 bytearray를 처음 수신할 때 한 번 할당
+    - 읽기: 읽는 시점에 슬롯을 복사해 디코딩 (쓰지 않는 중간 틱은 디코딩 비용도 없음)
+    - 변경 추적: SiseCursor마다 마지막으로 읽은 뒤 바뀐 종목 집합 (종목 수 이하로 고정)
+
+틱이 얼마나 몰려도 메모리는 (종목 수 × 레코드 크기)를 넘지 않습니다.
+
+Example:
+    >>> with WMCAAgent(threaded=True, conflate=("j8",)) as agent:
+    ...     ...
+    ...     agent.attach("j8", "005930000660", 6, 12)
+    ...     cursor = agent.latest.cursor()
+    ...     while running:
+    ...         for (bc, code), tick in cursor.changed(timeout=1.0).items():   # 바뀐 종목만
+    ...             print(code, tick.price)
+    ...     print(agent.latest.get("j8", "005930").price)                       # 특정 종목 최신값
+
+Note:
+    - 기본 모드(threaded=False)에서는 receive_events()/receive_batch()가 메시지를 펌핑하는 동안만
+      슬롯이 갱신됩니다. 다른 스레드에서 읽으려면 threaded=True를 사용하세요.
+    - 반복 블록이거나 등록되지 않은 실시간 코드, capacity를 넘는 종목의 틱은 기존처럼 큐로 전달합니다.
+      등록되지 않았던 실시간 코드도 register_block()하면 그때부터 저장하고, 다시 등록하면 슬롯을 새로 할당합니다.
+    - 슬롯에 저장한 틱은 latency_stats에 기록하지 않습니다. (큐를 거치지 않음)
+"""
+
+import ctypes
+import threading
+from ctypes import POINTER
+from dataclasses import dataclass
+from typing import Dict, Iterable, List, Optional, Set, Tuple
+
+from .wmca_logger import logger
+from .structures.common import COutDataBlock, OutBlock
+from .structures.decoder import BlockDecoder
+from .structures.parser_info import BlockInfo, lookup_block
+
+# (실시간 코드, 종목코드)
+SiseKey = Tuple[str, str]
+
+# szData 앞 3바이트 (실시간 코드 2자리 + 구분자)
+_SISE_PREFIX = 3
+
+
+@dataclass
+class ConflationStats:
+    """LatestValueStore 통계
+
+    Attributes:
+        updates: 슬롯에 덮어쓴 틱 수
+        overflow: capacity를 넘어 큐로 전달한 틱 수
+    """
+    updates: int = 0
+    overflow: int = 0
+
+
+class _Table:
+    """실시간 코드 하나의 종목 슬롯 (레코드 크기 × capacity 연속 버퍼)"""
+
+    __slots__ = ("info", "bc_type", "size", "code_width", "decoder", "buf", "view", "_c_buf", "base", "slots", "index", "keys")
+
+    def __init__(self, info: BlockInfo, code_width: int, decoder: BlockDecoder, capacity: int):
+        self.info = info                        # 할당 당시 등록 정보 (재등록 감지)
+        self.bc_type = info.name
+        self.size = size = info.size
+        self.code_width = code_width
+        self.decoder = decoder
+        self.buf = bytearray(size * capacity)
+        self.view = memoryview(self.buf)
+        self._c_buf = (ctypes.c_char * len(self.buf)).from_buffer(self.buf)
+        self.base = ctypes.addressof(self._c_buf)
+        self.slots: Dict[bytes, int] = {}       # 종목코드 bytes → 슬롯 번호 (쓰기용)
+        self.index: Dict[str, int] = {}         # 종목코드 → 슬롯 번호 (읽기용)
+        self.keys: List[SiseKey] = []            # 슬롯 번호 → (실시간 코드, 종목코드)
+
+
+class LatestValueStore:
+    """실시간 시세 종목별 최신값 저장소 (WMCAAgent.latest)
+
+    Args:
+        bc_types: 슬롯에 저장할 실시간 코드 (None이면 등록된 모든 단일 레코드 실시간 블록)
+        capacity: 실시간 코드별 최대 종목 수
+        typed: 읽을 때 OutBlock 어노테이션에 따라 변환 (WMCAAgent typed와 동일)
+    """
+
+    def __init__(self, bc_types: Optional[Iterable[str]] = None, capacity: int = 4096, typed: bool = True):
+        if capacity <= 0:
+            raise ValueError(f"capacity는 1 이상이어야 합니다: {capacity}")
+        self.capacity = capacity
+        self.typed = typed
+        self.stats = ConflationStats()
+        self._bc_types = None if bc_types is None else frozenset(bc.encode("cp949") for bc in bc_types)
+        self._tables: Dict[bytes, Optional[_Table]] = {}    # 실시간 코드 bytes → 슬롯 (None: 저장 대상 아님)
+        self._by_name: Dict[str, _Table] = {}                # 실시간 코드 → 슬롯
+        self._unusable: Set[bytes] = set()                   # 경고를 남긴 미등록/반복 블록 실시간 코드
+        self._cond = threading.Condition(threading.Lock())
+        self._cursors: List["SiseCursor"] = []
+        self._waiters = 0
+        self._closed = False
+
+    # ========================================================================
+    # 쓰기 (윈도우 프로시저)
+    # ========================================================================
+
+    def update_from_lparam(self, lparam: int) -> bool:
+        """
+        CA_RECEIVESISE OUTDATABLOCK의 레코드를 종목 슬롯에 덮어씀
+
+        Returns:
+            bool: True면 슬롯에 저장함 (큐에 넣지 않음). False면 기존처럼 파싱해서 큐로 전달
+        """
+        c_block = ctypes.cast(lparam, POINTER(COutDataBlock)).contents
+        if not c_block.pData:
+            return False
+        c_struct = c_block.pData.contents
+        if not c_struct.szBlockName or not c_struct.szData:
+            return False
+        bc = ctypes.string_at(c_struct.szBlockName, 2)
+        table = self._tables.get(bc, False)
+        if table is False or (table is not None and table.info is not lookup_block(table.bc_type)):
+            table = self._create_table(bc)
+        if table is None or c_struct.nLen - _SISE_PREFIX < table.size:
+            return False
+
+        src = ctypes.cast(c_struct.szData, ctypes.c_void_p).value + _SISE_PREFIX
+        code = ctypes.string_at(src, table.code_width)
+        with self._cond:
+            slot = table.slots.get(code)
+            if slot is None:
+                slot = len(table.keys)
+                if slot >= self.capacity:
+                    self.stats.overflow += 1
+                    return False
+                key = (table.bc_type, code.decode("cp949", errors="ignore").strip())
+                table.slots[code] = slot
+                table.index[key[1]] = slot
+                table.keys.append(key)
+            ctypes.memmove(table.base + slot * table.size, src, table.size)
+            self.stats.updates += 1
+            key = table.keys[slot]
+            for cursor in self._cursors:
+                cursor._dirty.add(key)
+            if self._waiters:
+                self._cond.notify_all()
+        return True
+
+    def _create_table(self, bc: bytes) -> Optional[_Table]:
+        """실시간 코드의 슬롯 버퍼 할당 (처음 수신할 때, 블록을 다시 등록하면 새로 할당)
+
+        bc_types에 없는 코드는 None을 기록합니다. 미등록/반복 블록은 기록하지 않으므로
+        나중에 register_block()하면 그때부터 슬롯에 저장합니다.
+        """
+        if self._bc_types is not None and bc not in self._bc_types:
+            with self._cond:
+                self._tables[bc] = None
+            return None
+        info = lookup_block(bc.decode("cp949", errors="ignore"))
+        if info is None or info.is_array:
+            if bc not in self._unusable:
+                self._unusable.add(bc)
+                logger.warning("최신값 저장 불가 실시간 코드 %r (미등록 또는 반복 블록): 큐로 전달합니다", bc)
+            with self._cond:
+                self._tables.pop(bc, None)      # 등록 해제: 저장된 값은 계속 읽을 수 있음
+            return None
+        self._unusable.discard(bc)
+        code_width = ctypes.sizeof(info.struct_class._fields_[0][1])    # 첫 필드 = 종목코드
+        table = _Table(info, code_width, info.decoder(self.typed), self.capacity)
+        with self._cond:
+            previous = self._tables.get(bc)
+            self._tables[bc] = table
+            self._by_name[table.bc_type] = table
+        if previous is not None:
+            logger.info("실시간 코드 %s 재등록: 최신값 슬롯을 새로 할당합니다 (기존 %d종목)", table.bc_type, len(previous.keys))
+        return table
+
+    # ========================================================================
+    # 읽기
+    # ========================================================================
+
+    def _copy(self, keys: Optional[Iterable[SiseKey]] = None, bc_type: Optional[str] = None) -> List[Tuple[SiseKey, _Table, bytes]]:
+        """슬롯 원시 레코드 복사 (self._cond 보유 상태)"""
+        out = []
+        tables = self._by_name
+        if keys is None:
+            for table in tables.values():
+                if bc_type is not None and table.bc_type != bc_type:
+                    continue
+                size = table.size
+                for slot, key in enumerate(table.keys):
+                    out.append((key, table, bytes(table.view[slot * size:(slot + 1) * size])))
+            return out
+        for key in keys:
+            table = tables.get(key[0])
+            if table is None:
+                continue
+            slot = table.index.get(key[1])
+            if slot is None:
+                continue
+            out.append((key, table, bytes(table.view[slot * table.size:(slot + 1) * table.size])))
+        return out
+
+    @staticmethod
+    def _decode(records: List[Tuple[SiseKey, _Table, bytes]]) -> Dict[SiseKey, OutBlock]:
+        return {key: table.decoder.decode(raw) for key, table, raw in records}
+
+    def get(self, bc_type: str, code: str) -> Optional[OutBlock]:
+        """종목의 최신 틱 (아직 수신하지 않았으면 None)"""
+        with self._cond:
+            records = self._copy([(bc_type, code)])
+        if not records:
+            return None
+        _, table, raw = records[0]
+        return table.decoder.decode(raw)
+
+    def snapshot(self, bc_type: Optional[str] = None) -> Dict[SiseKey, OutBlock]:
+        """전체 종목의 최신 틱 {(실시간 코드, 종목코드): OutBlock}"""
+        with self._cond:
+            records = self._copy(bc_type=bc_type)
+        return self._decode(records)
+
+    def keys(self, bc_type: Optional[str] = None) -> List[SiseKey]:
+        """수신한 (실시간 코드, 종목코드) 목록"""
+        with self._cond:
+            return self._keys(bc_type)
+
+    def _keys(self, bc_type: Optional[str] = None) -> List[SiseKey]:
+        """(self._cond 보유 상태)"""
+        return [key for table in self._by_name.values()
+                if bc_type is None or table.bc_type == bc_type for key in table.keys]
+
+    def __len__(self) -> int:
+        return len(self.keys())
+
+    def cursor(self) -> "SiseCursor":
+        """변경 종목을 추적하는 읽기 커서 (첫 changed()는 지금까지 수신한 전체 종목)"""
+        return SiseCursor(self)
+
+    def open(self) -> None:
+        """close() 이후 다시 대기 가능 상태로 (WMCAAgent 재시작 시)"""
+        with self._cond:
+            self._closed = False
+
+    def close(self) -> None:
+        """대기 중인 SiseCursor.changed()를 깨움 (WMCAAgent 종료 시, 저장된 값은 계속 읽을 수 있음)"""
+        with self._cond:
+            self._closed = True
+            self._cond.notify_all()
+
+
+class SiseCursor:
+    """마지막으로 읽은 뒤 바뀐 종목만 돌려주는 읽기 커서
+
+    커서마다 변경 종목 집합을 하나 가지므로 읽는 주기가 달라도 서로 영향을 주지 않습니다.
+    한 커서는 한 스레드에서만 사용하세요.
+    """
+
+    def __init__(self, store: LatestValueStore):
+        self._store = store
+        with store._cond:
+            self._dirty: Set[SiseKey] = set(store._keys())
+            store._cursors.append(self)
+
+    def changed(self, timeout: Optional[float] = 0.0) -> Dict[SiseKey, OutBlock]:
+        """
+        마지막 호출 뒤 바뀐 종목의 최신 틱
+
+        Args:
+            timeout: 바뀐 종목이 없을 때 최대 대기 시간 (초). 0이면 바로 반환,
+                None이면 바뀐 종목이 생기거나 저장소가 닫힐 때까지 대기
+
+        Returns:
+            Dict[SiseKey, OutBlock]: {(실시간 코드, 종목코드): 최신 틱} (없으면 빈 dict)
+        """
+        store = self._store
+        with store._cond:
+            if not self._dirty and timeout != 0 and not store._closed:
+                store._waiters += 1
+                try:
+                    store._cond.wait_for(lambda: self._dirty or store._closed, timeout)
+                finally:
+                    store._waiters -= 1
+            if not self._dirty:
+                return {}
+            keys, self._dirty = self._dirty, set()
+            records = store._copy(keys)
+        return store._decode(records)
+
+    def close(self) -> None:
+        """커서 해제 (더 이상 변경 종목을 기록하지 않음)"""
+        store = self._store
+        with store._cond:
+            store._cursors = [cursor for cursor in store._cursors if cursor is not self]
+            self._dirty = set()
+
+    def __enter__(self) -> "SiseCursor":
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+        return False
+
+
+__all__ = [
+    "LatestValueStore",
+    "SiseCursor",
+    "ConflationStats",
+    "SiseKey",
+]
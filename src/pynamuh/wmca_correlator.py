@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryCorrelator - TrIndex 자동 할당과 TR 응답 모으기
+
+WMCAAgent.submit_query()가 TrIndex를 할당해 wmcaQuery를 호출하고 QueryFuture를 반환합니다.
+같은 TrIndex로 도착하는 CA_RECEIVEMESSAGE / CA_RECEIVEDATA(블록마다) / CA_RECEIVECOMPLETE /
+CA_RECEIVEERROR는 윈도우 프로시저 안에서 요청별 누적기로 전달되고 message_queue에는 들어가지 않습니다.
+
+    - CA_RECEIVECOMPLETE: QueryResult(블록명 → szData, 메시지 목록)로 future 완료
+    - CA_RECEIVEERROR: QueryError로 future 실패
+    - CA_DISCONNECTED: 대기 중인 모든 future를 ConnectionError로 실패
+
+Example:
+    >>> with WMCAAgent(threaded=True) as agent:
+    ...     ...
+    ...     futures = [agent.submit_query("c8201", inblock, nAccountIndex=i) for i in (1, 2, 3)]
+    ...     for future in futures:
+    ...         result = future.result(timeout=5.0)
+    ...         print(result["c8201OutBlock"].dpsit_amtz16, len(result["c8201OutBlock1"]))
+
+Note:
+    - 대기 중인 요청 테이블은 TrIndex → 누적기 dict (조회/삭제 O(1))입니다.
+    - future 콜백은 이벤트를 처리하는 스레드(기본 모드는 receive_*()/result()를 호출한 스레드,
+      threaded 모드는 펌프 스레드)에서 실행됩니다.
+    - future.cancel()하면 테이블에서 빠지고, 이후 도착하는 해당 TrIndex 응답은 조용히 버립니다.
+"""
+
+import threading
+import time
+from concurrent.futures import Future, InvalidStateError
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, List, Optional
+
+from .wmca_logger import logger
+from .wmca_transport import WM_USER
+
+# WMCAMessage 값 (wmca_agent와의 순환 import를 피하기 위해 값으로 비교)
+_CA_RECEIVEDATA = WM_USER + 210
+_CA_RECEIVEMESSAGE = WM_USER + 230
+_CA_RECEIVECOMPLETE = WM_USER + 240
+_CA_RECEIVEERROR = WM_USER + 250
+
+# TrIndex 할당 범위 (wmcaQuery nTRID는 int)
+FIRST_TR_INDEX = 1
+LAST_TR_INDEX = 0x7FFFFFFF
+
+
+# ============================================================================
+# 결과 / 오류
+# ============================================================================
+
+@dataclass(slots=True)
+class QueryResult:
+    """TR 조회 결과 (CA_RECEIVECOMPLETE까지 모은 블록)
+
+    Attributes:
+        tr_index: 할당된 TrIndex
+        tr_code: 서비스 코드 (예: "c8201")
+        blocks: 블록명 → szData (같은 블록이 여러 번 오면 리스트로 이어 붙임)
+        messages: CA_RECEIVEMESSAGE로 받은 MsgHeader 목록
+        elapsed_ns: wmcaQuery 호출부터 완료까지 걸린 시간 (나노초)
+    """
+    tr_index: int
+    tr_code: str
+    blocks: Dict[str, Any] = field(default_factory=dict)
+    messages: List[Any] = field(default_factory=list)
+    elapsed_ns: int = 0
+
+    def __getitem__(self, block_name: str) -> Any:
+        return self.blocks[block_name]
+
+    def __contains__(self, block_name: str) -> bool:
+        return block_name in self.blocks
+
+    def get(self, block_name: str, default: Any = None) -> Any:
+        return self.blocks.get(block_name, default)
+
+    @property
+    def message(self) -> Optional[Any]:
+        """마지막 MsgHeader (없으면 None)"""
+        return self.messages[-1] if self.messages else None
+
+
+class QueryError(RuntimeError):
+    """TR 처리 실패 (CA_RECEIVEERROR)
+
+    Attributes:
+        tr_index: TrIndex
+        tr_code: 서비스 코드
+        messages: 실패 전까지 받은 MsgHeader 목록
+        result: 실패 전까지 받은 블록 (QueryResult)
+    """
+
+    def __init__(self, result: QueryResult):
+        self.tr_index = result.tr_index
+        self.tr_code = result.tr_code
+        self.messages = result.messages
+        self.result = result
+        header = result.message
+        detail = f" [{header.msg_cd}] {header.user_msg.strip()}" if hasattr(header, "msg_cd") else ""
+        super().__init__(f"TR 처리 실패: {result.tr_code} (TrIndex={result.tr_index}){detail}")
+
+
+class QueryFuture(Future):
+    """TR 조회 future (concurrent.futures.Future)
+
+    기본 모드(threaded=False)에서 윈도우를 만든 스레드가 result()/exception()을 호출하면
+    결과가 올 때까지 메시지 펌프를 직접 돌립니다. (다른 이벤트는 message_queue에 쌓임)
+
+    Attributes:
+        tr_index: 할당된 TrIndex
+        tr_code: 서비스 코드
+    """
+
+    def __init__(self, tr_index: int, tr_code: str, pump: Optional[Callable[["QueryFuture", Optional[float]], None]] = None):
+        super().__init__()
+        self.tr_index = tr_index
+        self.tr_code = tr_code
+        self._pump = pump
+
+    def _pump_for(self, timeout: Optional[float]) -> Optional[float]:
+        """펌프를 돌리고 남은 timeout 반환 (다른 스레드에서는 펌프가 바로 반환)"""
+        if self._pump is None or self.done():
+            return timeout
+        start = time.monotonic()
+        self._pump(self, timeout)
+        return None if timeout is None else max(0.0, timeout - (time.monotonic() - start))
+
+    def result(self, timeout: Optional[float] = None) -> QueryResult:
+        return super().result(self._pump_for(timeout))
+
+    def exception(self, timeout: Optional[float] = None) -> Optional[BaseException]:
+        return super().exception(self._pump_for(timeout))
+
+
+# ============================================================================
+# QueryCorrelator
+# ============================================================================
+
+class _Pending:
+    """요청별 누적기"""
+    __slots__ = ("future", "result", "started_ns")
+
+    def __init__(self, future: QueryFuture):
+        self.future = future
+        self.result = QueryResult(future.tr_index, future.tr_code)
+        self.started_ns = time.perf_counter_ns()
+
+    def add_block(self, block_name: str, data: Any):
+        blocks = self.result.blocks
+        if block_name not in blocks:
+            blocks[block_name] = data
+            return
+        previous = blocks[block_name]
+        if isinstance(previous, list) and isinstance(data, list):
+            previous.extend(data)
+        elif isinstance(previous, list):
+            previous.append(data)
+        else:
+            blocks[block_name] = [previous, data]
+
+
+def _block_of(data: Any):
+    """OutDataBlock / FlatOutDataBlock에서 (블록명, szData) 추출 (pData가 NULL이면 ("", None))"""
+    if hasattr(data, "pData"):
+        received = data.pData
+        if received is None:
+            return "", None
+        return received.szBlockName, received.szData
+    return data.szBlockName, data.szData
+
+
+class QueryCorrelator:
+    """TrIndex 할당과 요청별 응답 라우팅
+
+    Args:
+        first_index: 할당할 첫 TrIndex
+        last_index: 할당할 마지막 TrIndex (넘으면 first_index부터 다시, 사용 중인 값은 건너뜀)
+
+    Attributes:
+        completed: 완료된 요청 수
+        failed: 실패한 요청 수 (CA_RECEIVEERROR, 연결 해제)
+        late: 취소된 요청에 늦게 도착해 버린 이벤트 수
+    """
+
+    def __init__(self, first_index: int = FIRST_TR_INDEX, last_index: int = LAST_TR_INDEX):
+        if not 0 < first_index <= last_index:
+            raise ValueError(f"TrIndex 범위가 잘못되었습니다: {first_index}~{last_index}")
+        self.first_index = first_index
+        self.last_index = last_index
+        self._next_index = first_index
+        self._lock = threading.Lock()
+        self._pending: Dict[int, _Pending] = {}
+        self._abandoned: Dict[int, str] = {}     # 취소된 TrIndex → tr_code (COMPLETE/ERROR까지 응답 버림)
+        self.completed = 0
+        self.failed = 0
+        self.late = 0
+
+    def __len__(self) -> int:
+        """대기 중인 요청 수"""
+        return len(self._pending)
+
+    def __contains__(self, tr_index: int) -> bool:
+        return tr_index in self._pending
+
+    # ------------------------------------------------------------------------
+    # 할당 / 등록
+    # ------------------------------------------------------------------------
+
+    def allocate(self) -> int:
+        """대기/취소 중이 아닌 다음 TrIndex"""
+        with self._lock:
+            return self._allocate_locked()
+
+    def _allocate_locked(self) -> int:
+        span = self.last_index - self.first_index + 1
+        if len(self._pending) + len(self._abandoned) >= span:
+            raise RuntimeError(f"할당 가능한 TrIndex가 없습니다 (대기 중 {len(self._pending)}건)")
+        index = self._next_index
+        while index in self._pending or index in self._abandoned:
+            index = self.first_index if index >= self.last_index else index + 1
+        self._next_index = self.first_index if index >= self.last_index else index + 1
+        return index
+
+    def register(self, tr_code: str, pump=None) -> QueryFuture:
+        """TrIndex를 할당하고 대기 테이블에 등록 (wmcaQuery 호출 전에 호출)"""
+        with self._lock:
+            future = QueryFuture(self._allocate_locked(), tr_code, pump)
+            self._pending[future.tr_index] = _Pending(future)
+        future.add_done_callback(self._on_done)
+        return future
+
+    def discard(self, tr_index: int) -> None:
+        """대기 테이블에서 제거 (wmcaQuery 호출 실패 시)"""
+        with self._lock:
+            self._pending.pop(tr_index, None)
+
+    def _on_done(self, future: QueryFuture):
+        if not future.cancelled():
+            return
+        with self._lock:
+            pending = self._pending.pop(future.tr_index, None)
+            if pending is not None:
+                self._abandoned[future.tr_index] = future.tr_code
+        if pending is not None:
+            logger.debug("TR 조회 취소: %s (TrIndex=%s)", future.tr_code, future.tr_index)
+
+    # ------------------------------------------------------------------------
+    # 라우팅 (윈도우 프로시저 / 펌프 스레드)
+    # ------------------------------------------------------------------------
+
+    def route(self, msg_type: int, data: Any) -> bool:
+        """TR 이벤트를 대기 중인 요청으로 전달
+
+        Returns:
+            bool: 이 correlator가 처리한 이벤트면 True (message_queue에 넣지 않음)
+        """
+        tr_index = data.TrIndex
+        pending = self._pending.get(tr_index)
+        if pending is None:
+            if tr_index not in self._abandoned:
+                return False
+            self.late += 1
+            if msg_type == _CA_RECEIVECOMPLETE or msg_type == _CA_RECEIVEERROR:
+                with self._lock:
+                    self._abandoned.pop(tr_index, None)
+            return True
+
+        if msg_type == _CA_RECEIVEDATA:
+            block_name, block = _block_of(data)
+            pending.add_block(block_name, block)
+        elif msg_type == _CA_RECEIVEMESSAGE:
+            pending.result.messages.append(_block_of(data)[1])
+        elif msg_type == _CA_RECEIVECOMPLETE or msg_type == _CA_RECEIVEERROR:
+            with self._lock:
+                self._pending.pop(tr_index, None)
+            result = pending.result
+            result.elapsed_ns = time.perf_counter_ns() - pending.started_ns
+            if msg_type == _CA_RECEIVECOMPLETE:
+                self.completed += 1
+                _resolve(pending.future, result=result)
+            else:
+                self.failed += 1
+                _resolve(pending.future, exception=QueryError(result))
+        return True
+
+    def fail_all(self, exception: BaseException) -> int:
+        """대기 중인 모든 요청을 실패 처리 (연결 해제 시)
+
+        Returns:
+            int: 실패 처리한 요청 수
+        """
+        with self._lock:
+            pendings = list(self._pending.values())
+            self._pending.clear()
+            self._abandoned.clear()
+        for pending in pendings:
+            _resolve(pending.future, exception=exception)
+        self.failed += len(pendings)
+        return len(pendings)
+
+
+def _resolve(future: Future, result: Any = None, exception: Optional[BaseException] = None):
+    """future 완료 (이미 취소된 경우 무시)"""
+    try:
+        if exception is not None:
+            future.set_exception(exception)
+        else:
+            future.set_result(result)
+    except InvalidStateError:
+        pass
+
+
+def forward_future(source: Future, destination: Future):
+    """source future의 결과/예외/취소를 destination으로 전달 (source의 done 콜백으로 사용)"""
+    if source.cancelled():
+        destination.cancel()
+        return
+    exception = source.exception()
+    if exception is not None:
+        _resolve(destination, exception=exception)
+    else:
+        _resolve(destination, result=source.result())
+
+
+__all__ = [
+    "QueryCorrelator",
+    "QueryFuture",
+    "QueryResult",
+    "QueryError",
+]
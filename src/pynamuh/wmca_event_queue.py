@@ -0,0 +1,422 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+BoundedEventQueue - 크기 제한 이벤트 큐 (메시지 타입별 넘침 정책 + 버림 집계)
+
+WMCAAgent.message_queue는 기본 모드에서 크기 제한 없는 queue.Queue이므로 변동성이 커서 소비자가
+밀리면 메모리와 지연이 끝없이 늘어납니다. WMCAAgent(queue_capacity=N)로 생성하면 이 큐를 사용하고,
+큐가 가득 찼을 때 메시지 타입별 정책에 따라 처리합니다.
+
+    block        소비자가 꺼낼 때까지 생산자(펌프 스레드)가 대기 (버리지 않음)
+    drop_oldest  큐에 있는 가장 오래된 시세를 버리고 새 이벤트 적재
+    drop_newest  새 이벤트를 버림
+    conflate     같은 (블록명, 종목코드)의 시세가 큐에 있으면 그 중 가장 최근 틱 자리를 새 틱으로 교체
+                 (가득 차서 버린 것과 따로 집계). 교체할 틱이 없으면 drop_oldest
+
+버릴 수 있는 메시지(block 이외 정책)와 버리지 않는 메시지를 각각 deque에 넣고 순번으로 도착 순서를
+유지합니다. 주문/TR 응답처럼 버리지 않는 메시지가 가득 찬 큐에 들어오면 버릴 수 있는 시세부터
+밀어내고, 밀어낼 시세가 없을 때만 대기합니다.
+
+Example:
+    >>> with WMCAAgent(threaded=True, queue_capacity=10_000, overflow_policy="conflate") as agent:
+    ...     ...
+    ...     print(agent.drop_stats)     # DropStats(dropped_oldest=..., dropped_newest=..., conflated=..., ...)
+
+Note:
+    - 기본 모드(threaded=False)에서는 생산자가 소비자 스레드 자신이므로 대기할 수 없습니다.
+      버리지 않는 메시지는 capacity를 넘겨 적재하고 overcommitted로 집계합니다.
+    - 가득 차서 버린 건수는 report_interval초마다 한 번 WARNING 로그로, 합친(conflate) 건수는
+      INFO 로그로 따로 알립니다.
+    - 큐가 닫히면(에이전트 종료) 대기 중인 생산자를 깨우고, 이후 도착한 이벤트는 버립니다. (closed_drops)
+"""
+
+import asyncio
+import queue
+import threading
+import time
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Any, Callable, Deque, Dict, List, Literal, Optional, Tuple
+
+from .wmca_logger import logger
+from .wmca_ring_buffer import HandoffStats
+from .structures.parser_info import BlockInfo, lookup_block
+
+OverflowPolicy = Literal["block", "drop_oldest", "drop_newest", "conflate"]
+OVERFLOW_POLICIES = ("block", "drop_oldest", "drop_newest", "conflate")
+
+
+@dataclass
+class DropStats:
+    """BoundedEventQueue 버림 통계
+
+    Attributes:
+        dropped_oldest: 큐가 가득 차 밀려나 버린 이벤트 수 (drop_oldest, 버리지 않는 메시지가 밀어낸 경우 포함)
+        dropped_newest: 가득 찬 큐에 넣지 않고 버린 이벤트 수 (drop_newest)
+        conflated: 가득 찬 큐에서 같은 종목의 새 틱으로 교체된 이벤트 수 (conflate)
+        overcommitted: 기본 모드에서 버리지 않는 메시지를 capacity를 넘겨 적재한 수
+        closed_drops: 큐가 닫힌 뒤(종료 중) 도착해 버린 이벤트 수
+        by_block: 블록명(실시간 코드)별 가득 차서 버린 이벤트 수
+    """
+    dropped_oldest: int = 0
+    dropped_newest: int = 0
+    conflated: int = 0
+    overcommitted: int = 0
+    closed_drops: int = 0
+    by_block: Dict[str, int] = field(default_factory=dict)
+
+    @property
+    def total(self) -> int:
+        """큐가 가득 차서 버린 이벤트 수 합계 (conflated 제외)"""
+        return self.dropped_oldest + self.dropped_newest
+
+
+# ============================================================================
+# 종목 키 (conflate)
+# ============================================================================
+
+# 블록명 → (등록 정보, (첫 필드명, 첫 필드 폭)). 실시간 블록의 첫 필드는 종목코드
+# 등록 정보가 바뀌면(register_block(replace=True)/unregister_block) 다시 계산하고, 미등록 블록은 저장하지 않음
+_code_fields: Dict[str, Tuple[BlockInfo, Optional[Tuple[str, int]]]] = {}
+
+
+def _code_field(block_name: str) -> Optional[Tuple[str, int]]:
+    info = lookup_block(block_name)
+    if info is None:
+        return None
+    cached = _code_fields.get(block_name)
+    if cached is None or cached[0] is not info:
+        entry = None
+        if not info.is_array:
+            name, ctype = info.struct_class._fields_[0][:2]
+            entry = (name, ctype._length_ if hasattr(ctype, "_length_") else 1)
+        cached = _code_fields[block_name] = (info, entry)
+    return cached[1]
+
+
+def _received(data: Any) -> Any:
+    """OutDataBlock → Received/LazyReceived (FlatOutDataBlock은 그대로)"""
+    return getattr(data, "pData", data)
+
+
+def sise_key(data: Any) -> Optional[Tuple[str, Any]]:
+    """실시간 시세 이벤트의 (블록명, 종목코드). 알 수 없으면 None
+
+    decode 방식과 관계없이 szData를 파싱하지 않고 읽습니다. (lazy/raw는 원시 bytes 앞부분)
+    """
+    received = _received(data)
+    if received is None:
+        return None
+    name = received.szBlockName
+    code_field = _code_field(name)
+    if code_field is None:
+        return None
+    raw = getattr(received, "raw", None)
+    payload = received.szData if raw is None else raw
+    if isinstance(payload, (bytes, bytearray, memoryview)):
+        return name, bytes(payload[:code_field[1]])
+    code = getattr(payload, code_field[0], None)
+    return None if code is None else (name, code)
+
+
+def _block_name(data: Any) -> str:
+    received = _received(data)
+    return getattr(received, "szBlockName", "") or ""
+
+
+# ============================================================================
+# BoundedEventQueue
+# ============================================================================
+
+class BoundedEventQueue:
+    """크기 제한 이벤트 큐 (queue.Queue/SPSCRingBuffer와 같은 인터페이스)
+
+    put()에는 (msg_type, data, ...) 튜플을 넣습니다. 정책은 msg_type으로 찾습니다.
+
+    Args:
+        capacity: 최대 이벤트 수
+        policies: 메시지 타입 → 넘침 정책 (없는 타입은 "block")
+        blocking: False면 "block" 정책 메시지를 대기 없이 capacity를 넘겨 적재 (기본 모드)
+        report_interval: 버림 WARNING 로그 최소 간격 (초)
+    """
+
+    def __init__(
+        self,
+        capacity: int,
+        policies: Optional[Dict[int, OverflowPolicy]] = None,
+        blocking: bool = True,
+        report_interval: float = 5.0,
+    ):
+        if capacity <= 0:
+            raise ValueError(f"capacity는 1 이상이어야 합니다: {capacity}")
+        for msg_type, policy in (policies or {}).items():
+            if policy not in OVERFLOW_POLICIES:
+                raise ValueError(f"넘침 정책은 {OVERFLOW_POLICIES} 중 하나여야 합니다: {msg_type}={policy!r}")
+        self.capacity = capacity
+        self.blocking = blocking
+        self.report_interval = report_interval
+        self._policies: Dict[int, str] = {
+            msg_type: policy for msg_type, policy in (policies or {}).items() if policy != "block"
+        }
+
+        self._cond = threading.Condition(threading.Lock())
+        self._seq = 0
+        self._kept: Deque[Tuple[int, Any, int]] = deque()         # 버리지 않는 메시지 (순번, 이벤트, 적재 시각)
+        self._droppable: Deque[List[Any]] = deque()               # 버릴 수 있는 메시지 [순번, 이벤트, 종목 키, 적재 시각]
+        self._latest: Dict[Tuple[str, Any], List[Any]] = {}        # conflate: 종목 키 → 큐에 있는 항목
+        self._consumer_waiting = False
+        self._producer_waiting = False
+        self._closed = False
+        self._async_wake: Optional[Callable[[], None]] = None
+
+        self.stats = HandoffStats()
+        self.drops = DropStats()
+        self._reported = 0                  # 마지막 로그 시점의 버림 합계
+        self._reported_conflated = 0        # 마지막 로그 시점의 합친 건수
+        self._report_at = 0.0
+
+    # ------------------------------------------------------------------------
+    # 상태 조회
+    # ------------------------------------------------------------------------
+
+    def qsize(self) -> int:
+        return len(self._kept) + len(self._droppable)
+
+    def empty(self) -> bool:
+        return not self._kept and not self._droppable
+
+    def full(self) -> bool:
+        return self.qsize() >= self.capacity
+
+    @property
+    def closed(self) -> bool:
+        return self._closed
+
+    def policy(self, msg_type: int) -> str:
+        """메시지 타입의 넘침 정책"""
+        return self._policies.get(msg_type, "block")
+
+    # ------------------------------------------------------------------------
+    # 생산자
+    # ------------------------------------------------------------------------
+
+    def put(self, item: tuple, timeout: Optional[float] = None) -> None:
+        """이벤트 추가 (가득 차면 메시지 타입의 정책에 따라 처리)
+
+        Raises:
+            queue.Full: "block" 정책에서 timeout 내에 빈 자리가 생기지 않은 경우
+        """
+        policy = self._policies.get(item[0], "block")
+        dropped = False
+        with self._cond:
+            if self._closed:
+                self.drops.closed_drops += 1
+                return
+            key = None
+            if policy == "conflate":
+                key = sise_key(item[1])
+                # 가득 찼을 때만 교체 (여유가 있으면 중간 틱도 모두 전달)
+                full = len(self._kept) + len(self._droppable) >= self.capacity
+                entry = self._latest.get(key) if full and key is not None else None
+                if entry is not None:
+                    self.drops.conflated += 1
+                    entry[1] = item
+                    dropped = True
+            if not dropped:
+                dropped = self._make_room(policy, item, timeout)
+                if not dropped:
+                    self._append(policy, item, key)
+        if dropped:
+            self._report()
+
+    def _make_room(self, policy: str, item: tuple, timeout: Optional[float]) -> bool:
+        """가득 찼으면 자리를 만듦 (self._cond 보유 상태). True면 item을 버림"""
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while len(self._kept) + len(self._droppable) >= self.capacity:
+            if policy == "drop_newest":
+                self._count_drop("dropped_newest", item)
+                return True
+            if self._droppable:
+                self._count_drop("dropped_oldest", self._pop_droppable()[1])
+                continue
+            if policy != "block":
+                # 밀어낼 시세가 없음 (큐가 버리지 않는 메시지로만 가득 참): 새 시세가 가장 오래된 후보
+                self._count_drop("dropped_oldest", item)
+                return True
+            if not self.blocking:
+                self.drops.overcommitted += 1
+                return False
+            if self._closed:
+                # 대기 중 종료: 소비자가 더 이상 꺼내지 않으므로 버림
+                self.drops.closed_drops += 1
+                return True
+            remaining = None if deadline is None else deadline - time.monotonic()
+            if remaining is not None and remaining <= 0:
+                raise queue.Full
+            self.stats.producer_waits += 1
+            self._producer_waiting = True
+            try:
+                self._cond.wait(remaining)
+            finally:
+                self._producer_waiting = False
+        return False
+
+    def _append(self, policy: str, item: tuple, key: Optional[Tuple[str, Any]]) -> None:
+        seq = self._seq
+        self._seq = seq + 1
+        now = time.perf_counter_ns()
+        if policy == "block":
+            self._kept.append((seq, item, now))
+        else:
+            entry = [seq, item, key, now]
+            self._droppable.append(entry)
+            if key is not None:
+                self._latest[key] = entry
+        depth = len(self._kept) + len(self._droppable)
+        if depth > self.stats.max_depth:
+            self.stats.max_depth = depth
+        if self._consumer_waiting:
+            self._cond.notify_all()
+            self._wake_async()
+
+    def _pop_droppable(self) -> List[Any]:
+        entry = self._droppable.popleft()
+        key = entry[2]
+        if key is not None and self._latest.get(key) is entry:
+            del self._latest[key]
+        return entry
+
+    def _count_drop(self, reason: str, item: tuple) -> None:
+        """가득 차서 버린 이벤트 집계 (사유별, 블록명별)"""
+        drops = self.drops
+        setattr(drops, reason, getattr(drops, reason) + 1)
+        name = _block_name(item[1])
+        drops.by_block[name] = drops.by_block.get(name, 0) + 1
+
+    def _report(self) -> None:
+        """report_interval마다 가득 차서 버린 건수는 WARNING, 합친 건수는 INFO 로그 1건씩"""
+        now = time.monotonic()
+        if now - self._report_at < self.report_interval:
+            return
+        drops = self.drops
+        self._report_at = now
+        total = drops.total
+        if total != self._reported:
+            logger.warning(
+                "이벤트 큐 가득 참(capacity=%d): %d건 버림 (누적 drop_oldest=%d, drop_newest=%d, 블록별=%s)",
+                self.capacity, total - self._reported, drops.dropped_oldest, drops.dropped_newest,
+                drops.by_block,
+            )
+            self._reported = total
+        if drops.conflated != self._reported_conflated:
+            logger.info(
+                "이벤트 큐 시세 합침(conflate): %d건 (누적 %d건)",
+                drops.conflated - self._reported_conflated, drops.conflated,
+            )
+            self._reported_conflated = drops.conflated
+
+    # ------------------------------------------------------------------------
+    # 소비자
+    # ------------------------------------------------------------------------
+
+    def get_nowait(self) -> Any:
+        """이벤트 꺼내기 (도착 순서, 비어 있으면 queue.Empty)"""
+        with self._cond:
+            kept, droppable = self._kept, self._droppable
+            if kept and (not droppable or kept[0][0] < droppable[0][0]):
+                _, item, stamp = kept.popleft()
+            elif droppable:
+                entry = self._pop_droppable()
+                item, stamp = entry[1], entry[3]
+            else:
+                raise queue.Empty
+            if self._producer_waiting:
+                self._cond.notify_all()
+
+        latency = time.perf_counter_ns() - stamp
+        stats = self.stats
+        stats.count += 1
+        stats.total_latency_ns += latency
+        stats.last_latency_ns = latency
+        if latency > stats.max_latency_ns:
+            stats.max_latency_ns = latency
+        return item
+
+    def get(self, timeout: Optional[float] = None) -> Any:
+        """이벤트 꺼내기 (비어 있으면 timeout까지 대기, 시간 초과 시 queue.Empty)"""
+        if not self.wait(timeout):
+            raise queue.Empty
+        return self.get_nowait()
+
+    def wait(self, timeout: Optional[float] = None) -> bool:
+        """이벤트가 들어올 때까지 대기
+
+        Returns:
+            bool: 이벤트 존재 여부 (False면 timeout 또는 close)
+        """
+        with self._cond:
+            if self._kept or self._droppable:
+                return True
+            if self._closed:
+                return False
+            self._consumer_waiting = True
+            try:
+                self._cond.wait_for(lambda: self._kept or self._droppable or self._closed, timeout)
+            finally:
+                self._consumer_waiting = False
+            return bool(self._kept or self._droppable)
+
+    async def wait_async(self, timeout: Optional[float] = None) -> bool:
+        """wait()의 asyncio 버전 (이벤트 루프 스레드에서 호출, SPSCRingBuffer.wait_async()와 동일)"""
+        loop = asyncio.get_running_loop()
+        ready = asyncio.Event()
+        with self._cond:
+            if self._kept or self._droppable:
+                return True
+            if self._closed:
+                return False
+            self._async_wake = lambda: loop.call_soon_threadsafe(ready.set)
+            self._consumer_waiting = True
+        try:
+            try:
+                await asyncio.wait_for(ready.wait(), timeout)
+            except asyncio.TimeoutError:
+                pass
+        finally:
+            with self._cond:
+                self._consumer_waiting = False
+                self._async_wake = None
+        return not self.empty()
+
+    def _wake_async(self) -> None:
+        """wait_async() 대기 중인 이벤트 루프를 한 번만 깨움 (self._cond 보유 상태)"""
+        wake = self._async_wake
+        if wake is not None:
+            self._async_wake = None
+            try:
+                wake()
+            except RuntimeError:
+                pass    # 이벤트 루프가 이미 닫힘
+
+    # ------------------------------------------------------------------------
+    # 종료
+    # ------------------------------------------------------------------------
+
+    def close(self) -> None:
+        """큐 닫기 - 대기 중인 생산자/소비자를 모두 깨움"""
+        with self._cond:
+            self._closed = True
+            self._cond.notify_all()
+            self._wake_async()
+        if self.drops.total != self._reported or self.drops.conflated != self._reported_conflated:
+            self._report_at = 0.0
+            self._report()
+
+
+__all__ = [
+    "BoundedEventQueue",
+    "DropStats",
+    "OverflowPolicy",
+    "OVERFLOW_POLICIES",
+    "sise_key",
+]
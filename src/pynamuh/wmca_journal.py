@@ -0,0 +1,527 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+메모리 맵 바이너리 틱 저널
+CA_RECEIVESISE 원시 페이로드를 디코딩 전에 추가 전용(append-only) 파일로 기록
+
+파일 형식 (리틀 엔디언):
+    파일 헤더 (16 bytes): magic b"PNMJ", version(u16), reserved(u16), reserved(u64)
+    레코드: [data_len u32][crc32 u32][recv_ns i64][kind u16][name_len u16][name][data]
+        - recv_ns: time.monotonic_ns() 수신 시각
+        - kind: WMCAMessage 값 (KIND_SESSION은 세션 시작 레코드)
+        - crc32: recv_ns 이후 헤더 + name + data의 CRC32 (찢어진 레코드 검출용)
+    세션 시작 레코드 (kind=0): data = [wall_ns i64][mono_ns i64]
+        파일을 열 때마다 기록하여 monotonic 시각을 벽시계 시각으로 변환할 수 있게 함
+
+- 쓰기는 미리 늘려 둔 메모리 맵에 대한 memcpy뿐이므로 펌프 스레드에서 시스템 콜 없이 기록됩니다.
+  마지막 청크의 절반을 넘게 쓰면 백그라운드 스레드(wmca-journal)가 파일을 chunk_size만큼 늘리고
+  새 맵을 만들어 두며, 펌프 스레드는 가득 찼을 때 맵 참조만 바꿉니다.
+  (예전 맵의 msync/close도 백그라운드에서 수행. 준비가 늦으면 그때만 펌프 스레드에서 확장)
+- 프로세스가 비정상 종료되면 다시 열 때 마지막 유효 레코드 뒤부터 이어서 씁니다. (tail recovery)
+- 로컬 자정이 지나면 다음 날짜 파일로 교체합니다. (daily rotation, 다음 날짜 파일은 자정 1분 전에
+  백그라운드에서 미리 열고, 이전 파일의 flush/truncate/close도 백그라운드에서 수행)
+
+Example:
+    >>> with TickJournal("journal") as journal:
+    ...     with WMCAAgent(journal=journal) as agent:
+    ...         ...
+    >>> for record in read_journal("journal/sise_20260105.wj"):
+    ...     print(record.block_name, record.wall_ns, len(record.data))
+"""
+
+import mmap
+import os
+import queue
+import struct
+import sys
+import threading
+import time
+import zlib
+from dataclasses import dataclass
+from datetime import datetime, timedelta
+from pathlib import Path
+from typing import Callable, Iterator, Optional, Tuple, Union
+
+from .wmca_logger import logger
+
+MAGIC = b"PNMJ"
+VERSION = 1
+
+# 세션 시작 레코드 kind (WMCAMessage 값과 겹치지 않음)
+KIND_SESSION = 0
+
+_FILE_HEADER = struct.Struct("<4sHHQ")
+_RECORD = struct.Struct("<IIqHH")      # data_len, crc32, recv_ns, kind, name_len
+_RECORD_TAIL = struct.Struct("<qHH")   # CRC 계산 대상 헤더 부분 (recv_ns, kind, name_len)
+_SESSION = struct.Struct("<qq")        # wall_ns, mono_ns
+
+DEFAULT_CHUNK_SIZE = 64 * 1024 * 1024
+
+# 자정 몇 초 전에 다음 날짜 파일을 미리 열지
+_ROTATE_PREPARE_NS = 60 * 1_000_000_000
+
+# Windows는 매핑이 열린 파일을 truncate할 수 없지만, 파일보다 큰 mmap을 만들면 파일을 늘려 줌
+_EXTEND_BY_MMAP = sys.platform == "win32"
+
+
+# ============================================================================
+# JournalRecord
+# ============================================================================
+
+@dataclass(slots=True)
+class JournalRecord:
+    """저널 레코드
+
+    Attributes:
+        kind: WMCAMessage 값
+        block_name: 블록명 원시 bytes (실시간은 2바이트, 예: b"j8")
+        data: szData 원시 bytes (nLen 바이트 전체)
+        recv_ns: 수신 시각 (time.monotonic_ns)
+        wall_ns: 수신 시각 (epoch 나노초, 세션 시작 레코드 기준으로 환산)
+    """
+    kind: int
+    block_name: bytes
+    data: bytes
+    recv_ns: int
+    wall_ns: int
+
+
+# ============================================================================
+# 파일 세그먼트 / 백그라운드 작업 스레드
+# ============================================================================
+
+class _Segment:
+    """열어서 매핑까지 끝낸 날짜 파일 (활성화 전)"""
+    __slots__ = ("path", "file", "mm", "end", "capacity", "recovered", "created")
+
+    def __init__(self, path: Path, file, mm: mmap.mmap, end: int, capacity: int, recovered: int, created: bool):
+        self.path = path
+        self.file = file
+        self.mm = mm
+        self.end = end
+        self.capacity = capacity
+        self.recovered = recovered
+        self.created = created
+
+    def discard(self) -> None:
+        """활성화하지 않은 세그먼트 닫기 (새로 만든 파일이면 삭제)"""
+        self.mm.close()
+        if self.created:
+            self.file.close()
+            self.path.unlink(missing_ok=True)
+        else:
+            self.file.truncate(self.end)
+            self.file.close()
+
+
+class _Worker:
+    """저널 백그라운드 작업 스레드 (파일 확장/매핑 준비, 예전 맵/파일 정리)"""
+
+    def __init__(self):
+        self._tasks: "queue.SimpleQueue[Optional[Tuple[Callable, tuple]]]" = queue.SimpleQueue()
+        self._thread = threading.Thread(target=self._run, name="wmca-journal", daemon=True)
+        self._thread.start()
+
+    def submit(self, fn: Callable, *args) -> None:
+        self._tasks.put((fn, args))
+
+    def stop(self) -> None:
+        """남은 작업을 모두 처리한 뒤 종료"""
+        if self._thread.is_alive():
+            self._tasks.put(None)
+            self._thread.join()
+
+    def _run(self) -> None:
+        while True:
+            task = self._tasks.get()
+            if task is None:
+                return
+            fn, args = task
+            try:
+                fn(*args)
+            except Exception as e:
+                logger.error("저널 백그라운드 작업 실패 (%s): %s", getattr(fn, "__name__", fn), e, exc_info=True)
+
+
+def _retire_map(mm: mmap.mmap) -> None:
+    """교체된 맵 정리 (같은 파일의 새 맵이 이어받으므로 내용은 유지됨)"""
+    mm.flush()
+    mm.close()
+
+
+def _retire_file(file, mm: mmap.mmap, pos: int, spare: Optional[mmap.mmap]) -> None:
+    """교체된 날짜 파일을 기록된 길이로 잘라내고 닫음"""
+    if spare is not None:
+        spare.close()
+    mm.flush()
+    mm.close()
+    file.truncate(pos)
+    file.close()
+
+
+# ============================================================================
+# TickJournal
+# ============================================================================
+
+class TickJournal:
+    """메모리 맵 추가 전용 틱 저널 (단일 기록 스레드)
+
+    Args:
+        directory: 저널 디렉터리 (없으면 생성)
+        prefix: 파일명 접두어 (파일명: {prefix}_{YYYYMMDD}.wj)
+        chunk_size: 파일을 늘리는 단위 (bytes)
+        rotate_daily: True면 로컬 자정마다 새 파일로 교체
+
+    Note:
+        - append()는 한 스레드(메시지 펌프 스레드)에서만 호출하세요.
+        - flush()는 다른 스레드에서 호출해도 됩니다. (디스크 동기화 주기는 사용자가 결정)
+        - close()는 append()가 더 이상 호출되지 않은 뒤 호출하세요. (백그라운드 작업을 모두 끝내고 닫음)
+    """
+
+    def __init__(
+        self,
+        directory: Union[str, Path],
+        prefix: str = "sise",
+        chunk_size: int = DEFAULT_CHUNK_SIZE,
+        rotate_daily: bool = True
+    ):
+        if chunk_size < 4096:
+            raise ValueError(f"chunk_size는 4096 이상이어야 합니다: {chunk_size}")
+        self.directory = Path(directory)
+        self.prefix = prefix
+        self.chunk_size = chunk_size
+        self.rotate_daily = rotate_daily
+
+        self.records = 0            # 이번 프로세스에서 기록한 레코드 수
+        self.bytes_written = 0      # 이번 프로세스에서 기록한 바이트 수
+        self.recovered_bytes = 0    # 마지막으로 연 파일에서 버린 손상된 꼬리 크기
+
+        self._lock = threading.RLock()  # 파일 교체/확장/flush/close 보호 (append 경로에는 없음)
+        self._file = None
+        self._mm: Optional[mmap.mmap] = None
+        self._pos = 0
+        self._capacity = 0
+        self._grow_at = 0                                   # 이 위치를 넘으면 다음 맵 준비 요청
+        self._rotate_at_ns = 0
+        self._prepare_rotate_ns = 0                         # 이 시각이 지나면 다음 날짜 파일 준비 요청
+        self._next_day: Optional[datetime] = None
+        self._grow_pending = False
+        self._rotate_pending = False
+        self._next_map: Optional[Tuple[object, mmap.mmap, int]] = None    # 백그라운드가 준비한 (파일, 맵, 크기)
+        self._next_segment: Optional[_Segment] = None                      # 백그라운드가 연 다음 날짜 파일
+        self.path: Optional[Path] = None
+
+        self.directory.mkdir(parents=True, exist_ok=True)
+        now = datetime.now()
+        segment = self._open_segment(now)
+        self._worker = _Worker()
+        self._activate(segment, now)
+
+    # ------------------------------------------------------------------
+    # 기록
+    # ------------------------------------------------------------------
+
+    def append(self, kind: int, block_name: bytes, data: bytes, recv_ns: Optional[int] = None) -> int:
+        """레코드 1건 기록
+
+        Args:
+            kind: WMCAMessage 값
+            block_name: 블록명 원시 bytes
+            data: szData 원시 bytes
+            recv_ns: 수신 시각 (time.monotonic_ns, None이면 현재 시각)
+
+        Returns:
+            int: 레코드 크기 (bytes)
+        """
+        if recv_ns is None:
+            recv_ns = time.monotonic_ns()
+        if recv_ns >= self._rotate_at_ns:
+            self._rotate()
+        elif recv_ns >= self._prepare_rotate_ns and not self._rotate_pending:
+            self._rotate_pending = True
+            self._worker.submit(self._prepare_segment, self._next_day)
+
+        name_len = len(block_name)
+        data_len = len(data)
+        size = _RECORD.size + name_len + data_len
+        pos = self._pos
+        if pos + size > self._capacity:
+            self._grow(size)
+            pos = self._pos
+
+        mm = self._mm
+        crc = zlib.crc32(data, zlib.crc32(block_name, zlib.crc32(_RECORD_TAIL.pack(recv_ns, kind, name_len))))
+        start = pos + _RECORD.size
+        mm[start:start + name_len] = block_name
+        mm[start + name_len:pos + size] = data
+        _RECORD.pack_into(mm, pos, data_len, crc, recv_ns, kind, name_len)
+
+        self._pos = pos + size
+        self.records += 1
+        self.bytes_written += size
+        if self._pos >= self._grow_at and not self._grow_pending:
+            self._grow_pending = True
+            self._worker.submit(self._prepare_map, self._file, self._capacity + self.chunk_size)
+        return size
+
+    def flush(self):
+        """메모리 맵 내용을 디스크에 동기화"""
+        with self._lock:
+            if self._mm is not None:
+                self._mm.flush()
+
+    def close(self):
+        """백그라운드 작업을 끝낸 뒤 flush하고 파일을 기록된 길이로 잘라내고 닫음"""
+        worker = getattr(self, "_worker", None)
+        if worker is not None:
+            worker.stop()
+        with self._lock:
+            if self._next_segment is not None:
+                self._next_segment.discard()
+                self._next_segment = None
+            self._close_file()
+
+    @property
+    def closed(self) -> bool:
+        return self._mm is None
+
+    def __enter__(self) -> "TickJournal":
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def __repr__(self) -> str:
+        return f"TickJournal(path={str(self.path)!r}, records={self.records}, bytes={self.bytes_written})"
+
+    # ------------------------------------------------------------------
+    # 파일 관리
+    # ------------------------------------------------------------------
+
+    def path_for(self, day: datetime) -> Path:
+        """날짜별 저널 파일 경로"""
+        return self.directory / f"{self.prefix}_{day:%Y%m%d}.wj"
+
+    def _open_segment(self, now: datetime) -> _Segment:
+        """날짜 파일을 열고 (없으면 생성) 마지막 유효 레코드를 찾아 chunk_size만큼 늘려 매핑"""
+        path = self.path_for(now)
+        exists = path.exists() and path.stat().st_size > 0
+        f = open(path, "r+b" if exists else "w+b")
+        try:
+            if exists:
+                end = _scan(f, path)
+                size = os.fstat(f.fileno()).st_size
+                recovered = _tail_garbage(f, end, size)
+            else:
+                f.write(_FILE_HEADER.pack(MAGIC, VERSION, 0, 0))
+                end = size = _FILE_HEADER.size
+                recovered = 0
+            capacity = max(size, end + self.chunk_size)
+            f.truncate(capacity)
+            mm = mmap.mmap(f.fileno(), capacity)
+            if end < size:
+                # 손상된 꼬리(찢어진 레코드)를 0으로 지워 다음 레코드와 섞이지 않게 함
+                mm[end:size] = bytes(size - end)
+        except Exception:
+            f.close()
+            raise
+        return _Segment(path, f, mm, end, capacity, recovered, not exists)
+
+    def _activate(self, segment: _Segment, now: datetime):
+        """세그먼트를 현재 파일로 사용하고 세션 레코드 기록 (시스템 콜 없음)"""
+        self._file, self._mm, self._pos, self._capacity, self.path = (
+            segment.file, segment.mm, segment.end, segment.capacity, segment.path
+        )
+        self.recovered_bytes = segment.recovered
+        self._grow_at = self._capacity - self.chunk_size // 2
+        self._grow_pending = False
+
+        wall_ns, mono_ns = time.time_ns(), time.monotonic_ns()
+        self._schedule_rotation(now)
+        self.append(KIND_SESSION, b"", _SESSION.pack(wall_ns, mono_ns), mono_ns)
+
+    def _schedule_rotation(self, now: datetime):
+        """다음 자정의 교체 시각과 준비 시각 계산"""
+        self._rotate_pending = False
+        if not self.rotate_daily:
+            self._rotate_at_ns = self._prepare_rotate_ns = 1 << 63
+            return
+        midnight = datetime.combine(now.date() + timedelta(days=1), datetime.min.time())
+        self._next_day = midnight
+        self._rotate_at_ns = time.monotonic_ns() + int((midnight.timestamp() - now.timestamp()) * 1e9)
+        self._prepare_rotate_ns = self._rotate_at_ns - _ROTATE_PREPARE_NS
+
+    def _close_file(self):
+        if self._mm is None:
+            return
+        if self._next_map is not None:
+            self._next_map[1].close()
+            self._next_map = None
+        self._mm.flush()
+        self._mm.close()
+        self._file.truncate(self._pos)
+        self._file.close()
+        self._mm = self._file = None
+        self._capacity = 0
+
+    def _map(self, file, capacity: int) -> mmap.mmap:
+        """file을 capacity로 늘려 새로 매핑 (기존 맵은 그대로 유효)"""
+        if not _EXTEND_BY_MMAP:
+            file.truncate(capacity)
+        return mmap.mmap(file.fileno(), capacity)
+
+    # ------------------------------------------------------------------
+    # 백그라운드 준비 (wmca-journal 스레드)
+    # ------------------------------------------------------------------
+
+    def _prepare_map(self, file, capacity: int):
+        """현재 파일을 capacity로 늘린 다음 맵을 만들어 둠 (그 사이 이미 늘렸으면 무시)"""
+        with self._lock:
+            if file is not self._file or capacity <= self._capacity or self._next_map is not None:
+                return
+            self._next_map = (file, self._map(file, capacity), capacity)
+
+    def _prepare_segment(self, day: datetime):
+        """다음 날짜 파일을 미리 열어 둠 (그 사이 이미 교체됐으면 무시)"""
+        with self._lock:
+            if day != self._next_day or self._next_segment is not None or self._file is None:
+                return
+            self._next_segment = self._open_segment(day)
+
+    # ------------------------------------------------------------------
+    # 펌프 스레드 (append 경로)
+    # ------------------------------------------------------------------
+
+    def _rotate(self):
+        """다음 날짜 파일로 교체 (미리 연 파일이 있으면 참조만 교체, 이전 파일은 백그라운드에서 정리)"""
+        now = datetime.now()
+        with self._lock:
+            if self.path_for(now) == self.path:
+                # 단조 시계와 벽시계가 어긋나 아직 같은 날짜: 파일은 그대로 두고 교체 시각만 다시 계산
+                self._schedule_rotation(now)
+                return
+            segment, self._next_segment = self._next_segment, None
+            spare = self._next_map[1] if self._next_map is not None else None
+            retired = (self._file, self._mm, self._pos, spare)
+            self._next_map = None
+            if segment is None or segment.path != self.path_for(now):
+                if segment is not None:
+                    self._worker.submit(segment.discard)
+                segment = self._open_segment(now)
+            self._activate(segment, now)
+        self._worker.submit(_retire_file, *retired)
+
+    def _grow(self, need: int):
+        """미리 준비한 더 큰 맵으로 교체 (준비가 안 됐거나 작으면 여기서 확장, flush 없음)"""
+        with self._lock:
+            ready, self._next_map = self._next_map, None
+            old = self._mm
+            if ready is not None and ready[0] is self._file and ready[2] >= self._pos + need:
+                self._mm, self._capacity = ready[1], ready[2]
+            else:
+                if ready is not None:
+                    self._worker.submit(_retire_map, ready[1])
+                capacity = self._capacity + max(self.chunk_size, need)
+                self._mm = self._map(self._file, capacity)
+                self._capacity = capacity
+            self._grow_at = self._capacity - self.chunk_size // 2
+            self._grow_pending = False
+        self._worker.submit(_retire_map, old)
+
+
+# ============================================================================
+# 읽기 / 복구
+# ============================================================================
+
+def _check_header(buf, path) -> None:
+    if len(buf) < _FILE_HEADER.size:
+        raise ValueError(f"저널 파일이 아님 (헤더 없음): {path}")
+    magic, version, _, _ = _FILE_HEADER.unpack_from(buf, 0)
+    if magic != MAGIC:
+        raise ValueError(f"저널 파일이 아님 (magic={magic!r}): {path}")
+    if version != VERSION:
+        raise ValueError(f"지원하지 않는 저널 버전 {version}: {path}")
+
+
+def _iter_records(buf) -> Iterator[tuple[int, int, int, int, int, int]]:
+    """유효 레코드 순회: (pos, size, recv_ns, kind, name_len, data_len). 첫 손상 레코드에서 종료"""
+    pos = _FILE_HEADER.size
+    end = len(buf)
+    header_size = _RECORD.size
+    view = memoryview(buf)
+    try:
+        while pos + header_size <= end:
+            data_len, crc, recv_ns, kind, name_len = _RECORD.unpack_from(buf, pos)
+            size = header_size + name_len + data_len
+            if pos + size > end or crc != zlib.crc32(view[pos + 8:pos + size]):
+                return
+            yield pos, size, recv_ns, kind, name_len, data_len
+            pos += size
+    finally:
+        view.release()
+
+
+def _scan(f, path) -> int:
+    """마지막 유효 레코드의 끝 위치"""
+    size = os.fstat(f.fileno()).st_size
+    with mmap.mmap(f.fileno(), size, access=mmap.ACCESS_READ) as mm:
+        _check_header(mm, path)
+        end = _FILE_HEADER.size
+        for pos, rec_size, *_ in _iter_records(mm):
+            end = pos + rec_size
+    return end
+
+
+def _tail_garbage(f, end: int, size: int) -> int:
+    """유효 레코드 뒤에서 0이 아닌 바이트 수 (비정상 종료로 남은 손상된 꼬리)"""
+    if end >= size:
+        return 0
+    f.seek(end)
+    tail = f.read(size - end)
+    return len(tail.rstrip(b"\0"))
+
+
+def read_journal(path: Union[str, Path], kind: Optional[int] = None) -> Iterator[JournalRecord]:
+    """저널 파일 읽기 (첫 손상 레코드에서 종료)
+
+    Args:
+        path: 저널 파일 경로
+        kind: 지정하면 해당 kind 레코드만 반환 (세션 레코드는 항상 제외)
+
+    Yields:
+        JournalRecord
+    """
+    with open(path, "rb") as f:
+        size = os.fstat(f.fileno()).st_size
+        if size == 0:
+            raise ValueError(f"저널 파일이 아님 (빈 파일): {path}")
+        with mmap.mmap(f.fileno(), size, access=mmap.ACCESS_READ) as mm:
+            _check_header(mm, path)
+            offset_ns = 0   # wall_ns - mono_ns (세션 레코드마다 갱신)
+            records = _iter_records(mm)
+            try:
+                for pos, rec_size, recv_ns, rec_kind, name_len, data_len in records:
+                    start = pos + _RECORD.size
+                    if rec_kind == KIND_SESSION:
+                        wall_ns, mono_ns = _SESSION.unpack_from(mm, start + name_len)
+                        offset_ns = wall_ns - mono_ns
+                        continue
+                    if kind is not None and rec_kind != kind:
+                        continue
+                    yield JournalRecord(
+                        kind=rec_kind,
+                        block_name=mm[start:start + name_len],
+                        data=mm[start + name_len:pos + rec_size],
+                        recv_ns=recv_ns,
+                        wall_ns=recv_ns + offset_ns,
+                    )
+            finally:
+                records.close()     # memoryview 해제 후 mmap 닫기
+
+
+__all__ = [
+    "TickJournal",
+    "JournalRecord",
+    "read_journal",
+    "KIND_SESSION",
+]
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+이벤트 처리 단계별 지연 히스토그램
+
+WMCAAgent(latency=True)로 생성하면 이벤트마다 다음 시점을 time.perf_counter_ns()로 기록하고,
+메시지 타입별/구간별 히스토그램(p50/p99/p999/max)으로 집계합니다.
+
+    t0  윈도우 프로시저 진입 (transport가 _handle_wmca_event 호출)
+    t1  디코딩 완료 (저널 기록 + szData 파싱) = message_queue.put() 호출
+    t2  put() 반환 (큐 적재 완료)
+    t3  소비자 전달 (receive_events()/receive_batch()가 큐에서 꺼낸 시점)
+
+구간:
+    decode   t0 → t1  파싱 비용
+    enqueue  t1 → t2  큐 적재 비용 (threaded 모드에서 링 버퍼가 가득 차 대기한 시간 포함)
+    handoff  t1 → t3  큐에서 기다린 시간 (펌프 대기, 소비자 처리 지연. 링 버퍼 대기도 포함)
+    total    t0 → t3  윈도우 프로시저 진입부터 소비자 전달까지
+
+decode/enqueue는 펌프 스레드가, handoff/total은 소비자 스레드가 기록합니다.
+(히스토그램마다 기록하는 스레드가 하나뿐이므로 락이 없습니다)
+
+Example:
+    >>> with WMCAAgent(latency=True) as agent:
+    ...     ...
+    ...     sise = agent.latency_stats[WMCAMessage.CA_RECEIVESISE]
+    ...     print(sise.decode.p99, sise.handoff.p99)     # 나노초
+    ...     print(agent.latency_stats.summary())
+"""
+
+import time
+from dataclasses import dataclass, field
+from typing import Dict, Iterator, Tuple
+
+# ============================================================================
+# 버킷 구성 (로그-선형, HDR 히스토그램 방식)
+# ============================================================================
+#
+# 값 v의 최상위 5비트로 버킷을 정합니다. 2의 거듭제곱 구간마다 16개 버킷이므로
+# 버킷 폭은 값의 1/16 이하이고, 대표값(버킷 중앙)의 상대 오차는 약 3% 이내입니다.
+# 2^40ns(약 18분)를 넘는 값은 마지막 버킷에 모읍니다. (max는 정확한 값 유지)
+
+_SUB_BITS = 5
+_HALF_COUNT = 1 << (_SUB_BITS - 1)     # 16
+_MAX_BITS = 40
+_BUCKET_COUNT = (_MAX_BITS - _SUB_BITS + 2) * _HALF_COUNT
+
+
+def _bucket_index(value: int) -> int:
+    shift = value.bit_length() - _SUB_BITS
+    if shift <= 0:
+        return value
+    index = (shift << (_SUB_BITS - 1)) + (value >> shift)
+    return index if index < _BUCKET_COUNT else _BUCKET_COUNT - 1
+
+
+def _bucket_value(index: int) -> int:
+    """버킷 대표값 (버킷 중앙)"""
+    if index < 2 * _HALF_COUNT:
+        return index
+    shift = (index >> (_SUB_BITS - 1)) - 1
+    lower = (index - (shift << (_SUB_BITS - 1))) << shift
+    return lower + ((1 << shift) >> 1)
+
+
+# ============================================================================
+# LatencyHistogram
+# ============================================================================
+
+class LatencyHistogram:
+    """나노초 지연 히스토그램 (고정 크기, 기록 O(1))
+
+    Attributes:
+        count: 기록한 값 수
+        total: 기록한 값의 합 (나노초)
+        max: 최대값 (나노초, 정확한 값)
+    """
+
+    __slots__ = ("_counts", "count", "total", "max")
+
+    def __init__(self):
+        self._counts = [0] * _BUCKET_COUNT
+        self.count = 0
+        self.total = 0
+        self.max = 0
+
+    def record(self, value: int) -> None:
+        """값 기록 (음수는 0으로 기록)"""
+        if value < 0:
+            value = 0
+        self._counts[_bucket_index(value)] += 1
+        self.count += 1
+        self.total += value
+        if value > self.max:
+            self.max = value
+
+    def percentile(self, percent: float) -> int:
+        """백분위수 (나노초, percent는 0~100). 기록이 없으면 0"""
+        if not 0 <= percent <= 100:
+            raise ValueError(f"percent는 0~100이어야 합니다: {percent}")
+        count = self.count
+        if count == 0:
+            return 0
+        rank = max(1, -int(-percent * count // 100))    # ceil(percent% * count)
+        seen = 0
+        for index, bucket in enumerate(self._counts):
+            seen += bucket
+            if seen >= rank:
+                if index == _BUCKET_COUNT - 1:
+                    return self.max     # 범위를 넘는 값을 모은 버킷
+                return min(_bucket_value(index), self.max)
+        return self.max
+
+    @property
+    def p50(self) -> int:
+        return self.percentile(50)
+
+    @property
+    def p99(self) -> int:
+        return self.percentile(99)
+
+    @property
+    def p999(self) -> int:
+        return self.percentile(99.9)
+
+    @property
+    def mean(self) -> float:
+        """평균 (나노초)"""
+        return self.total / self.count if self.count else 0.0
+
+    def merge(self, other: "LatencyHistogram") -> None:
+        """다른 히스토그램의 기록을 합침"""
+        counts = self._counts
+        for index, bucket in enumerate(other._counts):
+            if bucket:
+                counts[index] += bucket
+        self.count += other.count
+        self.total += other.total
+        if other.max > self.max:
+            self.max = other.max
+
+    def reset(self) -> None:
+        self._counts = [0] * _BUCKET_COUNT
+        self.count = 0
+        self.total = 0
+        self.max = 0
+
+    def snapshot(self) -> Dict[str, int]:
+        """{"count", "p50", "p99", "p999", "max"} (나노초)"""
+        return {
+            "count": self.count,
+            "p50": self.p50,
+            "p99": self.p99,
+            "p999": self.p999,
+            "max": self.max,
+        }
+
+    def __repr__(self) -> str:
+        return (f"LatencyHistogram(count={self.count}, p50={self.p50}, p99={self.p99}, "
+                f"p999={self.p999}, max={self.max})")
+
+
+# ============================================================================
+# 메시지 타입별 구간 통계
+# ============================================================================
+
+STAGES = ("decode", "enqueue", "handoff", "total")
+
+
+@dataclass(slots=True)
+class MessageLatency:
+    """메시지 타입 하나의 구간별 지연 히스토그램 (나노초)"""
+    decode: LatencyHistogram = field(default_factory=LatencyHistogram)
+    enqueue: LatencyHistogram = field(default_factory=LatencyHistogram)
+    handoff: LatencyHistogram = field(default_factory=LatencyHistogram)
+    total: LatencyHistogram = field(default_factory=LatencyHistogram)
+
+    def snapshot(self) -> Dict[str, Dict[str, int]]:
+        return {stage: getattr(self, stage).snapshot() for stage in STAGES}
+
+    def reset(self) -> None:
+        for stage in STAGES:
+            getattr(self, stage).reset()
+
+
+class LatencyStats:
+    """메시지 타입별 MessageLatency 모음 (WMCAAgent.latency_stats)
+
+    message_queue에는 (msg_type, data, t0, t1) 형태로 적재하고, 소비자 쪽에서
+    handoff()로 (msg_type, data)로 되돌리면서 handoff/total을 기록합니다.
+
+    Note:
+        - 처음 수신한 메시지 타입의 항목은 펌프 스레드가 만듭니다. (dict.setdefault는 원자적)
+        - reset()은 수신 중에 호출하면 진행 중인 이벤트 일부가 빠질 수 있습니다.
+    """
+
+    def __init__(self):
+        self._by_type: Dict[int, MessageLatency] = {}
+
+    def __getitem__(self, msg_type: int) -> MessageLatency:
+        """메시지 타입의 구간별 통계 (아직 수신하지 않은 타입이면 빈 통계)"""
+        entry = self._by_type.get(msg_type)
+        return entry if entry is not None else MessageLatency()
+
+    def __contains__(self, msg_type: int) -> bool:
+        return msg_type in self._by_type
+
+    def __iter__(self) -> Iterator[int]:
+        return iter(list(self._by_type))
+
+    def items(self) -> Iterator[Tuple[int, MessageLatency]]:
+        return iter(list(self._by_type.items()))
+
+    def _entry(self, msg_type: int) -> MessageLatency:
+        entry = self._by_type.get(msg_type)
+        if entry is None:
+            entry = self._by_type.setdefault(msg_type, MessageLatency())
+        return entry
+
+    # ------------------------------------------------------------------------
+    # 기록 (WMCAAgent 내부)
+    # ------------------------------------------------------------------------
+
+    def produced(self, msg_type: int, t0: int, t1: int) -> None:
+        """펌프 쪽 기록: put() 반환 직후 호출 (t0 진입, t1 디코딩 완료)"""
+        entry = self._entry(msg_type)
+        entry.decode.record(t1 - t0)
+        entry.enqueue.record(time.perf_counter_ns() - t1)
+
+    def handoff(self, item: tuple) -> tuple:
+        """소비자 쪽 기록: 큐에서 꺼낸 (msg_type, data, t0, t1)을 (msg_type, data)로 변환"""
+        msg_type, data, t0, t1 = item
+        t3 = time.perf_counter_ns()
+        entry = self._entry(msg_type)
+        entry.handoff.record(t3 - t1)
+        entry.total.record(t3 - t0)
+        return msg_type, data
+
+    # ------------------------------------------------------------------------
+    # 조회
+    # ------------------------------------------------------------------------
+
+    def stage(self, name: str) -> LatencyHistogram:
+        """모든 메시지 타입을 합친 구간 히스토그램"""
+        if name not in STAGES:
+            raise ValueError(f"stage는 {STAGES} 중 하나여야 합니다: {name}")
+        merged = LatencyHistogram()
+        for _, entry in self.items():
+            merged.merge(getattr(entry, name))
+        return merged
+
+    def summary(self) -> Dict[str, Dict[str, Dict[str, int]]]:
+        """{메시지 타입 이름: {구간: {"count", "p50", "p99", "p999", "max"}}} (나노초)"""
+        return {
+            getattr(msg_type, "name", str(msg_type)): entry.snapshot()
+            for msg_type, entry in self.items()
+        }
+
+    def reset(self) -> None:
+        for _, entry in self.items():
+            entry.reset()
+
+
+__all__ = [
+    "LatencyHistogram",
+    "MessageLatency",
+    "LatencyStats",
+    "STAGES",
+]
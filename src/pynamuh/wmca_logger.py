@@ -1,65 +1,225 @@
+"""pynamuh 로깅 설정
+
+import 시점에는 핸들러를 붙이지 않고 파일도 만들지 않습니다.
+(설정 전에는 표준 logging 기본 동작: WARNING 이상만 stderr로 출력)
+
+configure_logging()으로 콘솔/파일 출력(sink)과 레벨을 설정하면, 호출 스레드는
+QueueHandler로 레코드를 큐에 넣기만 하고 실제 포맷/쓰기는 백그라운드 스레드
+(QueueListener)가 처리합니다. 메시지 펌프 스레드가 디스크/콘솔 I/O로 막히지 않습니다.
+WMCAAgent는 생성 시 설정이 없으면 기본값(콘솔 INFO)으로 한 번 설정합니다.
+
+logger 레벨은 활성화된 sink 레벨 중 가장 낮은 값으로 맞춰지므로, DEBUG sink가 없으면
+핫패스의 `if logger.isEnabledFor(logging.DEBUG):` 블록은 실행되지 않습니다.
+
+    >>> from pynamuh.wmca_logger import configure_logging, set_level
+    >>> configure_logging(level="INFO", file="logs/wmca.txt", file_level="DEBUG")
+    >>> set_level("WARNING", sink="console")    # 실행 중 레벨 변경
+
+환경 변수 PYNAMUH_LOG_LEVEL로 기본 콘솔 레벨을 지정할 수 있습니다.
+"""
 from pathlib import Path
 from datetime import datetime
-from typing import Literal
+from logging.handlers import QueueHandler, QueueListener
+from typing import Dict, Literal, Optional, Union
+import atexit
 import logging
+import os
+import queue
+import threading
 
 LEVELS = Literal["DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"]
+Sink = Literal["console", "file"]
+
+LOGGER_NAME = "wmca"
+
+# 파일명과 줄 번호 포함
+FORMAT = '[%(levelname)s] %(asctime)s - %(name)s - %(filename)s:%(lineno)d - %(message)s'
+DATE_FORMAT = '%Y-%m-%d %H:%M:%S'
+
+logger = logging.getLogger(LOGGER_NAME)
+
+
+# ============================================================================
+# 설정 상태
+# ============================================================================
+
+class _LoggingState:
+    """logger별 QueueHandler/QueueListener/sink 핸들러"""
+
+    __slots__ = ("queue_handler", "listener", "sinks")
+
+    def __init__(self, queue_handler: QueueHandler, listener: QueueListener, sinks: Dict[str, logging.Handler]):
+        self.queue_handler = queue_handler
+        self.listener = listener
+        self.sinks = sinks
+
+
+_states: Dict[str, _LoggingState] = {}
+_lock = threading.Lock()
+
+
+def _check_level(level: str, arg: str) -> int:
+    if level not in LEVELS.__args__:
+        raise ValueError(f"{arg} must be one of {LEVELS.__args__}")
+    return getattr(logging, level)
+
+
+def _sync_logger_level(target: logging.Logger, state: _LoggingState):
+    """logger 레벨 = sink 레벨 최솟값 (sink가 원하지 않는 레코드는 만들지도 않음)"""
+    target.setLevel(min((h.level for h in state.sinks.values()), default=logging.CRITICAL))
+
+
+def is_configured(name: str = LOGGER_NAME) -> bool:
+    """configure_logging()으로 설정되었는지 여부"""
+    return name in _states
+
+
+def configure_logging(
+    level: LEVELS = "INFO",
+    console: bool = True,
+    file: Union[None, bool, str, Path] = None,
+    file_level: LEVELS = "DEBUG",
+    name: str = LOGGER_NAME
+) -> logging.Logger:
+    """로깅 sink와 레벨 설정 (다시 호출하면 기존 설정을 교체)
+
+    Args:
+        level: 콘솔 출력 레벨
+        console: True면 stderr로 출력
+        file: 로그 파일 경로 (True면 ./logs/<시각>_<name>.txt, None이면 파일 출력 없음)
+        file_level: 파일 출력 레벨
+        name: logger 이름
+
+    Returns:
+        logging.Logger: 설정된 logger
+
+    Raises:
+        ValueError: 레벨이 올바르지 않거나 로그 파일을 만들 수 없는 경우
+    """
+    console_level = _check_level(level, "level")
+    fh_level = _check_level(file_level, "file_level")
+
+    formatter = logging.Formatter(FORMAT, datefmt=DATE_FORMAT)
+    sinks: Dict[str, logging.Handler] = {}
+
+    if console:
+        sh = logging.StreamHandler()
+        sh.setLevel(console_level)
+        sh.setFormatter(formatter)
+        sinks["console"] = sh
+
+    if file:
+        if file is True:
+            file = Path("logs") / (datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + "_" + name + ".txt")
+        fpath = Path(file)
+        try:
+            fpath.parent.mkdir(exist_ok=True, parents=True)
+            fh = logging.FileHandler(fpath, mode='a', encoding='utf-8', delay=True)
+        except OSError:
+            raise ValueError(f"Cannot create or access log file: {fpath}")
+        fh.setLevel(fh_level)
+        fh.setFormatter(formatter)
+        sinks["file"] = fh
+
+    target = logging.getLogger(name)
+    with _lock:
+        _shutdown_locked(name)
+
+        queue_handler = QueueHandler(queue.SimpleQueue())
+        listener = QueueListener(queue_handler.queue, *sinks.values(), respect_handler_level=True)
+        listener.start()
+
+        state = _states[name] = _LoggingState(queue_handler, listener, sinks)
+        target.addHandler(queue_handler)
+        target.propagate = False
+        _sync_logger_level(target, state)
+    return target
+
+
+def set_level(level: LEVELS, sink: Optional[Sink] = None, name: str = LOGGER_NAME):
+    """실행 중 sink 레벨 변경
+
+    Args:
+        level: 새 레벨
+        sink: "console" 또는 "file" (None이면 모든 sink)
+        name: logger 이름
+
+    Raises:
+        ValueError: 설정되지 않았거나 해당 sink가 없는 경우
+    """
+    value = _check_level(level, "level")
+    with _lock:
+        state = _states.get(name)
+        if state is None:
+            raise ValueError(f"logger가 설정되지 않았습니다: {name} (configure_logging() 먼저 호출)")
+        if sink is not None and sink not in state.sinks:
+            raise ValueError(f"설정되지 않은 sink: {sink}")
+        for key, handler in state.sinks.items():
+            if sink is None or key == sink:
+                handler.setLevel(value)
+        _sync_logger_level(logging.getLogger(name), state)
+
+
+def _shutdown_locked(name: str):
+    state = _states.pop(name, None)
+    if state is None:
+        return
+    target = logging.getLogger(name)
+    target.removeHandler(state.queue_handler)
+    state.listener.stop()   # 큐에 남은 레코드를 모두 쓴 뒤 종료
+    for handler in state.sinks.values():
+        handler.close()
+    target.setLevel(logging.NOTSET)
+    target.propagate = True
+
+
+def shutdown_logging(name: Optional[str] = None):
+    """백그라운드 writer 종료 (남은 레코드 flush). 프로세스 종료 시 자동 호출"""
+    with _lock:
+        for key in ([name] if name is not None else list(_states)):
+            _shutdown_locked(key)
+
+
+atexit.register(shutdown_logging)
+
+
+def ensure_configured():
+    """설정된 적이 없으면 기본값으로 설정 (WMCAAgent 생성 시 호출)"""
+    if not is_configured():
+        configure_logging(level=os.environ.get("PYNAMUH_LOG_LEVEL", "INFO"))
+
 
 def get_logger(
-    name: str = "wmca",
-    print: bool = True, print_level: LEVELS = "INFO", 
+    name: str = LOGGER_NAME,
+    print: bool = True, print_level: LEVELS = "INFO",
     file: bool = False, file_level: LEVELS = "DEBUG", file_name: str = None
 ):
+    """이전 인터페이스 호환용. 설정되지 않은 logger면 configure_logging()으로 설정
+
+    file=True면 패키지 디렉터리의 logs/ 아래에 파일을 만듭니다. (이전 동작)
+    """
     if not isinstance(name, str):
         raise TypeError("name must be a string")
-    
-    if print:
-        if print_level not in LEVELS.__args__:
-            raise ValueError(f"print_level must be one of {LEVELS.__args__}")
-        
+    if is_configured(name):
+        return logging.getLogger(name)
+
+    path = None
     if file:
-        if file_level not in LEVELS.__args__:
-            raise ValueError(f"file_level must be one of {LEVELS.__args__}")
-        
         if file_name is None:
             file_name = datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + "_" + name + ".txt"
         if not isinstance(file_name, str):
             raise TypeError("file_name must be a string")
+        path = Path(__file__).parent / "logs" / file_name
 
-        log_dir = Path(__file__).parent / "logs"
-
-        try:
-            log_dir.mkdir(exist_ok=True, parents=True)
-            fpath = log_dir / file_name
-            fpath.touch(exist_ok=True)
-        except OSError:
-            raise ValueError(f"Cannot create or access log file: {file_name}")
-    
-    logger = logging.getLogger(name)
-    logger.setLevel(logging.DEBUG)
-
-    # 이미 핸들러가 있으면 추가하지 않음 (중복 로그 방지)
-    if logger.handlers:
-        return logger
-
-    # 파일명과 줄 번호 포함
-    formatter = logging.Formatter(
-        '[%(levelname)s] %(asctime)s - %(name)s - %(filename)s:%(lineno)d - %(message)s',
-        datefmt='%Y-%m-%d %H:%M:%S'
-    )
-
-    if print:
-        sh = logging.StreamHandler()
-        sh.setLevel(getattr(logging, print_level))
-        sh.setFormatter(formatter)
-        logger.addHandler(sh)
-
-    if file:
-        fh = logging.FileHandler(fpath, mode='a', encoding='utf-8')
-        fh.setLevel(getattr(logging, file_level))
-        fh.setFormatter(formatter)
-        logger.addHandler(fh)
+    return configure_logging(level=print_level, console=print, file=path, file_level=file_level, name=name)
 
-    return logger
 
-logger = get_logger(file=True)
\ No newline at end of file
+__all__ = [
+    "logger",
+    "configure_logging",
+    "set_level",
+    "shutdown_logging",
+    "is_configured",
+    "ensure_configured",
+    "get_logger",
+]
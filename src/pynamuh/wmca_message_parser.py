@@ -5,10 +5,11 @@ WMCA 메시지 파싱 전담 모듈
 Windows 메시지 lparam을 파싱하여 Python 객체로 변환
 """
 
-from .structures.common import LoginBlock, OutDataBlock
-from .wmca_logger import get_logger
+from typing import Union
+
+from .structures.common import LoginBlock, OutDataBlock, FlatOutDataBlock, DecodeMode
+from .wmca_logger import logger
 
-logger = get_logger()
 
 
 # ============================================================================
@@ -38,14 +39,28 @@ class WMCAMessageParser:
     def parse_outdatablock(
         lparam: int, 
         is_receivemessage: bool = False, 
-        is_receivesise: bool = False
-    ) -> OutDataBlock:
+        is_receivesise: bool = False,
+        decode: DecodeMode = "eager",
+        columnar: bool = False,
+        typed: bool = True,
+        envelope: bool = True
+    ) -> Union[OutDataBlock, FlatOutDataBlock]:
         """CA_CONNECTED 메시지 파싱
 
         Args:
             lparam: OUTDATABLOCK 구조체 포인터
+            decode: szData 파싱 방식 ("eager", "lazy", "view", "raw")
+            columnar: True면 반복 블록을 Columns로 파싱
+            typed: False면 모든 필드를 str로 파싱
+            envelope: False면 OutDataBlock/Received 대신 FlatOutDataBlock 반환
 
         Returns:
-            OutDataBlock DTO
+            OutDataBlock DTO (envelope=False면 FlatOutDataBlock)
         """
-        return OutDataBlock.from_lparam(lparam, is_receivemessage, is_receivesise)
\ No newline at end of file
+        if not envelope:
+            return FlatOutDataBlock.from_lparam(
+                lparam, is_receivemessage, is_receivesise, decode, columnar, typed
+            )
+        return OutDataBlock.from_lparam(
+            lparam, is_receivemessage, is_receivesise, decode, columnar, typed
+        )
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+ReplayTransport - TickJournal에 기록된 원시 페이로드 재생
+
+기록된 szData를 실제 DLL과 같은 OUTDATABLOCK 구조체로 다시 만들어 WMCAAgent 이벤트 핸들러에
+넘깁니다. 파싱(decode/typed/columnar/envelope), 큐, threaded 모드, receive_events()/receive_batch()가
+실시간 수신과 동일하게 동작하므로 전략/파서를 Windows와 DLL 없이(Linux 포함) 재현할 수 있습니다.
+
+재생 속도:
+    - speed=1.0: 기록 당시 간격 그대로 (벽시계 기준)
+    - speed=10.0: 10배속 (간격 / speed)
+    - speed=None: 대기 없이 최대한 빠르게 (처리량 측정용)
+
+Example:
+    >>> from pynamuh import WMCAAgent, WMCAMessage, ReplayTransport
+    >>> transport = ReplayTransport("journal/sise_20260105.wj", speed=None)
+    >>> with WMCAAgent(transport=transport) as agent:
+    ...     for msg_type, data in agent.receive_events():   # 재생이 끝나면 종료
+    ...         strategy.on_tick(data.pData.szData)
+
+Note:
+    - 저널에는 TrIndex가 없으므로 재생 이벤트의 TrIndex는 항상 0입니다.
+    - wmcaConnect/wmcaQuery/wmcaAttach 등은 NullDLL이 받아들이기만 하고 응답을 만들지 않습니다.
+"""
+
+import threading
+import time
+from pathlib import Path
+from typing import Iterable, Iterator, Optional, Union
+
+from .wmca_journal import JournalRecord, read_journal
+from .wmca_transport import Transport, EventHandler, OutDataBlockBuffer
+
+# 재생 소스: 저널 파일/디렉터리 경로, 경로 목록, 또는 JournalRecord iterable
+ReplaySource = Union[str, Path, Iterable[Union[str, Path, JournalRecord]]]
+
+
+# speed=None에서 dispatch_pending() 1회당 최대 전달 수 (소비자가 큐를 비울 기회를 줌)
+DEFAULT_BATCH = 1024
+
+
+# ============================================================================
+# ReplayTransport
+# ============================================================================
+
+class ReplayTransport(Transport):
+    """저널 재생 Transport
+
+    Args:
+        source: 저널 파일 경로, 저널 디렉터리(*.wj를 이름순으로), 경로 목록,
+            또는 JournalRecord iterable
+        speed: 재생 배속 (None이면 대기 없이 최대한 빠르게)
+        kind: 지정하면 해당 WMCAMessage 값 레코드만 재생
+        max_gap: 레코드 간격 상한 (초, 재생 배속 적용 전). 장 마감~다음 날 개장처럼
+            긴 공백을 건너뛸 때 사용 (None이면 제한 없음)
+        batch: dispatch_pending() 1회당 최대 전달 수
+
+    Attributes:
+        replayed: 지금까지 전달한 레코드 수
+    """
+
+    def __init__(
+        self,
+        source: ReplaySource,
+        speed: Optional[float] = 1.0,
+        kind: Optional[int] = None,
+        max_gap: Optional[float] = None,
+        batch: int = DEFAULT_BATCH,
+    ):
+        if speed is not None and speed <= 0:
+            raise ValueError(f"speed는 0보다 커야 합니다 (최대 속도는 None): {speed}")
+        if max_gap is not None and max_gap < 0:
+            raise ValueError(f"max_gap은 0 이상이어야 합니다: {max_gap}")
+        if batch <= 0:
+            raise ValueError(f"batch는 1 이상이어야 합니다: {batch}")
+        self.source = source
+        self.speed = speed
+        self.kind = kind
+        self.max_gap_ns = None if max_gap is None else int(max_gap * 1e9)
+        self.batch = batch
+        self.hwnd = 0
+        self.replayed = 0
+
+        self._handler: Optional[EventHandler] = None
+        self._records: Optional[Iterator[JournalRecord]] = None
+        self._next: Optional[JournalRecord] = None  # 다음에 전달할 레코드
+        self._next_due = 0.0                          # _next 전달 시각 (time.monotonic)
+        self._start = 0.0                             # 재생 시작 시각 (time.monotonic)
+        self._base_ns = 0                             # 첫 레코드 wall_ns (+ 건너뛴 공백)
+        self._prev_ns = 0                             # 직전 레코드 wall_ns
+        self._wakeup = threading.Event()
+
+        self._buffer = OutDataBlockBuffer()     # 레코드마다 재사용하는 OUTDATABLOCK
+
+    # ========================================================================
+    # 레코드 순회
+    # ========================================================================
+
+    def _iter_source(self) -> Iterator[JournalRecord]:
+        source = self.source
+        if isinstance(source, (str, Path)):
+            path = Path(source)
+            source = sorted(path.glob("*.wj")) if path.is_dir() else [path]
+        for item in source:
+            if isinstance(item, (str, Path)):
+                yield from read_journal(item, self.kind)
+            elif self.kind is None or item.kind == self.kind:
+                yield item
+
+    def _advance(self):
+        """다음 레코드와 전달 시각 계산"""
+        record = next(self._records, None)
+        self._next = record
+        if record is None or self.speed is None:
+            return
+        if self._prev_ns == 0:
+            self._base_ns = record.wall_ns
+        elif self.max_gap_ns is not None:
+            gap = record.wall_ns - self._prev_ns
+            if gap > self.max_gap_ns:
+                self._base_ns += gap - self.max_gap_ns
+        self._prev_ns = record.wall_ns
+        self._next_due = self._start + (record.wall_ns - self._base_ns) / 1e9 / self.speed
+
+    # ========================================================================
+    # Transport
+    # ========================================================================
+
+    def open(self, handler: EventHandler) -> None:
+        self._handler = handler
+        self._records = self._iter_source()
+        self._start = time.monotonic()
+        self._prev_ns = 0
+        self.replayed = 0
+        self._wakeup.clear()
+        self._advance()
+
+    def close(self) -> None:
+        if self._records is not None:
+            self._records.close()   # 저널 파일 mmap 닫기
+        self._records = None
+        self._next = None
+
+    def _dispatch(self, record: JournalRecord):
+        """레코드를 OUTDATABLOCK에 채워 handler 호출 (포인터는 handler 반환까지만 유효)"""
+        self._handler(record.kind, self._buffer.fill(0, record.block_name, record.data))
+
+    def _dispatch_due(self, limit: int) -> int:
+        count = 0
+        now = time.monotonic()
+        while count < limit and self._next is not None:
+            if self.speed is not None and self._next_due > now:
+                break
+            self._dispatch(self._next)
+            count += 1
+            self._advance()
+        self.replayed += count
+        return count
+
+    def dispatch_pending(self) -> int:
+        return self._dispatch_due(self.batch)
+
+    def dispatch_one(self) -> int:
+        return self._dispatch_due(1)
+
+    def wait(self, timeout: Optional[float]) -> bool:
+        if self._next is None:
+            return False    # 재생 종료 (exhausted)
+        if self.speed is None:
+            return True
+        delay = self._next_due - time.monotonic()
+        if delay <= 0:
+            return True
+        if timeout is not None and timeout < delay:
+            self._wakeup.wait(timeout)
+            self._wakeup.clear()
+            return False
+        self._wakeup.wait(delay)
+        self._wakeup.clear()
+        return True
+
+    def wake(self) -> None:
+        self._wakeup.set()
+
+    @property
+    def exhausted(self) -> bool:
+        """모든 레코드를 전달했는지 여부"""
+        return self._records is not None and self._next is None
+
+
+__all__ = [
+    "ReplayTransport",
+    "ReplaySource",
+]
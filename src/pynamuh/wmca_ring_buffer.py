@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+단일 생산자/단일 소비자(SPSC) 링 버퍼
+메시지 펌프 스레드 → 소비자 스레드 간 이벤트 전달용
+"""
+
+import asyncio
+import queue
+import threading
+import time
+from dataclasses import dataclass
+from typing import Any, Callable, List, Optional
+
+
+# ============================================================================
+# 전달 지연/큐 깊이 통계
+# ============================================================================
+
+@dataclass
+class HandoffStats:
+    """펌프 → 소비자 전달 통계
+
+    Attributes:
+        count: 소비자가 꺼낸 이벤트 수
+        total_latency_ns: 누적 전달 지연 (put → get, 나노초)
+        max_latency_ns: 최대 전달 지연 (나노초)
+        last_latency_ns: 마지막 이벤트의 전달 지연 (나노초)
+        max_depth: 관측된 최대 큐 깊이
+        producer_waits: 버퍼가 가득 차 생산자가 대기한 횟수
+        closed_drops: 버퍼가 닫혀 버린 이벤트 수 (종료 중 도착한 이벤트)
+    """
+    count: int = 0
+    total_latency_ns: int = 0
+    max_latency_ns: int = 0
+    last_latency_ns: int = 0
+    max_depth: int = 0
+    producer_waits: int = 0
+    closed_drops: int = 0
+
+    @property
+    def avg_latency_ns(self) -> float:
+        """평균 전달 지연 (나노초)"""
+        return self.total_latency_ns / self.count if self.count else 0.0
+
+
+# ============================================================================
+# SPSCRingBuffer
+# ============================================================================
+
+class SPSCRingBuffer:
+    """고정 크기 단일 생산자/단일 소비자 링 버퍼
+
+    - 생산자는 _tail만, 소비자는 _head만 갱신하므로 put/get 경로에 락이 없습니다.
+      (CPython에서 정수/리스트 원소 대입은 원자적)
+    - 대기(블로킹)가 필요한 경우에만 threading.Event로 상대 스레드를 깨웁니다.
+    - queue.Queue와 같은 get_nowait/empty/qsize 인터페이스를 제공하여
+      WMCAAgent.message_queue를 그대로 대체할 수 있습니다.
+
+    Example:
+        >>> ring = SPSCRingBuffer(capacity=4096)
+        >>> ring.put(("j8", data))          # 펌프 스레드
+        >>> item = ring.get(timeout=1.0)    # 소비자 스레드
+    """
+
+    def __init__(self, capacity: int = 65536):
+        """
+        Args:
+            capacity: 버퍼 크기 (2의 거듭제곱으로 올림)
+        """
+        if capacity <= 0:
+            raise ValueError(f"capacity는 1 이상이어야 합니다: {capacity}")
+
+        size = 1
+        while size < capacity:
+            size <<= 1
+
+        self.capacity = size
+        self._mask = size - 1
+        self._items: List[Any] = [None] * size
+        self._stamps: List[int] = [0] * size
+
+        self._head = 0  # 소비자만 갱신
+        self._tail = 0  # 생산자만 갱신
+
+        self._not_empty = threading.Event()
+        self._not_full = threading.Event()
+        self._consumer_waiting = False
+        self._producer_waiting = False
+        self._closed = False
+        self._async_wake: Optional[Callable[[], None]] = None   # wait_async() 대기 중일 때만 설정
+
+        self.stats = HandoffStats()
+
+    # ------------------------------------------------------------------------
+    # 상태 조회
+    # ------------------------------------------------------------------------
+
+    def qsize(self) -> int:
+        """현재 큐 깊이"""
+        return self._tail - self._head
+
+    def empty(self) -> bool:
+        return self._tail == self._head
+
+    def full(self) -> bool:
+        return self._tail - self._head >= self.capacity
+
+    @property
+    def closed(self) -> bool:
+        return self._closed
+
+    # ------------------------------------------------------------------------
+    # 생산자 (펌프 스레드)
+    # ------------------------------------------------------------------------
+
+    def put_nowait(self, item: Any) -> None:
+        """이벤트 추가 (버퍼가 가득 차면 queue.Full)"""
+        tail = self._tail
+        depth = tail - self._head
+        if depth >= self.capacity:
+            raise queue.Full
+
+        idx = tail & self._mask
+        self._items[idx] = item
+        self._stamps[idx] = time.perf_counter_ns()
+        self._tail = tail + 1
+
+        if depth + 1 > self.stats.max_depth:
+            self.stats.max_depth = depth + 1
+        if self._consumer_waiting:
+            self._not_empty.set()
+            self._wake_async()
+
+    def put(self, item: Any, timeout: Optional[float] = None) -> None:
+        """이벤트 추가 (버퍼가 가득 차면 소비자가 꺼낼 때까지 대기)
+
+        버퍼가 닫히면(종료 중) 대기하지 않고 이벤트를 버립니다. (stats.closed_drops)
+
+        Raises:
+            queue.Full: timeout 내에 빈 자리가 생기지 않은 경우
+        """
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while True:
+            if self._closed:
+                self.stats.closed_drops += 1
+                return
+            try:
+                self.put_nowait(item)
+                return
+            except queue.Full:
+                pass
+
+            self.stats.producer_waits += 1
+            self._not_full.clear()
+            self._producer_waiting = True
+            try:
+                if not self.full() or self._closed:
+                    continue
+                remaining = None if deadline is None else deadline - time.monotonic()
+                if remaining is not None and remaining <= 0:
+                    raise queue.Full
+                self._not_full.wait(remaining)
+            finally:
+                self._producer_waiting = False
+
+    # ------------------------------------------------------------------------
+    # 소비자
+    # ------------------------------------------------------------------------
+
+    def get_nowait(self) -> Any:
+        """이벤트 꺼내기 (비어 있으면 queue.Empty)"""
+        head = self._head
+        if head == self._tail:
+            raise queue.Empty
+
+        idx = head & self._mask
+        item = self._items[idx]
+        latency = time.perf_counter_ns() - self._stamps[idx]
+        self._items[idx] = None
+        self._head = head + 1
+
+        stats = self.stats
+        stats.count += 1
+        stats.total_latency_ns += latency
+        stats.last_latency_ns = latency
+        if latency > stats.max_latency_ns:
+            stats.max_latency_ns = latency
+
+        if self._producer_waiting:
+            self._not_full.set()
+        return item
+
+    def wait(self, timeout: Optional[float] = None) -> bool:
+        """이벤트가 들어올 때까지 대기
+
+        Args:
+            timeout: 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            bool: 이벤트 존재 여부 (False면 timeout 또는 close)
+        """
+        if self._tail != self._head:
+            return True
+        if self._closed:
+            return False
+
+        self._not_empty.clear()
+        self._consumer_waiting = True
+        try:
+            if self._tail != self._head:
+                return True
+            self._not_empty.wait(timeout)
+        finally:
+            self._consumer_waiting = False
+        return self._tail != self._head
+
+    async def wait_async(self, timeout: Optional[float] = None) -> bool:
+        """wait()의 asyncio 버전 (이벤트 루프 스레드에서 호출)
+
+        생산자가 loop.call_soon_threadsafe()로 한 번만 깨우므로 폴링하지 않습니다.
+
+        Args:
+            timeout: 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            bool: 이벤트 존재 여부 (False면 timeout 또는 close)
+        """
+        if self._tail != self._head:
+            return True
+        if self._closed:
+            return False
+
+        loop = asyncio.get_running_loop()
+        ready = asyncio.Event()
+        self._async_wake = lambda: loop.call_soon_threadsafe(ready.set)
+        self._consumer_waiting = True
+        try:
+            if self._tail == self._head and not self._closed:
+                try:
+                    await asyncio.wait_for(ready.wait(), timeout)
+                except asyncio.TimeoutError:
+                    pass
+        finally:
+            self._consumer_waiting = False
+            self._async_wake = None
+        return self._tail != self._head
+
+    def _wake_async(self) -> None:
+        """wait_async() 대기 중인 이벤트 루프를 한 번만 깨움"""
+        wake = self._async_wake
+        if wake is not None:
+            self._async_wake = None
+            try:
+                wake()
+            except RuntimeError:
+                pass    # 이벤트 루프가 이미 닫힘
+
+    def get(self, timeout: Optional[float] = None) -> Any:
+        """이벤트 꺼내기 (비어 있으면 timeout까지 대기, 시간 초과 시 queue.Empty)"""
+        if not self.wait(timeout):
+            raise queue.Empty
+        return self.get_nowait()
+
+    # ------------------------------------------------------------------------
+    # 종료
+    # ------------------------------------------------------------------------
+
+    def close(self) -> None:
+        """버퍼 닫기 - 대기 중인 생산자/소비자를 모두 깨움"""
+        self._closed = True
+        self._not_empty.set()
+        self._not_full.set()
+        self._wake_async()
+
+
+__all__ = [
+    "HandoffStats",
+    "SPSCRingBuffer",
+]
@@ -0,0 +1,397 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryScheduler - TR 조회 요청 속도 제한과 우선순위
+
+WMCAAgent.query()는 wmcaQuery를 즉시 호출하므로 조회를 몰아서 보내면 증권사의 TR 초당 제한에
+걸려 거부되고 재시도로 시간을 잃습니다. QueryScheduler는 요청을 큐에 받아 TR 코드별/전체 한도
+안에서만 submit_query()를 호출하고, 주문 TR을 조회 TR보다 먼저 보냅니다.
+
+    - 한도: RateLimit(count, per) = per초 동안 최대 count건 (슬라이딩 윈도우)
+    - 순서: 우선순위(Priority)가 높은 요청 먼저, 같은 우선순위는 먼저 들어온 요청 먼저.
+      맨 앞 요청의 TR 코드가 한도에 걸려 있으면 보낼 수 있는 다른 TR 코드 요청을 먼저 보냄
+    - wmcaQuery 호출 실패(RuntimeError)는 retry_delay 후 max_retries회까지 다시 시도
+    - 큐 대기 시간(submit → wmcaQuery 호출)을 TR 코드별 히스토그램으로 집계
+
+Example:
+    >>> scheduler = QueryScheduler(
+    ...     agent,
+    ...     limits={"c8201": RateLimit(2, 1.0)},
+    ...     global_limit=RateLimit(10, 1.0),
+    ... )
+    >>> futures = [scheduler.submit("c1101", inblock) for inblock in inblocks]
+    >>> order = scheduler.submit("c8102", order_inblock, nAccountIndex=1)   # 조회보다 먼저 전송
+    >>> print(order.result(timeout=5.0).message, order.wait_ns)
+    >>> print(scheduler.stats.wait.p99)
+    >>> scheduler.close()
+
+Note:
+    - 전송은 전용 스레드(wmca-scheduler)가 수행합니다.
+    - 반환하는 ScheduledQuery는 QueryFuture이므로 기본 모드(threaded=False)에서 윈도우를 만든
+      스레드가 result()를 호출하면 메시지 펌프를 직접 돌립니다.
+    - 전송 전에 cancel()하면 큐에서 빠지고, 전송 후에 cancel()하면 해당 TrIndex가 취소됩니다.
+"""
+
+import threading
+import time
+from collections import deque
+from dataclasses import dataclass, field
+from enum import IntEnum
+from typing import Deque, Dict, Iterable, Optional, Tuple
+
+from .wmca_logger import logger
+from .wmca_correlator import QueryFuture, forward_future, _resolve
+from .wmca_latency import LatencyHistogram
+from .structures.common import InBlock
+
+
+# ============================================================================
+# 설정
+# ============================================================================
+
+class Priority(IntEnum):
+    """요청 우선순위 (값이 작을수록 먼저 전송)"""
+    ORDER = 0       # 주문/정정/취소
+    HIGH = 1
+    NORMAL = 2      # 일반 조회 (기본값)
+    LOW = 3         # 백그라운드 조회
+
+
+# 주문 TR (주문_SPEC 기준 현금 매도/매수/정정/취소). priority를 지정하지 않으면 Priority.ORDER
+ORDER_TR_CODES = frozenset(("c8101", "c8102", "c8103", "c8104"))
+
+
+@dataclass(frozen=True)
+class RateLimit:
+    """per초 동안 최대 count건"""
+    count: int
+    per: float = 1.0
+
+    def __post_init__(self):
+        if self.count <= 0 or self.per <= 0:
+            raise ValueError(f"RateLimit은 count와 per가 0보다 커야 합니다: {self.count}/{self.per}")
+
+
+class _Window:
+    """슬라이딩 윈도우 전송 기록"""
+    __slots__ = ("limit", "sent")
+
+    def __init__(self, limit: RateLimit):
+        self.limit = limit
+        self.sent: Deque[float] = deque()
+
+    def available_at(self, now: float) -> float:
+        """다음 전송 가능 시각 (지금 가능하면 now)"""
+        sent = self.sent
+        horizon = now - self.limit.per
+        while sent and sent[0] <= horizon:
+            sent.popleft()
+        if len(sent) < self.limit.count:
+            return now
+        return sent[0] + self.limit.per
+
+    def record(self, now: float):
+        self.sent.append(now)
+
+
+# ============================================================================
+# ScheduledQuery / 통계
+# ============================================================================
+
+class ScheduledQuery(QueryFuture):
+    """스케줄러에 넣은 TR 조회 (tr_index는 전송 후 설정)
+
+    Attributes:
+        priority: 우선순위
+        attempts: wmcaQuery 호출 시도 횟수
+        queued_at: submit 시각 (time.monotonic)
+        dispatched_at: 전송 시각 (time.monotonic, 전송 전이면 None)
+    """
+
+    def __init__(self, tr_code: str, szInput: InBlock, nAccountIndex: int, priority: int, seq: int, pump=None):
+        super().__init__(None, tr_code, pump)
+        self.szInput = szInput
+        self.nAccountIndex = nAccountIndex
+        self.priority = priority
+        self.seq = seq
+        self.attempts = 0
+        self.queued_at = time.monotonic()
+        self.not_before = self.queued_at
+        self.dispatched_at: Optional[float] = None
+        self.inner: Optional[QueryFuture] = None
+
+    @property
+    def wait_ns(self) -> Optional[int]:
+        """큐 대기 시간 (나노초, 전송 전이면 None)"""
+        if self.dispatched_at is None:
+            return None
+        return int((self.dispatched_at - self.queued_at) * 1e9)
+
+
+@dataclass
+class SchedulerStats:
+    """QueryScheduler 통계
+
+    Attributes:
+        submitted: submit() 건수
+        dispatched: wmcaQuery 호출 성공 건수
+        retries: wmcaQuery 호출 실패 후 재시도 건수
+        failed: 재시도를 모두 실패한 건수
+        cancelled: 전송 전에 취소된 건수
+        throttled: 한도 때문에 전송을 미룬 횟수
+        wait: 큐 대기 시간 히스토그램 (나노초, 전체)
+        wait_by_code: TR 코드별 큐 대기 시간 히스토그램
+    """
+    submitted: int = 0
+    dispatched: int = 0
+    retries: int = 0
+    failed: int = 0
+    cancelled: int = 0
+    throttled: int = 0
+    wait: LatencyHistogram = field(default_factory=LatencyHistogram)
+    wait_by_code: Dict[str, LatencyHistogram] = field(default_factory=dict)
+
+
+# ============================================================================
+# QueryScheduler
+# ============================================================================
+
+class QueryScheduler:
+    """속도 제한/우선순위 TR 조회 스케줄러
+
+    Args:
+        agent: WMCAAgent
+        limits: TR 코드별 한도 (예: {"c8201": RateLimit(2, 1.0)})
+        default_limit: limits에 없는 TR 코드의 한도 (None이면 제한 없음)
+        global_limit: 모든 TR을 합친 한도 (None이면 제한 없음)
+        order_codes: priority를 지정하지 않았을 때 Priority.ORDER로 보낼 TR 코드
+        max_retries: wmcaQuery 호출 실패 시 재시도 횟수
+        retry_delay: 재시도 전 대기 시간 (초)
+    """
+
+    def __init__(
+        self,
+        agent,
+        limits: Optional[Dict[str, RateLimit]] = None,
+        default_limit: Optional[RateLimit] = None,
+        global_limit: Optional[RateLimit] = None,
+        order_codes: Iterable[str] = ORDER_TR_CODES,
+        max_retries: int = 2,
+        retry_delay: float = 0.2,
+    ):
+        if max_retries < 0 or retry_delay < 0:
+            raise ValueError("max_retries와 retry_delay는 0 이상이어야 합니다")
+        self.agent = agent
+        self.limits = dict(limits or {})
+        self.default_limit = default_limit
+        self.order_codes = frozenset(order_codes)
+        self.max_retries = max_retries
+        self.retry_delay = retry_delay
+        self.stats = SchedulerStats()
+
+        self._global = _Window(global_limit) if global_limit is not None else None
+        self._windows: Dict[str, Optional[_Window]] = {}
+        self._queues: Dict[Tuple[int, str], Deque[ScheduledQuery]] = {}
+        self._seq = 0
+        self._cond = threading.Condition()
+        self._closed = False
+        self._drain = False             # close(cancel_pending=False): 남은 요청을 모두 전송한 뒤 종료
+        self._thread: Optional[threading.Thread] = None
+
+    def __enter__(self) -> "QueryScheduler":
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+        return False
+
+    # ========================================================================
+    # 요청
+    # ========================================================================
+
+    def submit(
+        self, szTRCode: str, szInput: InBlock, nAccountIndex: int = 0, priority: Optional[int] = None
+    ) -> ScheduledQuery:
+        """
+        TR 조회를 큐에 넣고 future 반환 (한도 안에서 우선순위 순으로 전송)
+
+        Args:
+            szTRCode: 서비스 코드 (5자리, 예: "c1101", "c8201")
+            szInput: TR 입력 데이터 (InBlock 기반 Pydantic 모델)
+            nAccountIndex: 계좌 인덱스 (0: 계좌번호 불필요, 1~: 로그인 시 받은 계좌 순서)
+            priority: 우선순위 (None이면 order_codes는 Priority.ORDER, 나머지는 Priority.NORMAL)
+
+        Returns:
+            ScheduledQuery: result()는 QueryResult (submit_query()와 동일)
+        """
+        if priority is None:
+            priority = Priority.ORDER if szTRCode in self.order_codes else Priority.NORMAL
+        pump = None if self.agent.threaded else self.agent._pump_until_done
+        with self._cond:
+            if self._closed:
+                raise RuntimeError("닫힌 QueryScheduler입니다")
+            self._seq += 1
+            request = ScheduledQuery(szTRCode, szInput, nAccountIndex, int(priority), self._seq, pump)
+            self._queues.setdefault((request.priority, szTRCode), deque()).append(request)
+            self.stats.submitted += 1
+            if self._thread is None:
+                self._thread = threading.Thread(target=self._run, name="wmca-scheduler", daemon=True)
+                self._thread.start()
+            self._cond.notify()
+        request.add_done_callback(self._on_done)
+        return request
+
+    @property
+    def queue_depth(self) -> int:
+        """전송 대기 중인 요청 수"""
+        with self._cond:
+            return sum(len(queue) for queue in self._queues.values())
+
+    def _on_done(self, request: ScheduledQuery):
+        if not request.cancelled():
+            return
+        if request.inner is not None:
+            request.inner.cancel()      # 전송 후 취소: TrIndex 취소 (늦은 응답은 correlator가 버림)
+            return
+        with self._cond:
+            self.stats.cancelled += 1
+            self._cond.notify()         # 큐에서 정리
+
+    # ========================================================================
+    # 전송 스레드
+    # ========================================================================
+
+    def _window(self, tr_code: str) -> Optional[_Window]:
+        if tr_code not in self._windows:
+            limit = self.limits.get(tr_code, self.default_limit)
+            self._windows[tr_code] = _Window(limit) if limit is not None else None
+        return self._windows[tr_code]
+
+    def _select(self, now: float) -> Tuple[Optional[ScheduledQuery], Optional[float]]:
+        """지금 보낼 요청, 없으면 (None, 다음 확인까지 대기 시간) - _cond 잡은 상태에서 호출"""
+        best: Optional[ScheduledQuery] = None
+        wake_at: Optional[float] = None
+        throttled = False
+        for key in list(self._queues):
+            queue = self._queues[key]
+            while queue and queue[0].cancelled():
+                queue.popleft()
+            if not queue:
+                del self._queues[key]
+                continue
+            head = queue[0]
+            if best is not None and (head.priority, head.seq) > (best.priority, best.seq):
+                continue
+            ready_at = head.not_before
+            window = self._window(head.tr_code)
+            if window is not None:
+                ready_at = max(ready_at, window.available_at(now))
+            if ready_at > now:
+                throttled = throttled or ready_at > head.not_before
+                wake_at = ready_at if wake_at is None else min(wake_at, ready_at)
+                continue
+            best = head
+
+        if best is not None and self._global is not None:
+            ready_at = self._global.available_at(now)
+            if ready_at > now:
+                best, throttled = None, True
+                wake_at = ready_at if wake_at is None else min(wake_at, ready_at)
+        if best is None:
+            if throttled:
+                self.stats.throttled += 1
+            return None, None if wake_at is None else max(wake_at - now, 0.0)
+
+        self._queues[(best.priority, best.tr_code)].popleft()
+        window = self._window(best.tr_code)
+        if window is not None:
+            window.record(now)
+        if self._global is not None:
+            self._global.record(now)
+        return best, None
+
+    def _run(self):
+        while True:
+            with self._cond:
+                while True:
+                    if self._closed and not self._drain:
+                        return
+                    request, wait = self._select(time.monotonic())
+                    if request is not None:
+                        break
+                    if self._closed and not self._queues:
+                        return          # 남은 요청 전송 완료
+                    self._cond.wait(wait)
+            self._dispatch(request)
+
+    def _dispatch(self, request: ScheduledQuery):
+        request.attempts += 1
+        try:
+            inner = self.agent.submit_query(request.tr_code, request.szInput, request.nAccountIndex)
+        except Exception as e:
+            if request.attempts <= self.max_retries and not request.cancelled():
+                logger.warning("TR 전송 실패, %.3f초 후 재시도 (%s/%s): %s - %s",
+                               self.retry_delay, request.attempts, self.max_retries, request.tr_code, e)
+                request.not_before = time.monotonic() + self.retry_delay
+                with self._cond:
+                    self.stats.retries += 1
+                    self._queues.setdefault((request.priority, request.tr_code), deque()).appendleft(request)
+                    self._cond.notify()
+                return
+            with self._cond:
+                self.stats.failed += 1
+            _resolve(request, exception=e)
+            return
+
+        request.dispatched_at = time.monotonic()
+        request.tr_index = inner.tr_index
+        request.inner = inner
+        wait_ns = request.wait_ns
+        with self._cond:
+            stats = self.stats
+            stats.dispatched += 1
+            stats.wait.record(wait_ns)
+            by_code = stats.wait_by_code.get(request.tr_code)
+            if by_code is None:
+                by_code = stats.wait_by_code[request.tr_code] = LatencyHistogram()
+            by_code.record(wait_ns)
+        if request.cancelled():
+            inner.cancel()
+            return
+        inner.add_done_callback(lambda done: forward_future(done, request))
+
+    # ========================================================================
+    # 종료
+    # ========================================================================
+
+    def close(self, cancel_pending: bool = True) -> None:
+        """전송 스레드 종료 (이후 submit()은 RuntimeError)
+
+        Args:
+            cancel_pending: True면 아직 전송하지 않은 요청을 취소,
+                False면 남은 요청을 한도 안에서 모두 전송(재시도 포함)할 때까지 기다린 뒤 종료
+        """
+        with self._cond:
+            self._closed = True
+            self._drain = not cancel_pending
+            pending = []
+            if cancel_pending:
+                pending = [request for queue in self._queues.values() for request in queue]
+                self._queues.clear()
+            self._cond.notify_all()
+        if cancel_pending:
+            for request in pending:
+                request.cancel()
+        if self._thread is not None and self._thread is not threading.current_thread():
+            self._thread.join()
+            self._thread = None
+
+
+__all__ = [
+    "QueryScheduler",
+    "ScheduledQuery",
+    "SchedulerStats",
+    "RateLimit",
+    "Priority",
+    "ORDER_TR_CODES",
+]
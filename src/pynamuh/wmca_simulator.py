@@ -0,0 +1,513 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+SimulatorTransport - wmca.dll 대체 시뮬레이터 (부하/지연 테스트용)
+
+wmcaConnect/wmcaQuery/wmcaAttach/wmcaDetach/wmcaSetAccountIndexPwd를 흉내 내고,
+실제 DLL과 같은 레이아웃의 LOGINBLOCK/OUTDATABLOCK 이벤트를 WMCAAgent 핸들러로 보냅니다.
+펌프 → 파싱 → 큐 → 소비자 경로 전체를 Windows와 서버 없이(Linux, CI 포함) 측정할 수 있습니다.
+
+- wmcaConnect: latency 후 CA_CONNECTED (LOGINBLOCK, accounts개 계좌)
+- wmcaQuery: latency 후 CA_RECEIVEMESSAGE → 등록된 "{TR코드}OutBlock*" 블록마다 CA_RECEIVEDATA
+  → CA_RECEIVECOMPLETE (반복 블록은 array_rows건). 등록되지 않은 TR은 CA_RECEIVEERROR
+- wmcaAttach: 구독(실시간 코드, 종목)마다 초당 tick_rate건 CA_RECEIVESISE
+  (j8은 종목별 랜덤워크 체결, 그 외 등록된 실시간 블록은 필드 타입에 맞는 임의 값)
+- wmcaDetach: 해당 구독의 시세 중단
+- wmcaSetAccountIndexPwd: 44자 해시 (SHA-256 base64)
+
+Example:
+    >>> from pynamuh import WMCAAgent, WMCAMessage
+    >>> from pynamuh.wmca_simulator import SimulatorTransport
+    >>> sim = SimulatorTransport(tick_rate=5000, max_ticks=100_000)
+    >>> with WMCAAgent(transport=sim, threaded=True) as agent:
+    ...     agent.connect("user", "pw", "cert")
+    ...     agent.attach("j8", "005930000660", 6, 12)
+    ...     for msg_type, data in agent.receive_events():   # max_ticks건 후 종료
+    ...         ...
+    >>> print(agent.pump_stats.events_per_sec)
+
+Note:
+    - 시세는 구독마다 pool_size건을 미리 만들어 두고 순환하므로 생성 비용이 측정에 섞이지 않습니다.
+    - 소비자가 느려 밀리면 밀린 만큼 한 번에 몰아서 보냅니다. (DLL 메시지 큐가 쌓이는 것과 같음)
+"""
+
+import base64
+import ctypes
+import dataclasses
+import hashlib
+import heapq
+import itertools
+import random
+import threading
+import time
+import typing
+from datetime import datetime, time as dtime
+from decimal import Decimal
+from typing import Any, Dict, List, Optional, Tuple, Type
+
+from .wmca_logger import logger
+from .wmca_agent import WMCAMessage
+from .wmca_transport import Transport, EventHandler, OutDataBlockBuffer
+from .structures.common import CLoginInfo, CLoginBlock, CMsgHeader
+from .structures.parser_info import BlockInfo, lookup_block, registered_blocks
+
+# speed 제한 없는 시세(tick_rate=None)에서 dispatch_pending() 1회당 최대 전달 수
+DEFAULT_BATCH = 1024
+
+# 실시간 szData 앞 3바이트 (실시간 코드 2자리 + 구분자)
+_SISE_SEPARATOR = b"|"
+
+_SERVER_NAME = b"SIMULATOR"
+
+
+# ============================================================================
+# 레코드 생성
+# ============================================================================
+
+def render_record(struct_class: Type[ctypes.Structure], values: Dict[str, str]) -> bytes:
+    """C 구조체 레이아웃의 레코드 bytes 생성 (공백 초기화 후 필드 값을 오른쪽 정렬로 기록)"""
+    record = bytearray(b" " * ctypes.sizeof(struct_class))
+    for name, ctype in struct_class._fields_:
+        if name.startswith("_") or name not in values:
+            continue
+        width = ctypes.sizeof(ctype)
+        offset = getattr(struct_class, name).offset
+        encoded = values[name].encode("cp949")[:width]
+        record[offset:offset + width] = encoded.rjust(width)
+    return bytes(record)
+
+
+def _field_types(info: BlockInfo) -> Dict[str, Any]:
+    """OutBlock 필드명 → 타입 (Optional 제거)"""
+    hints = typing.get_type_hints(info.model_class)
+    types = {}
+    for f in dataclasses.fields(info.model_class):
+        hint = hints.get(f.name, str)
+        args = [a for a in typing.get_args(hint) if a is not type(None)]
+        types[f.name] = args[0] if typing.get_origin(hint) is typing.Union and args else hint
+    return types
+
+
+def _synth_value(hint: Any, width: int, rng: random.Random) -> str:
+    """필드 타입과 너비에 맞는 임의 값"""
+    if hint is int:
+        return str(rng.randrange(10 ** min(width - 1, 9) if width > 1 else 10))
+    if hint is Decimal:
+        return f"{rng.uniform(0, 100):.2f}"[:width]
+    if hint is dtime:
+        return datetime.now().strftime("%H%M%S%f")[:width]
+    digits = min(width, 6)
+    return f"{rng.randrange(10 ** digits):0{digits}d}"
+
+
+def synth_record(info: BlockInfo, rng: random.Random, values: Optional[Dict[str, str]] = None) -> bytes:
+    """등록된 블록 레이아웃의 임의 레코드 (values로 지정한 필드는 그대로 사용)"""
+    values = dict(values or {})
+    sign_field = getattr(info.model_class, "SIGN_FIELD", None)
+    if sign_field:
+        values.setdefault(sign_field, "2")   # 상승
+    sizes = {name: ctypes.sizeof(ctype) for name, ctype in info.struct_class._fields_}
+    for name, hint in _field_types(info).items():
+        if name not in values and name in sizes:
+            values[name] = _synth_value(hint, sizes[name], rng)
+    return render_record(info.struct_class, values)
+
+
+def _j8_ticks(info: BlockInfo, code: str, count: int, rng: random.Random) -> List[bytes]:
+    """j8 체결 시세 count건 (종목별 랜덤워크)"""
+    prev_close = rng.randrange(500, 20000) * 10
+    price = open_ = high = low = prev_close
+    volume = value = 0
+    clock = datetime.now()
+    ticks = []
+    for i in range(count):
+        price = max(10, price + rng.choice((-2, -1, 0, 0, 1, 2)) * 10)
+        high, low = max(high, price), min(low, price)
+        qty = rng.randrange(1, 500)
+        volume += qty
+        value += price * qty
+        change = price - prev_close
+        sign = "2" if change > 0 else "5" if change < 0 else "3"
+        stamp = clock.strftime("%H%M%S") + f"{(clock.microsecond // 10000 + i) % 100:02d}"
+        ticks.append(render_record(info.struct_class, {
+            "code": code, "time": stamp, "sign": sign, "change": str(abs(change)),
+            "price": str(price), "chrate": f"{abs(change) / prev_close * 100:.2f}",
+            "high": str(high), "low": str(low), "offer": str(price + 10), "bid": str(price),
+            "volume": str(volume), "volrate": f"{rng.uniform(50, 150):.2f}", "movolume": str(qty),
+            "value": str(value // 1_000_000), "open": str(open_), "avgprice": str(value // volume),
+            "janggubun": "1",
+        }))
+    return ticks
+
+
+# ============================================================================
+# 구독
+# ============================================================================
+
+class _Subscription:
+    """실시간 구독 (실시간 코드, 종목) - 미리 만든 szData를 순환"""
+
+    __slots__ = ("bc", "code", "name", "pool", "pos")
+
+    def __init__(self, bc: str, code: str, pool: List[bytes]):
+        self.bc = bc
+        self.code = code
+        self.name = bc.encode("cp949")
+        self.pool = pool
+        self.pos = 0
+
+    def next_data(self) -> bytes:
+        data = self.pool[self.pos]
+        self.pos = (self.pos + 1) % len(self.pool)
+        return data
+
+
+# ============================================================================
+# SimulatorTransport
+# ============================================================================
+
+class SimulatorTransport(Transport):
+    """wmca.dll 대체 시뮬레이터 Transport
+
+    Args:
+        tick_rate: 구독 1건당 초당 실시간 시세 수 (None이면 대기 없이 최대한 빠르게)
+        latency: wmcaConnect/wmcaQuery 응답 지연 (초)
+        accounts: 로그인 응답 계좌 수
+        array_rows: 조회 응답 반복 블록 건수 (예: c8201OutBlock1)
+        pool_size: 구독마다 미리 만들어 둘 시세 수
+        max_ticks: 지정하면 전체 시세 수가 max_ticks에 도달한 뒤 exhausted
+            (receive_events()/receive_batch()가 종료되어 고정 부하 측정에 사용)
+        batch: dispatch_pending() 1회당 최대 전달 수
+        seed: 난수 시드 (재현용)
+
+    Attributes:
+        connected: 로그인 상태
+        ticks: 지금까지 전달한 실시간 시세 수
+    """
+
+    def __init__(
+        self,
+        tick_rate: Optional[float] = 1000.0,
+        latency: float = 0.0,
+        accounts: int = 1,
+        array_rows: int = 20,
+        pool_size: int = 256,
+        max_ticks: Optional[int] = None,
+        batch: int = DEFAULT_BATCH,
+        seed: Optional[int] = None,
+    ):
+        if tick_rate is not None and tick_rate <= 0:
+            raise ValueError(f"tick_rate는 0보다 커야 합니다 (최대 속도는 None): {tick_rate}")
+        if latency < 0:
+            raise ValueError(f"latency는 0 이상이어야 합니다: {latency}")
+        if not 0 <= accounts <= 999:
+            raise ValueError(f"accounts는 0~999 사이여야 합니다: {accounts}")
+        if pool_size <= 0 or batch <= 0:
+            raise ValueError("pool_size와 batch는 1 이상이어야 합니다")
+        self.tick_rate = tick_rate
+        self.latency = latency
+        self.accounts = accounts
+        self.array_rows = array_rows
+        self.pool_size = pool_size
+        self.max_ticks = max_ticks
+        self.batch = batch
+        self.hwnd = 0
+        self.connected = False
+        self.ticks = 0
+
+        self._rng = random.Random(seed)
+        self._handler: Optional[EventHandler] = None
+        self._buffer = OutDataBlockBuffer()
+        self._lock = threading.Lock()
+        self._wakeup = threading.Event()
+
+        # 단발 이벤트 (로그인/조회 응답): (due, seq, wparam, payload) 힙
+        self._pending: List[Tuple[float, int, int, Any]] = []
+        self._seq = itertools.count()
+
+        # 실시간 구독 (펌프 스레드는 _sub_list 스냅샷만 읽음)
+        self._subs: Dict[Tuple[str, str], _Subscription] = {}
+        self._sub_list: Tuple[_Subscription, ...] = ()
+        self._rr = 0                # 다음 시세를 보낼 구독 위치 (라운드 로빈)
+        self._tick_start = 0.0      # 시세 시계 기준 시각 (구독이 바뀔 때마다 재설정)
+        self._tick_emitted = 0      # _tick_start 이후 보낸 시세 수
+        self._tick_total = 0        # 전체 예약한 시세 수 (max_ticks 비교용)
+
+    def load_dll(self) -> "SimulatedDLL":
+        return SimulatedDLL(self)
+
+    # ========================================================================
+    # 이벤트 예약 (DLL 함수에서 호출, 임의 스레드)
+    # ========================================================================
+
+    def _schedule(self, events: List[Tuple[int, Any]], delay: float):
+        due = time.monotonic() + delay
+        with self._lock:
+            for wparam, payload in events:
+                heapq.heappush(self._pending, (due, next(self._seq), wparam, payload))
+        self._wakeup.set()
+
+    def _set_subscriptions(self, subs: Dict[Tuple[str, str], _Subscription]):
+        """구독 변경 (시세 시계 재설정). _lock을 잡은 상태에서 호출"""
+        self._subs = subs
+        self._sub_list = tuple(subs.values())
+        self._rr = 0
+        self._tick_start = time.monotonic()
+        self._tick_emitted = 0
+
+    def _login(self, user_id: bytes):
+        info = CLoginInfo()
+        info.szDate = datetime.now().strftime("%Y%m%d%H%M%S").encode()
+        info.szServerName = _SERVER_NAME
+        info.szUserID = user_id[:8]
+        info.szAccountCount = f"{self.accounts:03d}".encode()
+        for i in range(self.accounts):
+            account = info.accountlist[i]
+            account.szAccountNo = f"{i + 1:03d}{self._rng.randrange(10 ** 8):08d}".encode()
+            account.szAccountName = f"모의계좌{i + 1}".encode("cp949")
+            account.act_pdt_cdz3 = b"01"
+            account.amn_tab_cdz4 = b"0001"
+            account.expr_datez8 = b"99991231"
+            account.granted = b"G"
+        block = CLoginBlock(0, ctypes.pointer(info))
+        self.connected = True
+        self._schedule([(WMCAMessage.CA_CONNECTED.value, block)], self.latency)
+
+    def _disconnect(self):
+        was_connected = self.connected
+        self.connected = False
+        with self._lock:
+            self._set_subscriptions({})
+        if was_connected:
+            self._schedule([(WMCAMessage.CA_DISCONNECTED.value, None)], 0.0)
+
+    def _query(self, tr_index: int, tr_code: str):
+        blocks = sorted(
+            (info for name, info in registered_blocks().items() if name.startswith(tr_code + "OutBlock")),
+            key=lambda info: info.name,
+        )
+        name = tr_code.encode("cp949")
+        if not blocks:
+            self._schedule([
+                (WMCAMessage.CA_RECEIVEMESSAGE.value, (tr_index, name, _msg_header("99999", "미지원 TR입니다."))),
+                (WMCAMessage.CA_RECEIVEERROR.value, (tr_index, None, b"")),
+            ], self.latency)
+            return
+        events = [(WMCAMessage.CA_RECEIVEMESSAGE.value, (tr_index, name, _msg_header("00000", "조회가 완료되었습니다.")))]
+        for info in blocks:
+            rows = self.array_rows if info.is_array else 1
+            data = b"".join(synth_record(info, self._rng) for _ in range(rows))
+            events.append((WMCAMessage.CA_RECEIVEDATA.value, (tr_index, info.name.encode("cp949"), data)))
+        events.append((WMCAMessage.CA_RECEIVECOMPLETE.value, (tr_index, None, b"")))
+        self._schedule(events, self.latency)
+
+    def _attach(self, bc: str, codes: List[str]) -> bool:
+        info = lookup_block(bc)
+        if info is None:
+            logger.warning("시뮬레이터: 등록되지 않은 실시간 코드 %s (register_block 필요)", bc)
+            return False
+        prefix = bc.encode("cp949")[:2] + _SISE_SEPARATOR
+        new = {}
+        for code in codes:
+            if (bc, code) in self._subs:
+                continue
+            if bc == "j8":
+                records = _j8_ticks(info, code, self.pool_size, self._rng)
+            else:
+                first = info.struct_class._fields_[0][0]
+                records = [synth_record(info, self._rng, {first: code}) for _ in range(self.pool_size)]
+            new[(bc, code)] = _Subscription(bc, code, [prefix + r for r in records])
+        with self._lock:
+            self._set_subscriptions({**self._subs, **new})
+        self._wakeup.set()
+        return True
+
+    def _detach(self, bc: str, codes: List[str]):
+        removed = set(codes)
+        with self._lock:
+            self._set_subscriptions({k: v for k, v in self._subs.items() if k[0] != bc or k[1] not in removed})
+
+    # ========================================================================
+    # Transport
+    # ========================================================================
+
+    def open(self, handler: EventHandler) -> None:
+        self._handler = handler
+        with self._lock:
+            self._set_subscriptions(self._subs)
+
+    def close(self) -> None:
+        self._handler = None
+
+    def _due_ticks(self, now: float, limit: int) -> int:
+        """지금까지 보냈어야 할 시세 중 아직 보내지 않은 수. _lock을 잡은 상태에서 호출"""
+        if not self._sub_list or limit <= 0:
+            return 0
+        if self.max_ticks is not None:
+            limit = min(limit, self.max_ticks - self._tick_total)
+        if self.tick_rate is None:
+            return max(limit, 0)
+        due = int((now - self._tick_start) * self.tick_rate * len(self._sub_list)) - self._tick_emitted
+        return max(0, min(due, limit))
+
+    def _next_due(self) -> Optional[float]:
+        """다음 이벤트 예정 시각 (없으면 None). _lock을 잡은 상태에서 호출"""
+        due = self._pending[0][0] if self._pending else None
+        if self._sub_list and (self.max_ticks is None or self._tick_total < self.max_ticks):
+            if self.tick_rate is None:
+                return time.monotonic()
+            tick_due = self._tick_start + (self._tick_emitted + 1) / (self.tick_rate * len(self._sub_list))
+            due = tick_due if due is None else min(due, tick_due)
+        return due
+
+    def _emit(self, wparam: int, payload: Any):
+        if payload is None:
+            lparam = 0
+        elif isinstance(payload, tuple):
+            lparam = self._buffer.fill(*payload)
+        else:
+            lparam = ctypes.addressof(payload)
+        self._handler(wparam, lparam)
+
+    def _dispatch_due(self, limit: int) -> int:
+        now = time.monotonic()
+        with self._lock:
+            events = []
+            while self._pending and self._pending[0][0] <= now and len(events) < limit:
+                events.append(heapq.heappop(self._pending))
+            n_ticks = self._due_ticks(now, limit - len(events))
+            subs = self._sub_list
+            rr = self._rr
+            if n_ticks:
+                self._rr = (rr + n_ticks) % len(subs)
+                self._tick_emitted += n_ticks
+                self._tick_total += n_ticks
+
+        for _, _, wparam, payload in events:
+            self._emit(wparam, payload)
+
+        handler = self._handler
+        fill = self._buffer.fill
+        sise = WMCAMessage.CA_RECEIVESISE.value
+        n_subs = len(subs)
+        for i in range(n_ticks):
+            sub = subs[(rr + i) % n_subs]
+            handler(sise, fill(0, sub.name, sub.next_data()))
+        self.ticks += n_ticks
+        return len(events) + n_ticks
+
+    def dispatch_pending(self) -> int:
+        return self._dispatch_due(self.batch)
+
+    def dispatch_one(self) -> int:
+        return self._dispatch_due(1)
+
+    def wait(self, timeout: Optional[float]) -> bool:
+        if self.exhausted:
+            return False    # max_ticks 도달 (ReplayTransport와 동일하게 대기하지 않음)
+        self._wakeup.clear()
+        with self._lock:
+            due = self._next_due()
+        delay = None
+        if due is not None:
+            delay = due - time.monotonic()
+            if delay <= 0:
+                return True
+        if delay is None:
+            limit = timeout
+        else:
+            limit = delay if timeout is None else min(delay, timeout)
+        woke = self._wakeup.wait(limit)
+        return woke or (delay is not None and (timeout is None or delay <= timeout))
+
+    def wake(self) -> None:
+        self._wakeup.set()
+
+    @property
+    def exhausted(self) -> bool:
+        """max_ticks건을 모두 보냈고 남은 단발 이벤트도 없는지 여부"""
+        if self.max_ticks is None:
+            return False
+        with self._lock:
+            return self._tick_total >= self.max_ticks and not self._pending
+
+
+def _msg_header(code: str, message: str) -> bytes:
+    """MSGHEADER 레코드 (msg_cd 5자리 + user_msg 80자리, 왼쪽 정렬)"""
+    header = CMsgHeader()
+    header.msg_cd = code.encode()
+    header.user_msg = message.encode("cp949")[:80]
+    return bytes(header).replace(b"\0", b" ")
+
+
+# ============================================================================
+# SimulatedDLL
+# ============================================================================
+
+class SimulatedDLL:
+    """wmca.dll 함수 테이블 대체 (WmcaIntf.h 함수명, 인자 순서 동일)"""
+
+    def __init__(self, transport: SimulatorTransport):
+        self._sim = transport
+
+    def wmcaLoad(self) -> bool:
+        return True
+
+    def wmcaFree(self) -> bool:
+        return True
+
+    def wmcaSetServer(self, szServer) -> bool:
+        return True
+
+    def wmcaSetPort(self, nPort) -> bool:
+        return True
+
+    def wmcaIsConnected(self) -> bool:
+        return self._sim.connected
+
+    def wmcaConnect(self, hWnd, dwMsg, cMediaType, cUserType, pszID, pszPassword, pszSignPassword) -> bool:
+        if not pszID:
+            return False
+        self._sim._login(bytes(pszID))
+        return True
+
+    def wmcaDisconnect(self) -> bool:
+        self._sim._disconnect()
+        return True
+
+    def wmcaQuery(self, hWnd, nTransactionID, pszTrCode, pszInputData, nInputDataSize, nAccountIndex) -> bool:
+        if not self._sim.connected:
+            return False
+        self._sim._query(nTransactionID, pszTrCode.decode("cp949"))
+        return True
+
+    def wmcaAttach(self, hWnd, pszSiseName, pszInputCode, nInputCodeSize, nInputCodeTotalSize) -> bool:
+        if not self._sim.connected or nInputCodeSize <= 0:
+            return False
+        return self._sim._attach(pszSiseName.decode("cp949"), _split_codes(pszInputCode, nInputCodeSize, nInputCodeTotalSize))
+
+    def wmcaDetach(self, hWnd, pszSiseName, pszInputCode, nInputCodeSize, nInputCodeTotalSize) -> bool:
+        if nInputCodeSize <= 0:
+            return False
+        self._sim._detach(pszSiseName.decode("cp949"), _split_codes(pszInputCode, nInputCodeSize, nInputCodeTotalSize))
+        return True
+
+    def wmcaSetAccountIndexPwd(self, pszHashOut, nAccountIndex, pszPassword) -> bool:
+        if not self._sim.connected or not 1 <= nAccountIndex <= self._sim.accounts:
+            return False
+        digest = hashlib.sha256(str(nAccountIndex).encode() + b":" + bytes(pszPassword)).digest()
+        ctypes.memmove(pszHashOut, base64.b64encode(digest), 44)
+        return True
+
+
+def _split_codes(codes: bytes, size: int, total: int) -> List[str]:
+    text = codes[:total].decode("cp949")
+    return [text[i:i + size] for i in range(0, len(text), size)]
+
+
+__all__ = [
+    "SimulatorTransport",
+    "SimulatedDLL",
+    "render_record",
+    "synth_record",
+]
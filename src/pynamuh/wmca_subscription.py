@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+SubscriptionManager - 실시간 시세 구독 참조 카운트와 묶음 attach/detach
+
+WMCAAgent.attach()/detach()는 호출자가 종목코드를 이어 붙인 szInput과 길이를 직접 만들어야 하고,
+누가 어떤 종목을 구독했는지 기록하지 않습니다. 여러 컴포넌트가 같은 종목을 구독/해제하면 다른
+컴포넌트가 아직 쓰는 구독을 끊거나, 아무도 쓰지 않는 구독이 남습니다.
+
+SubscriptionManager는 (실시간 코드, 종목코드)마다 구독 중인 owner 집합을 관리하고
+
+    - 구독자가 0 → 1이 된 종목만 wmcaAttach, 1 → 0이 된 종목만 wmcaDetach
+    - 바뀐 종목을 실시간 코드/코드 길이별로 모아 max_codes_per_call개씩 한 번에 호출
+    - set_watchlist()는 이전 관심종목과의 차이만 반영
+
+합니다. 서버에 실제 등록된 구독(active)과 구독자가 원하는 구독(wanted)을 따로 관리하므로,
+wmcaAttach/wmcaDetach가 실패한 종목은 다음 sync()에서 다시 시도합니다.
+
+Example:
+    >>> subs = SubscriptionManager(agent)
+    >>> subs.subscribe("strategy", "j8", ["005930", "000660"])   # wmcaAttach 1회
+    >>> subs.subscribe("monitor", "j8", ["005930", "035420"])    # 035420만 wmcaAttach
+    >>> subs.unsubscribe("strategy", "j8", ["005930"])           # monitor가 쓰고 있으므로 호출 없음
+    >>> subs.set_watchlist("monitor", "j8", kospi200_codes)      # 차이만 attach/detach
+    >>> subs.release("monitor")                                  # monitor의 구독 전체 해제
+    >>> print(subs.stats)
+
+Note:
+    - owner는 해시 가능한 아무 값 (컴포넌트 이름, 객체 등)이나 사용할 수 있습니다.
+    - 같은 owner가 같은 종목을 여러 번 subscribe()해도 구독자는 1로 셉니다.
+    - 재접속하면 서버 구독이 사라지므로 CA_CONNECTED 후 resubscribe()를 호출하세요.
+    - attach()/detach()를 직접 호출한 구독은 관리하지 않습니다.
+"""
+
+import threading
+from collections import defaultdict
+from dataclasses import dataclass
+from typing import Dict, Hashable, Iterable, List, Optional, Set, Tuple
+
+from .wmca_logger import logger
+
+# wmcaAttach 1회에 넣을 최대 종목 수. SDK 문서에 상한이 없어 보수적으로 잡은 값
+DEFAULT_MAX_CODES_PER_CALL = 100
+
+# (실시간 코드, 종목코드)
+SubscriptionKey = Tuple[str, str]
+
+
+@dataclass
+class SubscriptionStats:
+    """SubscriptionManager 통계
+
+    Attributes:
+        attach_calls: wmcaAttach 호출 수
+        detach_calls: wmcaDetach 호출 수
+        attached: wmcaAttach로 등록한 종목 수 (누적)
+        detached: wmcaDetach로 해제한 종목 수 (누적)
+        failed: wmcaAttach/wmcaDetach가 실패한 종목 수 (누적, 다음 sync()에서 재시도)
+    """
+    attach_calls: int = 0
+    detach_calls: int = 0
+    attached: int = 0
+    detached: int = 0
+    failed: int = 0
+
+
+def _batches(bc_type: str, codes: Iterable[str], size: int) -> Iterable[Tuple[str, int, List[str]]]:
+    """코드 길이별로 나눈 뒤 size개씩 묶음 → (실시간 코드, 코드 길이, 종목 리스트)"""
+    by_len: Dict[int, List[str]] = defaultdict(list)
+    for code in sorted(codes):
+        by_len[len(code)].append(code)
+    for code_len, group in sorted(by_len.items()):
+        for start in range(0, len(group), size):
+            yield bc_type, code_len, group[start:start + size]
+
+
+class SubscriptionManager:
+    """실시간 시세 구독 관리자
+
+    Args:
+        agent: WMCAAgent
+        max_codes_per_call: wmcaAttach/wmcaDetach 1회에 넣을 최대 종목 수
+    """
+
+    def __init__(self, agent, max_codes_per_call: int = DEFAULT_MAX_CODES_PER_CALL):
+        if max_codes_per_call <= 0:
+            raise ValueError(f"max_codes_per_call은 1 이상이어야 합니다: {max_codes_per_call}")
+        self.agent = agent
+        self.max_codes_per_call = max_codes_per_call
+        self.stats = SubscriptionStats()
+
+        self._lock = threading.RLock()
+        self._holders: Dict[SubscriptionKey, Set[Hashable]] = {}        # 구독자가 원하는 구독 → owner 집합
+        self._watch: Dict[Tuple[Hashable, str], Set[str]] = {}          # (owner, 실시간 코드) → 종목 집합
+        self._active: Set[SubscriptionKey] = set()                      # 서버에 등록된 구독
+
+    def __len__(self) -> int:
+        """서버에 등록된 구독 수"""
+        return len(self._active)
+
+    def __enter__(self) -> "SubscriptionManager":
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+        return False
+
+    # ========================================================================
+    # 구독
+    # ========================================================================
+
+    def subscribe(self, owner: Hashable, bc_type: str, codes: Iterable[str]) -> int:
+        """
+        owner의 구독 추가
+
+        Args:
+            owner: 구독자 (해시 가능한 값)
+            bc_type: 실시간 서비스 코드 (2자리, 예: "j8")
+            codes: 종목코드 목록
+
+        Returns:
+            int: 새로 wmcaAttach한 종목 수
+        """
+        with self._lock:
+            current = self._watch.get((owner, bc_type), set())
+            return self._update(owner, bc_type, current | set(codes))[0]
+
+    def unsubscribe(self, owner: Hashable, bc_type: str, codes: Optional[Iterable[str]] = None) -> int:
+        """
+        owner의 구독 해제 (다른 owner가 구독 중인 종목은 wmcaDetach하지 않음)
+
+        Args:
+            owner: 구독자
+            bc_type: 실시간 서비스 코드
+            codes: 해제할 종목코드 목록 (None이면 owner의 bc_type 구독 전체)
+
+        Returns:
+            int: wmcaDetach한 종목 수
+        """
+        with self._lock:
+            current = self._watch.get((owner, bc_type), set())
+            remaining = set() if codes is None else current - set(codes)
+            return self._update(owner, bc_type, remaining)[1]
+
+    def set_watchlist(self, owner: Hashable, bc_type: str, codes: Iterable[str]) -> Tuple[int, int]:
+        """
+        owner의 bc_type 관심종목을 codes로 교체 (이전 목록과의 차이만 반영)
+
+        Returns:
+            Tuple[int, int]: (wmcaAttach한 종목 수, wmcaDetach한 종목 수)
+        """
+        with self._lock:
+            return self._update(owner, bc_type, set(codes))
+
+    def release(self, owner: Hashable) -> int:
+        """
+        owner의 모든 구독 해제 (컴포넌트 종료 시)
+
+        Returns:
+            int: wmcaDetach한 종목 수
+        """
+        with self._lock:
+            bc_types = [bc for (holder, bc) in self._watch if holder == owner]
+            return sum(self._update(owner, bc, set())[1] for bc in bc_types)
+
+    def _update(self, owner: Hashable, bc_type: str, codes: Set[str]) -> Tuple[int, int]:
+        """owner의 (bc_type) 종목 집합을 codes로 바꾸고 서버 구독을 맞춤 (self._lock 보유 상태)"""
+        key = (owner, bc_type)
+        previous = self._watch.get(key, set())
+        for code in codes - previous:
+            self._holders.setdefault((bc_type, code), set()).add(owner)
+        for code in previous - codes:
+            holders = self._holders[(bc_type, code)]
+            holders.discard(owner)
+            if not holders:
+                del self._holders[(bc_type, code)]
+        if codes:
+            self._watch[key] = codes
+        else:
+            self._watch.pop(key, None)
+
+        # 이번에 바뀐 종목만 확인 (전체 비교는 sync())
+        changed = codes ^ previous
+        to_attach = {c for c in changed if (bc_type, c) in self._holders and (bc_type, c) not in self._active}
+        to_detach = {c for c in changed if (bc_type, c) not in self._holders and (bc_type, c) in self._active}
+        return self._apply(bc_type, to_attach, to_detach)
+
+    # ========================================================================
+    # 서버 반영
+    # ========================================================================
+
+    def _apply(self, bc_type: str, to_attach: Set[str], to_detach: Set[str]) -> Tuple[int, int]:
+        """묶음 단위 wmcaDetach → wmcaAttach (해제를 먼저 해서 서버 구독 수를 줄임)"""
+        detached = 0
+        for bc, code_len, batch in _batches(bc_type, to_detach, self.max_codes_per_call):
+            self.stats.detach_calls += 1
+            if not self.agent.detach(bc, "".join(batch), code_len, code_len * len(batch)):
+                # 서버 구독이 남아 있으므로 active에 두고 다음 sync()에서 재시도
+                self.stats.failed += len(batch)
+                logger.warning("실시간 구독 해제 실패: %s %d종목 (다음 sync()에서 재시도)", bc, len(batch))
+                continue
+            self._active.difference_update((bc, code) for code in batch)
+            detached += len(batch)
+        self.stats.detached += detached
+
+        attached = 0
+        for bc, code_len, batch in _batches(bc_type, to_attach, self.max_codes_per_call):
+            self.stats.attach_calls += 1
+            if not self.agent.attach(bc, "".join(batch), code_len, code_len * len(batch)):
+                self.stats.failed += len(batch)
+                logger.warning("실시간 구독 실패: %s %d종목 (다음 sync()에서 재시도)", bc, len(batch))
+                continue
+            self._active.update((bc, code) for code in batch)
+            attached += len(batch)
+        self.stats.attached += attached
+        return attached, detached
+
+    def sync(self) -> Tuple[int, int]:
+        """
+        서버 구독을 구독자가 원하는 상태로 맞춤 (실패한 wmcaAttach/wmcaDetach 재시도)
+
+        Returns:
+            Tuple[int, int]: (wmcaAttach한 종목 수, wmcaDetach한 종목 수)
+        """
+        with self._lock:
+            wanted = set(self._holders)
+            to_attach: Dict[str, Set[str]] = defaultdict(set)
+            to_detach: Dict[str, Set[str]] = defaultdict(set)
+            for bc, code in wanted - self._active:
+                to_attach[bc].add(code)
+            for bc, code in self._active - wanted:
+                to_detach[bc].add(code)
+            attached = detached = 0
+            for bc in sorted(to_attach.keys() | to_detach.keys()):
+                a, d = self._apply(bc, to_attach[bc], to_detach[bc])
+                attached += a
+                detached += d
+            return attached, detached
+
+    def resubscribe(self) -> int:
+        """
+        재접속 후 전체 구독 다시 등록 (서버 구독이 사라진 상태 가정)
+
+        Returns:
+            int: wmcaAttach한 종목 수
+        """
+        with self._lock:
+            self._active.clear()
+            return self.sync()[0]
+
+    def close(self) -> int:
+        """
+        모든 구독 해제 (owner 기록도 삭제)
+
+        Returns:
+            int: wmcaDetach한 종목 수
+        """
+        with self._lock:
+            self._holders.clear()
+            self._watch.clear()
+            return self.sync()[1]
+
+    # ========================================================================
+    # 조회
+    # ========================================================================
+
+    def refcount(self, bc_type: str, code: str) -> int:
+        """(bc_type, code)를 구독 중인 owner 수"""
+        with self._lock:
+            return len(self._holders.get((bc_type, code), ()))
+
+    def owners(self, bc_type: str, code: str) -> Set[Hashable]:
+        """(bc_type, code)를 구독 중인 owner 집합"""
+        with self._lock:
+            return set(self._holders.get((bc_type, code), ()))
+
+    def watchlist(self, owner: Hashable, bc_type: str) -> Set[str]:
+        """owner의 bc_type 구독 종목"""
+        with self._lock:
+            return set(self._watch.get((owner, bc_type), ()))
+
+    def active(self, bc_type: Optional[str] = None) -> Set[SubscriptionKey]:
+        """서버에 등록된 구독 (bc_type을 지정하면 해당 실시간 코드만)"""
+        with self._lock:
+            return {key for key in self._active if bc_type is None or key[0] == bc_type}
+
+
+__all__ = [
+    "SubscriptionManager",
+    "SubscriptionStats",
+    "SubscriptionKey",
+    "DEFAULT_MAX_CODES_PER_CALL",
+]
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+WMCA 이벤트 전달 계층 (Transport)
+
+WMCAAgent는 Transport를 통해 WMCA 함수를 호출하고 (wmcaConnect, wmcaQuery, ...)
+CA_WMCAEVENT 이벤트(wparam, lparam)를 받습니다. 파싱/큐/소비자 API(receive_events 등)는
+Transport와 무관하게 동일합니다.
+
+- Win32Transport (wmca_transport_win32.py): 실제 wmca.dll + 숨김 윈도우 메시지 펌프 (Windows 전용)
+- ReplayTransport (wmca_replay.py): TickJournal에 기록된 원시 페이로드 재생 (플랫폼 무관)
+- SimulatorTransport (wmca_simulator.py): wmca.dll 대체 시뮬레이터, 부하/지연 테스트용 (플랫폼 무관)
+
+Transport 구현 규칙:
+    - open()을 호출한 스레드에서 dispatch_pending()/dispatch_one()/close()를 호출합니다.
+    - 이벤트마다 handler(wparam, lparam)를 호출하고, lparam이 가리키는 메모리는
+      handler가 반환될 때까지만 유효합니다. (실제 DLL과 동일)
+    - wake()는 다른 스레드에서 호출되어 wait()를 즉시 깨웁니다.
+"""
+
+import ctypes
+from abc import ABC, abstractmethod
+from typing import Any, Callable, Optional
+
+from .structures.common import CReceived, COutDataBlock
+
+
+# WinUser.h WM_USER (win32con 없이 사용하기 위해 상수로 정의)
+WM_USER = 0x0400
+
+# WMCA 이벤트 메시지 (샘플 코드 참고)
+CA_WMCAEVENT = WM_USER + 8400  # 중요! wparam에 실제 메시지 타입이 들어있음
+
+# CA_WMCAEVENT 핸들러: (wparam: 메시지 타입, lparam: 구조체 포인터)
+EventHandler = Callable[[int, int], None]
+
+
+# ============================================================================
+# Transport
+# ============================================================================
+
+class Transport(ABC):
+    """WMCA 이벤트 전달 계층 기본 클래스
+
+    Attributes:
+        hwnd: WMCA 함수 호출 시 넘길 윈도우 핸들 (Windows 외에는 0)
+    """
+
+    hwnd: Optional[int] = None
+
+    def load_dll(self) -> Any:
+        """WMCA 함수 테이블 반환 (wmcaConnect, wmcaQuery 등 WmcaIntf.h 이름의 속성을 가진 객체)
+
+        기본값은 모든 요청을 받아들이기만 하는 NullDLL입니다.
+        """
+        return NullDLL()
+
+    @abstractmethod
+    def open(self, handler: EventHandler) -> None:
+        """이벤트 수신 준비 (Win32: 숨김 윈도우 생성). 이후 이벤트는 handler로 전달"""
+
+    @abstractmethod
+    def close(self) -> None:
+        """이벤트 수신 종료 (open()을 호출한 스레드에서 호출)"""
+
+    @abstractmethod
+    def dispatch_pending(self) -> int:
+        """대기 중인 이벤트를 모두 handler로 전달
+
+        Returns:
+            int: 처리한 메시지 수
+        """
+
+    def dispatch_one(self) -> int:
+        """대기 중인 이벤트 1개만 전달 (pump_mode="poll")
+
+        Returns:
+            int: 처리한 메시지 수 (0 또는 1)
+        """
+        return self.dispatch_pending()
+
+    @abstractmethod
+    def wait(self, timeout: Optional[float]) -> bool:
+        """이벤트가 도착할 때까지 블로킹 대기
+
+        Args:
+            timeout: 최대 대기 시간 (초). None이면 무한 대기
+
+        Returns:
+            bool: 이벤트 도착 여부 (False면 timeout)
+        """
+
+    @abstractmethod
+    def wake(self) -> None:
+        """다른 스레드에서 wait() 대기를 깨움"""
+
+    @property
+    def exhausted(self) -> bool:
+        """더 이상 전달할 이벤트가 없는지 여부 (재생 종료 등). 실시간 Transport는 항상 False"""
+        return False
+
+
+# ============================================================================
+# OutDataBlockBuffer (DLL 없이 OUTDATABLOCK 이벤트를 만들 때 사용)
+# ============================================================================
+
+class _RawReceived(ctypes.Structure):
+    """RECEIVED와 같은 레이아웃. c_char_p 필드는 bytes 객체 버퍼를 복사 없이 가리킴"""
+    _fields_ = [
+        ("szBlockName", ctypes.c_char_p),
+        ("szData", ctypes.c_char_p),
+        ("nLen", ctypes.c_int),
+    ]
+
+
+class _RawOutDataBlock(ctypes.Structure):
+    """OUTDATABLOCK과 같은 레이아웃"""
+    _fields_ = [
+        ("TrIndex", ctypes.c_int),
+        ("pData", ctypes.c_void_p),
+    ]
+
+
+assert ctypes.sizeof(_RawReceived) == ctypes.sizeof(CReceived)
+assert ctypes.sizeof(_RawOutDataBlock) == ctypes.sizeof(COutDataBlock)
+
+
+class OutDataBlockBuffer:
+    """handler에 넘길 OUTDATABLOCK 구조체 (이벤트마다 재사용)
+
+    fill()이 반환한 lparam은 다음 fill() 호출 전까지만 유효합니다. (handler 반환 후 덮어씀)
+    block_name/data bytes는 복사하지 않고 가리키기만 하므로 handler가 반환될 때까지 살아 있어야 합니다.
+    """
+
+    __slots__ = ("_received", "_block", "_received_addr", "lparam")
+
+    def __init__(self):
+        self._received = _RawReceived()
+        self._block = _RawOutDataBlock()
+        self._received_addr = ctypes.addressof(self._received)
+        self.lparam = ctypes.addressof(self._block)
+
+    def fill(self, tr_index: int, block_name: Optional[bytes], data: bytes = b"") -> int:
+        """OUTDATABLOCK 채우기 (block_name이 None이면 pData=NULL)
+
+        Returns:
+            int: lparam (OUTDATABLOCK 주소)
+        """
+        block = self._block
+        block.TrIndex = tr_index
+        if block_name is None:
+            block.pData = None
+            return self.lparam
+        received = self._received
+        received.szBlockName = block_name
+        received.szData = data
+        received.nLen = len(data)
+        block.pData = self._received_addr
+        return self.lparam
+
+
+# ============================================================================
+# NullDLL
+# ============================================================================
+
+class NullDLL:
+    """서버 없이 요청을 받아들이기만 하는 WMCA 함수 테이블 (재생용)
+
+    wmcaConnect/wmcaQuery/wmcaAttach/wmcaDetach 등은 아무 이벤트도 만들지 않고 성공(True)을 반환합니다.
+    wmcaIsConnected와 wmcaSetAccountIndexPwd는 실패(False)를 반환합니다.
+    """
+
+    def wmcaLoad(self) -> bool:
+        return True
+
+    def wmcaFree(self) -> bool:
+        return True
+
+    def wmcaSetServer(self, szServer) -> bool:
+        return True
+
+    def wmcaSetPort(self, nPort) -> bool:
+        return True
+
+    def wmcaIsConnected(self) -> bool:
+        return False
+
+    def wmcaConnect(self, hWnd, dwMsg, cMediaType, cUserType, pszID, pszPassword, pszSignPassword) -> bool:
+        return True
+
+    def wmcaDisconnect(self) -> bool:
+        return True
+
+    def wmcaQuery(self, hWnd, nTransactionID, pszTrCode, pszInputData, nInputDataSize, nAccountIndex) -> bool:
+        return True
+
+    def wmcaAttach(self, hWnd, pszSiseName, pszInputCode, nInputCodeSize, nInputCodeTotalSize) -> bool:
+        return True
+
+    def wmcaDetach(self, hWnd, pszSiseName, pszInputCode, nInputCodeSize, nInputCodeTotalSize) -> bool:
+        return True
+
+    def wmcaSetAccountIndexPwd(self, pszHashOut, nAccountIndex, pszPassword) -> bool:
+        return False
+
+
+__all__ = [
+    "WM_USER",
+    "CA_WMCAEVENT",
+    "EventHandler",
+    "Transport",
+    "OutDataBlockBuffer",
+    "NullDLL",
+]
@@ -0,0 +1,284 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Win32Transport - 실제 wmca.dll + 숨김 윈도우 메시지 펌프 (Windows 32비트 전용)
+
+wmca.dll은 요청마다 넘겨받은 윈도우 핸들로 CA_WMCAEVENT 메시지를 보냅니다.
+숨김 윈도우의 윈도우 프로시저가 메시지를 받아 WMCAAgent 핸들러로 전달합니다.
+"""
+
+import os
+import sys
+import time
+import ctypes
+from ctypes import c_char_p, c_int, c_char
+from pathlib import Path
+from typing import Any, Optional
+
+from .wmca_logger import logger
+from .wmca_transport import Transport, EventHandler, CA_WMCAEVENT
+
+# Windows 환경 확인
+if sys.platform != "win32":
+    raise OSError("이 모듈은 Windows 환경에서만 실행 가능합니다.")
+
+import win32gui
+from ctypes import WINFUNCTYPE
+from ctypes.wintypes import HWND, UINT, WPARAM, LPARAM, DWORD
+
+# Windows 프로시저 콜백 타입 정의
+WNDPROC = WINFUNCTYPE(ctypes.c_long, HWND, UINT, WPARAM, LPARAM)
+
+# Windows API
+user32 = ctypes.windll.user32
+kernel32 = ctypes.windll.kernel32
+
+# DWORD MsgWaitForMultipleObjectsEx(DWORD nCount, const HANDLE* pHandles, DWORD dwMilliseconds,
+#                                   DWORD dwWakeMask, DWORD dwFlags)
+user32.MsgWaitForMultipleObjectsEx.argtypes = [DWORD, ctypes.c_void_p, DWORD, DWORD, DWORD]
+user32.MsgWaitForMultipleObjectsEx.restype = DWORD
+
+# 메시지 펌프 상수 (WinUser.h / WinBase.h)
+PM_REMOVE = 0x0001
+WM_NULL = 0x0000
+QS_ALLINPUT = 0x04FF
+MWMO_INPUTAVAILABLE = 0x0004
+WAIT_TIMEOUT = 0x00000102
+INFINITE = 0xFFFFFFFF
+
+
+# MSG 구조체
+class MSG(ctypes.Structure):
+    _fields_ = [
+        ("hWnd", HWND),
+        ("message", UINT),
+        ("wParam", WPARAM),
+        ("lParam", LPARAM),
+        ("time", ctypes.wintypes.DWORD),
+        ("pt", ctypes.wintypes.POINT),
+    ]
+
+
+# ============================================================================
+# Win32Transport
+# ============================================================================
+
+class Win32Transport(Transport):
+    """실제 wmca.dll + 숨김 윈도우 메시지 펌프
+
+    Args:
+        dll_path: wmca.dll 경로 (None이면 패키지 dll/ 디렉터리에서 탐색)
+    """
+
+    def __init__(self, dll_path: Optional[str] = None):
+        if dll_path is None:
+            dll_path = self._find_dll_path()
+        self.dll_path = dll_path
+        self.hwnd = None
+        self.wnd_class_name = None  # 윈도우 클래스 이름
+        self.wnd_class_atom = None  # 윈도우 클래스 등록 식별자
+        self._handler: Optional[EventHandler] = None
+
+    @staticmethod
+    def _find_dll_path() -> str:
+        """wmca.dll 경로 자동 탐색"""
+        script_dir = Path(__file__).parent
+        wmca_dll_path = script_dir / "dll" / "wmca.dll"
+
+        if wmca_dll_path.exists():
+            return str(wmca_dll_path)
+
+        raise FileNotFoundError(
+            f"wmca.dll을 찾을 수 없습니다.\n"
+            f"NH투자증권 OpenAPI 라이브러리를 다운받은 후 DLL 파일을 {wmca_dll_path} 경로에 배치해주세요."
+        )
+
+    # ========================================================================
+    # DLL 로드
+    # ========================================================================
+
+    def load_dll(self) -> Any:
+        """DLL 로드 및 함수 시그니처 설정
+
+        Reference:
+            - WmcaIntf.h (23-42줄): 모든 함수의 typedef 정의
+            - SDK.pdf: 함수 프로토타입 상세 설명
+
+        Note:
+            모든 WMCA 함수는 __stdcall 규약 사용 → ctypes.WinDLL 사용
+        """
+        try:
+            dll_abs_path = os.path.abspath(self.dll_path)
+            dll_dir = os.path.dirname(dll_abs_path)
+            os.environ["PATH"] = dll_dir + os.pathsep + os.environ.get("PATH", "")
+
+            dll = ctypes.WinDLL(dll_abs_path)
+            logger.debug("DLL 로드됨: %s", dll_abs_path)
+        except OSError as e:
+            raise OSError(f"{self.dll_path} 로드 실패: {e}")
+
+        try:
+            # BOOL wmcaLoad()
+            dll.wmcaLoad.argtypes = []
+            dll.wmcaLoad.restype = ctypes.c_bool
+
+            # BOOL wmcaFree()
+            dll.wmcaFree.argtypes = []
+            dll.wmcaFree.restype = ctypes.c_bool
+
+            # BOOL wmcaSetServer(const char* szServer)
+            dll.wmcaSetServer.argtypes = [c_char_p]
+            dll.wmcaSetServer.restype = ctypes.c_bool
+
+            # BOOL wmcaSetPort(const int nPort)
+            dll.wmcaSetPort.argtypes = [c_int]
+            dll.wmcaSetPort.restype = ctypes.c_bool
+
+            # BOOL wmcaIsConnected()
+            dll.wmcaIsConnected.argtypes = []
+            dll.wmcaIsConnected.restype = ctypes.c_bool
+
+            # BOOL wmcaConnect(HWND hWnd, DWORD dwMsg, char cMediaType, char cUserType,
+            #                  const char* pszID, const char* pszPassword, const char* pszSignPassword)
+            dll.wmcaConnect.argtypes = [HWND, DWORD, c_char, c_char, c_char_p, c_char_p, c_char_p]
+            dll.wmcaConnect.restype = ctypes.c_bool
+
+            # BOOL wmcaDisconnect()
+            dll.wmcaDisconnect.argtypes = []
+            dll.wmcaDisconnect.restype = ctypes.c_bool
+
+            # BOOL wmcaQuery(HWND hWnd, int nTransactionID, const char* pszTrCode,
+            #                const char* pszInputData, int nInputDataSize, int nAccountIndex)
+            dll.wmcaQuery.argtypes = [HWND, c_int, c_char_p, c_char_p, c_int, c_int]
+            dll.wmcaQuery.restype = ctypes.c_bool
+
+            # BOOL wmcaAttach(HWND hWnd, const char* pszSiseName, const char* pszInputCode,
+            #                 int nInputCodeSize, int nInputCodeTotalSize)
+            dll.wmcaAttach.argtypes = [HWND, c_char_p, c_char_p, c_int, c_int]
+            dll.wmcaAttach.restype = ctypes.c_bool
+
+            # BOOL wmcaDetach(HWND hWnd, const char* pszSiseName, const char* pszInputCode,
+            #                 int nInputCodeSize, int nInputCodeTotalSize)
+            dll.wmcaDetach.argtypes = [HWND, c_char_p, c_char_p, c_int, c_int]
+            dll.wmcaDetach.restype = ctypes.c_bool
+
+            # BOOL wmcaSetAccountIndexPwd(const char* pszHashOut, int nAccountIndex, const char* pszPassword)
+            dll.wmcaSetAccountIndexPwd.argtypes = [c_char_p, c_int, c_char_p]
+            dll.wmcaSetAccountIndexPwd.restype = ctypes.c_bool
+
+            logger.debug("모든 DLL 함수 시그니처 설정 완료")
+        except AttributeError as e:
+            raise AttributeError(f"함수 포인터 설정 실패: {e}")
+        return dll
+
+    # ========================================================================
+    # Windows 메시지 처리
+    # ========================================================================
+
+    def open(self, handler: EventHandler) -> None:
+        """메시지 수신용 숨김 윈도우 생성"""
+        self._handler = handler
+
+        # 윈도우 프로시저를 WNDPROC 타입으로 변환 (중요!)
+        self._wnd_proc_callback = WNDPROC(self._wnd_proc)
+
+        # 윈도우 클래스 등록 (인스턴스마다 고유한 이름 사용)
+        self.wnd_class_name = f"WMCA_WINDOW_{id(self)}_{int(time.time() * 1000)}"
+
+        wc = win32gui.WNDCLASS()
+        wc.lpfnWndProc = self._wnd_proc_callback  # 변환된 콜백 사용
+        wc.lpszClassName = self.wnd_class_name
+        wc.hInstance = win32gui.GetModuleHandle(None)
+
+        try:
+            self.wnd_class_atom = win32gui.RegisterClass(wc)
+            logger.debug(
+                "윈도우 클래스 등록 성공: name=%s, atom=%s", self.wnd_class_name, self.wnd_class_atom
+            )
+        except Exception as e:
+            logger.error("윈도우 클래스 등록 실패: %s", e)
+            raise
+
+        # 숨김 윈도우 생성
+        self.hwnd = win32gui.CreateWindow(
+            wc.lpszClassName, "WMCA Message Window", 0, 0, 0, 0, 0, 0, 0, wc.hInstance, None
+        )
+        logger.debug("CreateWindow 완료: hwnd=%s", self.hwnd)
+
+    def _wnd_proc(self, hwnd, msg, wparam, lparam):
+        """Windows 메시지 프로시저 (콜백)"""
+        # CA_WMCAEVENT 메시지만 처리 (샘플 코드 방식)
+        if msg == CA_WMCAEVENT:
+            try:
+                # WMCA 이벤트 처리로 위임
+                self._handler(wparam, lparam)
+            except Exception as e:
+                logger.error("메시지 처리 오류: %s", e, exc_info=True)
+
+            return 0
+
+        return user32.DefWindowProcW(hwnd, msg, wparam, lparam)
+
+    def close(self) -> None:
+        """윈도우 파괴 및 윈도우 클래스 등록 해제 (윈도우를 생성한 스레드에서 호출)"""
+        # 윈도우 파괴
+        if self.hwnd is not None:
+            try:
+                win32gui.DestroyWindow(self.hwnd)
+                logger.debug("윈도우 파괴 완료: hwnd=%s", self.hwnd)
+                self.hwnd = None
+            except Exception as e:
+                logger.error("윈도우 파괴 중 오류: %s", e)
+
+        # 윈도우 클래스 등록 해제
+        if self.wnd_class_atom is not None:
+            try:
+                user32.UnregisterClassW(self.wnd_class_atom, win32gui.GetModuleHandle(None))
+                logger.debug("윈도우 클래스 등록 해제 완료: atom=%s", self.wnd_class_atom)
+                self.wnd_class_atom = None
+            except Exception as e:
+                logger.error("윈도우 클래스 등록 해제 중 오류: %s", e)
+
+    def dispatch_pending(self) -> int:
+        """스레드 메시지 큐에 쌓인 Windows 메시지를 모두 처리"""
+        msg = MSG()
+        msg_ref = ctypes.byref(msg)
+        count = 0
+        while user32.PeekMessageW(msg_ref, None, 0, 0, PM_REMOVE):
+            user32.TranslateMessage(msg_ref)
+            user32.DispatchMessageW(msg_ref)
+            count += 1
+        return count
+
+    def dispatch_one(self) -> int:
+        """Windows 메시지 1개만 처리 (pump_mode="poll", 이전 방식)"""
+        msg = MSG()
+        if user32.PeekMessageW(ctypes.byref(msg), None, 0, 0, PM_REMOVE):
+            user32.TranslateMessage(ctypes.byref(msg))
+            user32.DispatchMessageW(ctypes.byref(msg))
+            return 1
+        return 0
+
+    def wait(self, timeout: Optional[float]) -> bool:
+        """Windows 메시지가 도착할 때까지 블로킹 대기"""
+        if timeout is None:
+            wait_ms = INFINITE
+        else:
+            # 1ms 미만 잔여 시간은 0ms로 내려 busy-wait 없이 한 번만 확인
+            wait_ms = max(0, int(timeout * 1000))
+
+        # MWMO_INPUTAVAILABLE: 이전 Peek에서 확인만 하고 처리하지 않은 메시지가 있어도 즉시 반환
+        result = user32.MsgWaitForMultipleObjectsEx(
+            0, None, wait_ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE
+        )
+        return result != WAIT_TIMEOUT
+
+    def wake(self) -> None:
+        """블로킹 대기 중인 펌프 스레드를 깨움"""
+        if self.hwnd is not None:
+            user32.PostMessageW(self.hwnd, WM_NULL, 0, 0)
+
+
+__all__ = [
+    "Win32Transport",
+]
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryCache 테스트 (submit_query()를 기록하는 가짜 agent 사용)
+
+실행:
+    uv run pytest tests/test_cache.py
+"""
+import threading
+import time
+
+from pynamuh.structures.ord.c8201 import CTc8201InBlock
+from pynamuh.wmca_cache import QueryCache
+from pynamuh.wmca_correlator import QueryFuture, QueryResult
+from pynamuh.wmca_scheduler import QueryScheduler
+
+
+class FakeInBlock:
+    """to_c_struct()만 있는 InBlock 대용"""
+
+    def __init__(self, password: bytes = b"x"):
+        self.password = password
+
+    def to_c_struct(self):
+        return CTc8201InBlock(self.password * 44, b" ", b"1", b" ")
+
+
+class FakeAgent:
+    """submit_query()가 완료되지 않은 future를 반환 (complete()로 응답). gate가 있으면 호출 전에 대기"""
+
+    threaded = True
+
+    def __init__(self, gate: threading.Event = None):
+        self.gate = gate
+        self.sent = []
+        self._tr_index = 100
+
+    def submit_query(self, tr_code, szInput, nAccountIndex=0):
+        if self.gate is not None:
+            self.gate.wait(5.0)
+        self._tr_index += 1
+        future = QueryFuture(self._tr_index, tr_code)
+        self.sent.append(future)
+        return future
+
+    def complete(self, future: QueryFuture) -> QueryResult:
+        result = QueryResult(future.tr_index, future.tr_code)
+        future.set_result(result)
+        return result
+
+
+def test_hit_coalesce_and_miss_share_tr_index():
+    agent = FakeAgent()
+    cache = QueryCache(agent, ttl={"c8201": 60.0})
+    miss = cache.submit("c8201", FakeInBlock(), 1)
+    coalesced = cache.submit("c8201", FakeInBlock(), 1)
+    other = cache.submit("c8201", FakeInBlock(b"y"), 1)
+    assert (miss.source, coalesced.source, other.source) == ("miss", "coalesced", "miss")
+    assert miss.tr_index == coalesced.tr_index == 101 and other.tr_index == 102
+
+    result = agent.complete(agent.sent[0])
+    assert miss.result(timeout=1.0) is coalesced.result(timeout=1.0) is result
+    hit = cache.submit("c8201", FakeInBlock(), 1)
+    assert hit.source == "hit" and hit.tr_index == 101 and hit.result(timeout=0) is result
+    assert (cache.stats.hits, cache.stats.misses, cache.stats.coalesced) == (1, 2, 1)
+
+
+def test_tr_index_follows_scheduler_dispatch():
+    """scheduler=로 보내면 전송 전에는 tr_index가 None, 전송 후에는 할당된 TrIndex"""
+    gate = threading.Event()
+    agent = FakeAgent(gate=gate)
+    with QueryScheduler(agent) as scheduler:
+        cache = QueryCache(agent, ttl={"c8201": 60.0}, scheduler=scheduler)
+        miss = cache.submit("c8201", FakeInBlock(), 1)
+        coalesced = cache.submit("c8201", FakeInBlock(), 1)
+        assert miss.tr_index is None and coalesced.tr_index is None
+
+        gate.set()
+        deadline = time.monotonic() + 5.0
+        while miss.tr_index is None and time.monotonic() < deadline:
+            time.sleep(0.005)
+        assert miss.tr_index == coalesced.tr_index == 101
+
+        agent.complete(agent.sent[0])
+        assert miss.result(timeout=1.0).tr_index == 101
+        assert cache.submit("c8201", FakeInBlock(), 1).tr_index == 101
+
+
+def test_cancel_does_not_cancel_shared_request():
+    agent = FakeAgent()
+    cache = QueryCache(agent, ttl={"c8201": 60.0})
+    first = cache.submit("c8201", FakeInBlock(), 1)
+    second = cache.submit("c8201", FakeInBlock(), 1)
+    assert first.cancel()
+    assert not agent.sent[0].cancelled()
+    result = agent.complete(agent.sent[0])
+    assert second.result(timeout=1.0) is result
+    assert len(cache) == 1
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+LatestValueStore 테스트 (DLL 불필요, OUTDATABLOCK을 직접 채워 update_from_lparam() 호출)
+
+실행:
+    uv run pytest tests/test_conflation.py
+"""
+import pytest
+
+from pynamuh.structures.inv.j8 import CTj8OutBlock, Tj8OutBlock
+from pynamuh.structures.ord.c8201 import CTc8201OutBlock1, Tc8201OutBlock1
+from pynamuh.structures.parser_info import register_block, unregister_block
+from pynamuh.wmca_conflation import LatestValueStore
+from pynamuh.wmca_simulator import render_record
+from pynamuh.wmca_transport import OutDataBlockBuffer
+
+_buffer = OutDataBlockBuffer()
+
+
+def push(store: LatestValueStore, bc: str, code: str, price: str) -> bool:
+    """실시간 틱 1건 (szData = 실시간 코드 + 구분자 + 레코드)"""
+    name = bc.encode()
+    data = name + b"|" + render_record(CTj8OutBlock, {"code": code, "price": price})
+    return store.update_from_lparam(_buffer.fill(0, name, data))
+
+
+@pytest.fixture
+def k5():
+    """테스트 도중 등록하는 실시간 블록 (j8과 같은 레이아웃)"""
+    yield "k5"
+    unregister_block("k5")
+
+
+def test_latest_value_per_code():
+    store = LatestValueStore(("j8",), capacity=2)
+    assert push(store, "j8", "005930", "70000")
+    assert push(store, "j8", "000660", "120000")
+    assert push(store, "j8", "005930", "70100")
+    assert not push(store, "j8", "035420", "200000")   # capacity 초과: 큐로 전달
+    assert store.get("j8", "005930").price == 70100
+    assert sorted(store.keys()) == [("j8", "000660"), ("j8", "005930")]
+    assert (store.stats.updates, store.stats.overflow) == (3, 1)
+
+
+def test_excluded_block_goes_to_queue():
+    store = LatestValueStore(("h1",))
+    assert not push(store, "j8", "005930", "70000")
+    assert store.stats.updates == 0 and len(store) == 0
+
+
+def test_block_registered_after_first_tick(k5):
+    """미등록 실시간 코드는 기록하지 않으므로 나중에 등록하면 그때부터 저장"""
+    store = LatestValueStore()
+    assert not push(store, k5, "005930", "70000")
+    assert not push(store, k5, "005930", "70100")
+    register_block(k5, CTj8OutBlock, Tj8OutBlock)
+    assert push(store, k5, "005930", "70200")
+    assert store.get(k5, "005930").price == 70200
+
+
+def test_reregistered_block_gets_new_table(k5):
+    store = LatestValueStore()
+    register_block(k5, CTj8OutBlock, Tj8OutBlock)
+    assert push(store, k5, "005930", "70000")
+    table = store._by_name[k5]
+
+    register_block(k5, CTj8OutBlock, Tj8OutBlock, replace=True)
+    assert push(store, k5, "000660", "120000")
+    assert store._by_name[k5] is not table
+    assert store.keys(k5) == [(k5, "000660")]
+    assert store.get(k5, "000660").price == 120000
+
+
+def test_block_unregistered_or_changed_to_array(k5):
+    store = LatestValueStore()
+    register_block(k5, CTj8OutBlock, Tj8OutBlock)
+    assert push(store, k5, "005930", "70000")
+
+    register_block(k5, CTc8201OutBlock1, Tc8201OutBlock1, is_array=True, replace=True)
+    assert not push(store, k5, "005930", "70100")       # 반복 블록: 큐로 전달
+    unregister_block(k5)
+    assert not push(store, k5, "005930", "70200")
+    assert store.get(k5, "005930").price == 70000      # 저장된 값은 계속 읽을 수 있음
+
+    register_block(k5, CTj8OutBlock, Tj8OutBlock)
+    assert push(store, k5, "005930", "70300")
+    assert store.get(k5, "005930").price == 70300
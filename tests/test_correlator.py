@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryCorrelator 테스트 (DLL 불필요)
+
+    - 같은 TrIndex의 여러 블록을 QueryResult 하나로 모음
+    - CA_RECEIVEERROR → QueryError, 연결 해제 → fail_all
+    - 취소한 TrIndex의 늦은 응답 버림
+    - TrIndex 순환 할당 시 대기/취소 중인 값 건너뜀
+
+실행:
+    uv run pytest tests/test_correlator.py
+"""
+from concurrent.futures import CancelledError
+from types import SimpleNamespace
+
+import pytest
+
+from pynamuh import WMCAAgent, WMCAMessage
+from pynamuh.structures.ord.c8201 import CTc8201InBlock
+from pynamuh.wmca_correlator import QueryCorrelator, QueryError
+from pynamuh.wmca_simulator import SimulatorTransport
+
+MESSAGE = WMCAMessage.CA_RECEIVEMESSAGE
+DATA = WMCAMessage.CA_RECEIVEDATA
+COMPLETE = WMCAMessage.CA_RECEIVECOMPLETE
+ERROR = WMCAMessage.CA_RECEIVEERROR
+
+
+def event(tr_index: int, block_name: str = None, data=None):
+    """OutDataBlock 대용 (block_name이 None이면 pData=NULL)"""
+    received = None if block_name is None else SimpleNamespace(szBlockName=block_name, szData=data)
+    return SimpleNamespace(TrIndex=tr_index, pData=received)
+
+
+class FakeInBlock:
+    """to_c_struct()만 있는 InBlock 대용"""
+
+    def to_c_struct(self):
+        return CTc8201InBlock(b"x" * 44, b" ", b"1", b" ")
+
+
+# ============================================================================
+# 라우팅
+# ============================================================================
+
+def test_blocks_routed_into_one_result():
+    correlator = QueryCorrelator()
+    future = correlator.register("c8201")
+    index = future.tr_index
+    assert correlator.route(MESSAGE, event(index, "c8201", "00000 조회 완료"))
+    assert correlator.route(DATA, event(index, "c8201OutBlock", "summary"))
+    assert correlator.route(DATA, event(index, "c8201OutBlock1", ["row1", "row2"]))
+    assert correlator.route(DATA, event(index, "c8201OutBlock1", ["row3"]))      # 반복 블록 이어 붙임
+    assert correlator.route(DATA, event(index, "c8201OutBlock2", "a"))
+    assert correlator.route(DATA, event(index, "c8201OutBlock2", "b"))           # 같은 단일 블록 두 번 → 리스트
+    assert not future.done()
+    assert correlator.route(COMPLETE, event(index))
+
+    result = future.result(timeout=0)
+    assert (result.tr_index, result.tr_code) == (index, "c8201")
+    assert result.blocks == {
+        "c8201OutBlock": "summary",
+        "c8201OutBlock1": ["row1", "row2", "row3"],
+        "c8201OutBlock2": ["a", "b"],
+    }
+    assert result["c8201OutBlock"] == "summary"
+    assert result.messages == ["00000 조회 완료"]
+    assert result.elapsed_ns > 0
+    assert (correlator.completed, correlator.failed, len(correlator)) == (1, 0, 0)
+
+
+def test_interleaved_requests_stay_separate():
+    correlator = QueryCorrelator()
+    first, second = correlator.register("c1101"), correlator.register("c8201")
+    correlator.route(DATA, event(second.tr_index, "c8201OutBlock", "b"))
+    correlator.route(DATA, event(first.tr_index, "c1101OutBlock", "a"))
+    correlator.route(COMPLETE, event(second.tr_index))
+    assert second.result(timeout=0).blocks == {"c8201OutBlock": "b"}
+    assert not first.done() and first.tr_index in correlator
+    correlator.route(COMPLETE, event(first.tr_index))
+    assert first.result(timeout=0).blocks == {"c1101OutBlock": "a"}
+
+
+def test_unknown_tr_index_is_not_handled():
+    correlator = QueryCorrelator()
+    correlator.register("c8201")
+    assert not correlator.route(DATA, event(999, "c8201OutBlock", "x"))
+    assert not correlator.route(COMPLETE, event(999))
+
+
+def test_receive_error_raises_query_error():
+    correlator = QueryCorrelator()
+    future = correlator.register("c8201")
+    correlator.route(MESSAGE, event(future.tr_index, "c8201", "99999 오류"))
+    correlator.route(DATA, event(future.tr_index, "c8201OutBlock", "partial"))
+    assert correlator.route(ERROR, event(future.tr_index))
+
+    with pytest.raises(QueryError) as info:
+        future.result(timeout=0)
+    error = info.value
+    assert (error.tr_index, error.tr_code) == (future.tr_index, "c8201")
+    assert error.messages == ["99999 오류"]
+    assert error.result.blocks == {"c8201OutBlock": "partial"}
+    assert (correlator.completed, correlator.failed, len(correlator)) == (0, 1, 0)
+
+
+def test_fail_all_on_disconnect():
+    correlator = QueryCorrelator()
+    futures = [correlator.register("c8201") for _ in range(3)]
+    cancelled = correlator.register("c1101")
+    cancelled.cancel()
+    assert correlator.fail_all(ConnectionError("연결 해제")) == 3
+    for future in futures:
+        with pytest.raises(ConnectionError):
+            future.result(timeout=0)
+    assert (len(correlator), correlator.failed) == (0, 3)
+    # 취소 기록도 지워지므로 늦은 응답은 더 이상 이 correlator가 처리하지 않음
+    assert not correlator.route(COMPLETE, event(cancelled.tr_index))
+
+
+def test_late_responses_for_cancelled_request_are_dropped():
+    correlator = QueryCorrelator()
+    future = correlator.register("c8201")
+    index = future.tr_index
+    correlator.route(DATA, event(index, "c8201OutBlock", "early"))
+    assert future.cancel()
+    with pytest.raises(CancelledError):
+        future.result(timeout=0)
+    assert index not in correlator
+
+    assert correlator.route(MESSAGE, event(index, "c8201", "late"))
+    assert correlator.route(DATA, event(index, "c8201OutBlock1", ["late"]))
+    assert correlator.route(COMPLETE, event(index))
+    assert (correlator.late, correlator.completed) == (3, 0)
+    # COMPLETE 이후에는 취소 기록이 지워짐
+    assert not correlator.route(DATA, event(index, "c8201OutBlock", "stray"))
+
+
+# ============================================================================
+# TrIndex 할당
+# ============================================================================
+
+def test_allocate_wraps_and_skips_pending_and_abandoned():
+    correlator = QueryCorrelator(first_index=1, last_index=4)
+    futures = [correlator.register("c8201") for _ in range(4)]
+    assert [future.tr_index for future in futures] == [1, 2, 3, 4]
+    with pytest.raises(RuntimeError):
+        correlator.register("c8201")            # 모두 사용 중
+
+    futures[0].cancel()                         # 1: 취소 (COMPLETE/ERROR 전까지 재사용 금지)
+    correlator.route(COMPLETE, event(3))        # 3: 완료
+    assert correlator.allocate() == 3           # 1(취소), 2(대기) 건너뜀
+    reused = correlator.register("c1101")
+    assert reused.tr_index == 3
+    with pytest.raises(RuntimeError):
+        correlator.register("c8201")            # 2, 3, 4 대기 + 1 취소
+
+    correlator.route(COMPLETE, event(1))        # 취소된 요청의 마지막 응답
+    assert correlator.register("c8201").tr_index == 1
+    assert correlator.late == 1
+
+
+def test_invalid_range():
+    with pytest.raises(ValueError):
+        QueryCorrelator(first_index=0)
+    with pytest.raises(ValueError):
+        QueryCorrelator(first_index=5, last_index=4)
+
+
+# ============================================================================
+# SimulatorTransport
+# ============================================================================
+
+def test_submit_query_with_simulator():
+    with WMCAAgent(transport=SimulatorTransport(latency=0.002), threaded=True) as agent:
+        agent.connect("u", "p", "c")
+        agent.receive_batch(timeout=1.0)
+        futures = [agent.submit_query("c8201", FakeInBlock(), 1) for _ in range(3)]
+        unsupported = agent.submit_query("c9999", FakeInBlock())
+        results = [future.result(timeout=5.0) for future in futures]
+        with pytest.raises(QueryError) as info:
+            unsupported.result(timeout=5.0)
+
+    assert len({result.tr_index for result in results}) == 3
+    for result in results:
+        assert set(result.blocks) == {"c8201OutBlock", "c8201OutBlock1"}
+        assert isinstance(result.blocks["c8201OutBlock1"], list)
+        assert len(result.messages) == 1
+    assert info.value.tr_code == "c9999" and len(info.value.messages) == 1
+
+
+def test_disconnect_fails_pending_queries():
+    with WMCAAgent(transport=SimulatorTransport(latency=0.5), threaded=True) as agent:
+        agent.connect("u", "p", "c")
+        agent.receive_batch(timeout=2.0)
+        future = agent.submit_query("c8201", FakeInBlock(), 1)
+        agent.disconnect()                      # CA_DISCONNECTED가 응답보다 먼저 도착
+        with pytest.raises(ConnectionError):
+            future.result(timeout=5.0)
+        assert len(agent.correlator) == 0
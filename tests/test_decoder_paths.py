@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+BlockDecoder 경로 일치 테스트
+
+같은 레코드를 세 경로로 디코딩해 결과가 같은지 확인합니다.
+    - native: C 확장 모듈(_fastdecode) Layout (빌드되어 있지 않으면 건너뜀)
+    - python: 생성(compile)한 순수 Python 디코더
+    - reflection: OutBlock._from_c_struct_reflect() + 필드 타입 변환 (기준 구현)
+
+실행:
+    uv run pytest tests
+"""
+import random
+from dataclasses import fields
+from typing import Any, List, Union, get_args, get_origin, get_type_hints
+
+import pytest
+
+from pynamuh.structures import decoder as decoder_module
+from pynamuh.structures.decoder import FIELD_CONVERTERS, BlockDecoder
+from pynamuh.structures.inv.j8 import CTj8OutBlock, Tj8OutBlock
+from pynamuh.structures.ord.c8201 import CTc8201OutBlock1, Tc8201OutBlock1
+
+BLOCKS = [(CTj8OutBlock, Tj8OutBlock), (CTc8201OutBlock1, Tc8201OutBlock1)]
+
+requires_native = pytest.mark.skipif(
+    decoder_module._fastdecode is None, reason="_fastdecode 미빌드 (tools/build_fastdecode.py)"
+)
+
+
+# ============================================================================
+# 레코드 생성 / 기준 구현
+# ============================================================================
+
+def make_record(struct_class, values: dict) -> bytes:
+    """필드값(str)으로 고정폭 레코드 생성 (지정하지 않은 필드는 공백, 속성 바이트는 '|')"""
+    rec = bytearray()
+    for name, ctype in struct_class._fields_:
+        width = ctypes_width(ctype)
+        if name.startswith("_"):
+            rec += b"|" * width
+            continue
+        raw = values.get(name, "")
+        raw = raw if isinstance(raw, bytes) else raw.encode("cp949")
+        rec += raw[:width].rjust(width)
+    return bytes(rec)
+
+
+def ctypes_width(ctype) -> int:
+    return getattr(ctype, "_length_", 1)
+
+
+def reference(struct_class, model_class, rec: bytes, typed: bool):
+    """리플렉션 경로 + 어노테이션별 변환 + 부호 적용 (BlockDecoder와 독립된 기준 구현)"""
+    result = model_class._from_c_struct_reflect(struct_class.from_buffer_copy(rec))
+    if not typed:
+        return result
+    hints = get_type_hints(model_class)
+    negative = (
+        model_class.SIGN_FIELD is not None
+        and getattr(result, model_class.SIGN_FIELD) in model_class.NEGATIVE_SIGNS
+    )
+    for name in (f.name for f in fields(model_class)):
+        annotation = hints[name]
+        if get_origin(annotation) is Union:
+            annotation = next(arg for arg in get_args(annotation) if arg is not type(None))
+        converter = FIELD_CONVERTERS.get(annotation)
+        if converter is None:
+            continue
+        value = converter(getattr(result, name))
+        if negative and name in model_class.SIGNED_FIELDS and value is not None:
+            value = -abs(value)
+        setattr(result, name, value)
+    return result
+
+
+def python_decoder(monkeypatch, struct_class, model_class, typed: bool) -> BlockDecoder:
+    with monkeypatch.context() as patch:
+        patch.setattr(decoder_module, "_fastdecode", None)
+        decoder = BlockDecoder(struct_class, model_class, typed)
+    assert not decoder.native
+    return decoder
+
+
+def native_decoder(struct_class, model_class, typed: bool) -> BlockDecoder:
+    decoder = BlockDecoder(struct_class, model_class, typed)
+    assert decoder.native
+    return decoder
+
+
+def fields_of(result, model_class) -> List[Any]:
+    """OutBlock 또는 BlockView의 필드값 목록"""
+    return [getattr(result, f.name) for f in fields(model_class)]
+
+
+# ============================================================================
+# 테스트 레코드
+# ============================================================================
+
+J8_CASES = {
+    "rise": {"code": "005930", "time": "09:00:01", "sign": "2", "change": "500", "price": "70000",
+             "chrate": "0.72", "volume": "123456", "volrate": "98.5"},
+    "fall": {"code": "005930", "time": "153000", "sign": "5", "change": "1200", "price": "68800",
+             "chrate": "1.71"},
+    "fall_already_negative": {"code": "000660", "time": "0900", "sign": "5", "change": "-120",
+                              "chrate": "-1.5"},
+    "empty": {"code": "005930"},
+    "malformed": {"code": "005930", "time": "99:00:00", "sign": "5", "change": "12a",
+                  "price": "7 0", "chrate": "1.x", "volume": "+0000500", "value": "1,234"},
+    "nul_in_field": {"code": "005930", "time": b"09\x0000:01", "change": b"1\x0023", "price": "70000"},
+}
+
+C8201_CASES = {
+    "korean_name": {"issue_codez6": "005930", "issue_namez40": "삼성전자", "bal_qtyz16": "10",
+                    "slby_amtz16": "68000.50", "earn_ratez9": "-2.35", "prsnt_pricez16": "70000"},
+    "empty": {},
+    "invalid_cp949": {"issue_codez6": "000660", "issue_namez40": b"\xff\xfe\x80SK", "bal_qtyz16": "1,000"},
+}
+
+
+RECORDS = [
+    pytest.param(CTj8OutBlock, Tj8OutBlock, make_record(CTj8OutBlock, values), id=f"j8-{name}")
+    for name, values in J8_CASES.items()
+] + [
+    pytest.param(CTc8201OutBlock1, Tc8201OutBlock1, make_record(CTc8201OutBlock1, values), id=f"c8201-{name}")
+    for name, values in C8201_CASES.items()
+]
+
+
+def corrupted_records(struct_class, count: int = 200) -> List[bytes]:
+    """정상 레코드의 임의 바이트를 NUL/공백/비ASCII/숫자/부호로 바꾼 손상 레코드"""
+    rng = random.Random(20260105)
+    base = make_record(struct_class, J8_CASES["fall"] if struct_class is CTj8OutBlock
+                       else C8201_CASES["korean_name"])
+    noise = b"\x00 \x80\xa1\xb0\xff0123456789-+.,:ab|"
+    records = []
+    for _ in range(count):
+        rec = bytearray(base)
+        for _ in range(rng.randint(1, 8)):
+            rec[rng.randrange(len(rec))] = rng.choice(noise)
+        records.append(bytes(rec))
+    return records
+
+
+# ============================================================================
+# 테스트
+# ============================================================================
+
+@pytest.mark.parametrize("typed", [True, False], ids=["typed", "str"])
+@pytest.mark.parametrize("struct_class, model_class, rec", RECORDS)
+def test_python_matches_reflection(monkeypatch, struct_class, model_class, rec, typed):
+    decoder = python_decoder(monkeypatch, struct_class, model_class, typed)
+    expected = reference(struct_class, model_class, rec, typed)
+    assert decoder.decode(rec) == expected
+    assert fields_of(decoder.view(rec), model_class) == fields_of(expected, model_class)
+
+
+@requires_native
+@pytest.mark.parametrize("typed", [True, False], ids=["typed", "str"])
+@pytest.mark.parametrize("struct_class, model_class, rec", RECORDS)
+def test_native_matches_reflection(struct_class, model_class, rec, typed):
+    decoder = native_decoder(struct_class, model_class, typed)
+    expected = reference(struct_class, model_class, rec, typed)
+    assert decoder.decode(rec) == expected
+    assert fields_of(decoder.view(rec), model_class) == fields_of(expected, model_class)
+
+
+@pytest.mark.parametrize("typed", [True, False], ids=["typed", "str"])
+@pytest.mark.parametrize("struct_class, model_class", BLOCKS, ids=["j8", "c8201"])
+def test_corrupted_records_agree(monkeypatch, struct_class, model_class, typed):
+    """손상된 레코드도 예외 없이 세 경로가 같은 결과 (배열/컬럼 디코딩 포함)"""
+    records = corrupted_records(struct_class)
+    buf = b"".join(records)
+    expected = [reference(struct_class, model_class, rec, typed) for rec in records]
+
+    decoders = [python_decoder(monkeypatch, struct_class, model_class, typed)]
+    if decoder_module._fastdecode is not None:
+        decoders.append(native_decoder(struct_class, model_class, typed))
+    for decoder in decoders:
+        assert [decoder.decode(rec) for rec in records] == expected
+        assert decoder.decode_array(buf, len(records)) == expected
+        columns = decoder.decode_columns(buf, len(records))
+        for name in columns:
+            assert columns[name] == [getattr(r, name) for r in expected], name
+
+
+def test_sign_field_decides_sign(monkeypatch):
+    rec = make_record(CTj8OutBlock, J8_CASES["fall_already_negative"])
+    decoders = [python_decoder(monkeypatch, CTj8OutBlock, Tj8OutBlock, True)]
+    if decoder_module._fastdecode is not None:
+        decoders.append(native_decoder(CTj8OutBlock, Tj8OutBlock, True))
+    for decoder in decoders:
+        result = decoder.decode(rec)
+        assert (result.change, str(result.chrate)) == (-120, "-1.5")
+
+
+def test_malformed_fields_decode_to_none(monkeypatch):
+    rec = make_record(CTj8OutBlock, J8_CASES["malformed"])
+    decoders = [python_decoder(monkeypatch, CTj8OutBlock, Tj8OutBlock, True)]
+    if decoder_module._fastdecode is not None:
+        decoders.append(native_decoder(CTj8OutBlock, Tj8OutBlock, True))
+    for decoder in decoders:
+        result = decoder.decode(rec)
+        assert (result.time, result.change, result.price, result.chrate) == (None, None, None, None)
+        assert (result.volume, result.value) == (500, 1234)
+
+
+@pytest.mark.parametrize("struct_class, model_class", BLOCKS, ids=["j8", "c8201"])
+def test_short_buffer_raises(monkeypatch, struct_class, model_class):
+    rec = make_record(struct_class, {})[:-1]
+    decoders = [python_decoder(monkeypatch, struct_class, model_class, True)]
+    if decoder_module._fastdecode is not None:
+        decoders.append(native_decoder(struct_class, model_class, True))
+    for decoder in decoders:
+        with pytest.raises(ValueError):
+            decoder.decode(rec)
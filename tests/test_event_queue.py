@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+BoundedEventQueue 테스트 (DLL 불필요, 큐를 직접 구동)
+
+    - 넘침 정책 4종 (block / drop_oldest / drop_newest / conflate)
+    - 버리지 않는 메시지와 버릴 수 있는 시세의 도착 순서
+    - close()가 대기 중인 생산자를 깨움
+    - DropStats 집계
+
+실행:
+    uv run pytest tests/test_event_queue.py
+"""
+import queue
+import threading
+import time
+from types import SimpleNamespace
+
+import pytest
+
+from pynamuh.wmca_agent import WMCAMessage
+from pynamuh.structures.inv.j8 import CTj8OutBlock, Tj8OutBlock
+from pynamuh.structures.parser_info import register_block, unregister_block
+from pynamuh.wmca_event_queue import BoundedEventQueue
+
+SISE = WMCAMessage.CA_RECEIVESISE
+DATA = WMCAMessage.CA_RECEIVEDATA
+
+
+def tick(code: str, n: int, block: str = "j8") -> tuple:
+    """실시간 시세 이벤트 (szData 앞 6바이트가 종목코드)"""
+    return (SISE, SimpleNamespace(szBlockName=block, szData=code.encode() + b"|%05d" % n))
+
+
+def reply(n: int) -> tuple:
+    """TR 응답 이벤트 (버리지 않는 메시지)"""
+    return (DATA, SimpleNamespace(szBlockName="c8201OutBlock", szData=b"%05d" % n))
+
+
+def make_queue(capacity: int, policy: str, blocking: bool = True) -> BoundedEventQueue:
+    return BoundedEventQueue(capacity, {SISE: policy}, blocking=blocking, report_interval=0.0)
+
+
+def drain(q: BoundedEventQueue) -> list:
+    items = []
+    while not q.empty():
+        items.append(q.get_nowait())
+    return items
+
+
+def ticks_of(items) -> list:
+    return [bytes(item[1].szData) for item in items]
+
+
+# ============================================================================
+# 넘침 정책
+# ============================================================================
+
+def test_drop_oldest_keeps_newest_ticks():
+    q = make_queue(3, "drop_oldest")
+    for n in range(5):
+        q.put(tick("005930", n))
+    assert ticks_of(drain(q)) == [b"005930|%05d" % n for n in (2, 3, 4)]
+    assert (q.drops.dropped_oldest, q.drops.dropped_newest, q.drops.total) == (2, 0, 2)
+    assert q.drops.by_block == {"j8": 2}
+
+
+def test_drop_newest_keeps_oldest_ticks():
+    q = make_queue(3, "drop_newest")
+    for n in range(5):
+        q.put(tick("005930", n))
+    assert ticks_of(drain(q)) == [b"005930|%05d" % n for n in (0, 1, 2)]
+    assert (q.drops.dropped_oldest, q.drops.dropped_newest, q.drops.total) == (0, 2, 2)
+
+
+def test_conflate_only_when_full():
+    q = make_queue(3, "conflate")
+    q.put(tick("005930", 0))
+    q.put(tick("005930", 1))        # 여유가 있으면 중간 틱도 그대로 적재
+    q.put(tick("000660", 2))
+    assert q.drops.conflated == 0 and q.qsize() == 3
+
+    q.put(tick("005930", 3))        # 가득 참: 같은 종목의 가장 최근 틱(1) 자리를 교체
+    q.put(tick("035720", 4))        # 가득 참 + 교체할 틱 없음: drop_oldest
+    assert ticks_of(drain(q)) == [b"005930|00003", b"000660|00002", b"035720|00004"]
+    assert (q.drops.conflated, q.drops.dropped_oldest, q.drops.total) == (1, 1, 1)
+
+
+@pytest.fixture
+def k3():
+    """j8과 같은 레이아웃의 두 번째 실시간 블록"""
+    register_block("k3", CTj8OutBlock, Tj8OutBlock)
+    yield "k3"
+    unregister_block("k3")
+
+
+def test_conflate_distinguishes_blocks(k3):
+    q = make_queue(2, "conflate")
+    q.put(tick("005930", 0, block="j8"))
+    q.put(tick("005930", 1, block=k3))
+    q.put(tick("005930", 2, block=k3))
+    assert [(item[1].szBlockName, bytes(item[1].szData)) for item in drain(q)] == [
+        ("j8", b"005930|00000"), (k3, b"005930|00002"),
+    ]
+    assert q.drops.conflated == 1
+
+
+def test_conflate_falls_back_to_drop_oldest_for_unregistered_block():
+    q = make_queue(2, "conflate")
+    q.put(tick("005930", 0, block="zz"))
+    q.put(tick("005930", 1, block="zz"))
+    q.put(tick("005930", 2, block="zz"))    # 종목 키를 알 수 없음
+    assert ticks_of(drain(q)) == [b"005930|00001", b"005930|00002"]
+    assert (q.drops.conflated, q.drops.dropped_oldest) == (0, 1)
+
+
+def test_conflate_follows_block_registration():
+    """등록되지 않았던 블록도 나중에 register_block()하면 합침"""
+    q = make_queue(1, "conflate")
+    q.put(tick("005930", 0, block="k4"))
+    q.put(tick("005930", 1, block="k4"))
+    assert q.drops.dropped_oldest == 1
+    register_block("k4", CTj8OutBlock, Tj8OutBlock)
+    try:
+        q.put(tick("005930", 2, block="k4"))    # 큐에 있는 틱은 종목 키 없이 들어감: drop_oldest
+        q.put(tick("005930", 3, block="k4"))
+    finally:
+        unregister_block("k4")
+    assert ticks_of(drain(q)) == [b"005930|00003"]
+    assert (q.drops.conflated, q.drops.dropped_oldest) == (1, 2)
+
+
+def test_block_waits_for_consumer():
+    q = make_queue(2, "block")
+    q.put(tick("005930", 0))
+    q.put(tick("005930", 1))
+    with pytest.raises(queue.Full):
+        q.put(tick("005930", 2), timeout=0.05)
+
+    done = threading.Event()
+
+    def producer():
+        q.put(tick("005930", 3))
+        done.set()
+
+    thread = threading.Thread(target=producer, daemon=True)
+    thread.start()
+    assert not done.wait(0.1)       # 가득 차 대기 중
+    assert ticks_of([q.get(timeout=1)]) == [b"005930|00000"]
+    assert done.wait(2.0)
+    thread.join(2.0)
+    assert ticks_of(drain(q)) == [b"005930|00001", b"005930|00003"]
+    assert q.drops.total == 0 and q.stats.producer_waits >= 2
+
+
+def test_block_policy_overcommits_without_blocking():
+    """기본 모드(blocking=False): 버리지 않는 메시지를 capacity를 넘겨 적재"""
+    q = make_queue(2, "drop_oldest", blocking=False)
+    for n in range(3):
+        q.put(reply(n))
+    assert q.qsize() == 3 and q.drops.overcommitted == 1
+
+
+def test_invalid_arguments():
+    with pytest.raises(ValueError):
+        BoundedEventQueue(0)
+    with pytest.raises(ValueError):
+        BoundedEventQueue(4, {SISE: "latest"})
+
+
+# ============================================================================
+# 순서
+# ============================================================================
+
+@pytest.mark.parametrize("policy", ["drop_oldest", "drop_newest", "conflate"])
+def test_protected_events_keep_arrival_order(policy):
+    q = make_queue(10, policy)
+    expected = []
+    for n in range(6):
+        event = reply(n) if n % 2 else tick("%06d" % n, n)
+        q.put(event)
+        expected.append(event)
+    assert drain(q) == expected
+
+
+@pytest.mark.parametrize("policy", ["drop_oldest", "drop_newest", "conflate"])
+def test_protected_event_pushes_out_oldest_tick(policy):
+    q = make_queue(3, policy)
+    q.put(tick("005930", 0))
+    q.put(reply(1))
+    q.put(tick("000660", 2))
+    q.put(reply(3))                 # 가득 참: 정책과 관계없이 가장 오래된 시세를 밀어냄
+    assert drain(q) == [reply(1), tick("000660", 2), reply(3)]
+    assert (q.drops.dropped_oldest, q.drops.dropped_newest) == (1, 0)
+
+
+def test_tick_dropped_when_queue_holds_only_protected_events():
+    q = make_queue(2, "drop_oldest")
+    q.put(reply(0))
+    q.put(reply(1))
+    q.put(tick("005930", 2))        # 밀어낼 시세가 없으면 새 시세를 버림
+    assert drain(q) == [reply(0), reply(1)]
+    assert q.drops.dropped_oldest == 1 and q.drops.by_block == {"j8": 1}
+
+
+# ============================================================================
+# 종료
+# ============================================================================
+
+def test_close_wakes_blocked_producer():
+    q = make_queue(1, "drop_oldest")
+    q.put(reply(0))
+    finished = threading.Event()
+
+    def producer():
+        q.put(reply(1))             # 밀어낼 시세가 없어 대기
+        finished.set()
+
+    thread = threading.Thread(target=producer, daemon=True)
+    thread.start()
+    deadline = time.monotonic() + 2.0
+    while not q._producer_waiting and time.monotonic() < deadline:
+        time.sleep(0.01)
+    assert q._producer_waiting
+
+    q.close()
+    assert finished.wait(2.0)
+    thread.join(2.0)
+    assert q.drops.closed_drops == 1
+
+    q.put(tick("005930", 2))        # 닫힌 뒤 도착한 이벤트는 버림
+    assert q.drops.closed_drops == 2
+    assert drain(q) == [reply(0)]
+
+
+def test_close_wakes_waiting_consumer():
+    q = make_queue(4, "drop_oldest")
+    result = []
+    thread = threading.Thread(target=lambda: result.append(q.wait(5.0)), daemon=True)
+    thread.start()
+    time.sleep(0.05)
+    q.close()
+    thread.join(2.0)
+    assert result == [False]
+
+
+# ============================================================================
+# DropStats
+# ============================================================================
+
+def test_drop_stats_by_reason_and_block():
+    q = make_queue(2, "drop_oldest")
+    q.put(tick("005930", 0, block="j8"))
+    q.put(tick("005930", 1, block="h1"))
+    q.put(tick("005930", 2, block="j8"))    # j8 밀려남
+    q.put(tick("005930", 3, block="j8"))    # h1 밀려남
+    q.put(tick("005930", 4, block="j8"))    # j8 밀려남
+    drops = q.drops
+    assert (drops.dropped_oldest, drops.total) == (3, 3)
+    assert drops.by_block == {"j8": 2, "h1": 1}
+    assert (drops.conflated, drops.overcommitted, drops.closed_drops) == (0, 0, 0)
+
+
+def test_drop_stats_mixed_policies():
+    q = BoundedEventQueue(2, {SISE: "drop_newest"}, report_interval=0.0)
+    q.put(tick("005930", 0))
+    q.put(tick("000660", 1))
+    q.put(tick("035720", 2))        # drop_newest
+    q.put(reply(3))                 # 버리지 않는 메시지: 가장 오래된 시세를 밀어냄
+    assert (q.drops.dropped_newest, q.drops.dropped_oldest, q.drops.total) == (1, 1, 2)
+    assert drain(q) == [tick("000660", 1), reply(3)]
+    assert q.stats.count == 2 and q.stats.max_depth == 2
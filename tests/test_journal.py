@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+TickJournal 테스트 (DLL 불필요)
+
+    - 손상된 꼬리 복구 (찢어진 레코드/쓰레기 바이트)
+    - chunk_size 경계를 여러 번 넘는 확장 (백그라운드 맵 준비 + 펌프 스레드 대체 경로)
+    - 자정 교체 (미리 연 다음 날짜 파일 / 동기 교체)
+
+실행:
+    uv run pytest tests/test_journal.py
+"""
+import os
+import time
+from datetime import datetime
+
+import pytest
+
+from pynamuh import wmca_journal
+from pynamuh.wmca_journal import KIND_SESSION, TickJournal, read_journal
+
+KIND = 4    # CA_RECEIVESISE
+HEADER_SIZE = 16
+
+
+class FakeClock:
+    """wmca_journal.datetime 대체 (now()만 고정값 반환)"""
+
+    current = datetime(2026, 1, 5, 12, 0, 0)
+
+    class datetime(datetime):
+        @classmethod
+        def now(cls, tz=None):
+            return FakeClock.current
+
+
+@pytest.fixture
+def clock(monkeypatch):
+    FakeClock.current = datetime(2026, 1, 5, 12, 0, 0)
+    monkeypatch.setattr(wmca_journal, "datetime", FakeClock.datetime)
+    return FakeClock
+
+
+def payload(i: int) -> bytes:
+    return b"j8|%06d|" % i + b"x" * (i % 97)
+
+
+def write(journal: TickJournal, start: int, count: int):
+    for i in range(start, start + count):
+        journal.append(KIND, b"j8", payload(i))
+
+
+def datas(path) -> list:
+    return [record.data for record in read_journal(path)]
+
+
+# ============================================================================
+# 꼬리 복구
+# ============================================================================
+
+def test_torn_tail_is_recovered_and_appends_resume(tmp_path, clock):
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        write(journal, 0, 50)
+        path = journal.path
+    size = os.path.getsize(path)
+
+    # 마지막 레코드를 찢고 뒤에 쓰레기를 붙임 (비정상 종료)
+    with open(path, "r+b") as f:
+        f.truncate(size - 5)
+        f.seek(0, os.SEEK_END)
+        f.write(b"\x07" * 100)
+    assert datas(path) == [payload(i) for i in range(49)]
+
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        last_len = len(payload(49)) + 2 + 20    # 레코드 헤더 20바이트 + 블록명
+        assert journal.recovered_bytes == last_len - 5 + 100
+        write(journal, 100, 3)
+
+    assert datas(path) == [payload(i) for i in range(49)] + [payload(i) for i in range(100, 103)]
+    kinds = [r.kind for r in read_journal(path, kind=KIND)]
+    assert kinds == [KIND] * 52
+
+
+def test_garbage_only_tail_keeps_every_record(tmp_path, clock):
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        write(journal, 0, 20)
+        path = journal.path
+    with open(path, "ab") as f:
+        f.write(b"\xff" * 33)
+
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        assert journal.recovered_bytes == 33
+        write(journal, 20, 1)
+    assert datas(path) == [payload(i) for i in range(21)]
+
+
+def test_clean_reopen_recovers_nothing(tmp_path, clock):
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        write(journal, 0, 5)
+        path = journal.path
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        assert journal.recovered_bytes == 0
+    assert datas(path) == [payload(i) for i in range(5)]
+
+
+# ============================================================================
+# 확장
+# ============================================================================
+
+def test_growth_across_many_chunks(tmp_path, clock):
+    journal = TickJournal(tmp_path, chunk_size=4096)
+    write(journal, 0, 3000)
+    journal.append(KIND, b"j8", b"y" * 20000)   # chunk_size보다 큰 레코드
+    write(journal, 3000, 10)
+    path, written = journal.path, journal.bytes_written
+    assert journal._capacity > 40 * 4096
+    journal.close()
+
+    assert os.path.getsize(path) == HEADER_SIZE + written     # 기록된 길이로 잘라냄
+    expected = [payload(i) for i in range(3000)] + [b"y" * 20000] + [payload(i) for i in range(3000, 3010)]
+    assert datas(path) == expected
+
+
+def test_flush_during_growth(tmp_path, clock):
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        for i in range(500):
+            journal.append(KIND, b"j8", payload(i))
+            if i % 37 == 0:
+                journal.flush()
+        path = journal.path
+    assert datas(path) == [payload(i) for i in range(500)]
+
+
+# ============================================================================
+# 자정 교체
+# ============================================================================
+
+@pytest.mark.parametrize("prepared", [True, False], ids=["prepared", "synchronous"])
+def test_forced_rotation_opens_next_day_and_truncates_old(tmp_path, clock, prepared):
+    clock.current = datetime(2026, 1, 5, 23, 59, 30) if prepared else datetime(2026, 1, 5, 12, 0, 0)
+    journal = TickJournal(tmp_path, chunk_size=4096)
+    old_path = journal.path
+    assert old_path.name == "sise_20260105.wj"
+    write(journal, 0, 10)       # 자정 1분 전이면 여기서 다음 날짜 파일 준비 요청
+    old_written = journal.bytes_written
+    prepared_segment = None
+    if prepared:
+        deadline = time.monotonic() + 5.0
+        while journal._next_segment is None and time.monotonic() < deadline:
+            time.sleep(0.01)
+        prepared_segment = journal._next_segment
+        assert prepared_segment is not None and prepared_segment.path.name == "sise_20260106.wj"
+
+    clock.current = datetime(2026, 1, 6, 0, 0, 1)
+    journal._rotate_at_ns = 0
+    write(journal, 10, 5)
+    new_path = journal.path
+    assert new_path.name == "sise_20260106.wj"
+    if prepared:
+        assert journal._mm is prepared_segment.mm      # 미리 연 파일로 참조만 교체
+    journal.close()
+
+    assert os.path.getsize(old_path) == HEADER_SIZE + old_written
+    assert datas(old_path) == [payload(i) for i in range(10)]
+    assert datas(new_path) == [payload(i) for i in range(10, 15)]
+    # 새 파일은 세션 레코드로 시작
+    with open(new_path, "rb") as f:
+        assert f.read()[HEADER_SIZE + 16:HEADER_SIZE + 18] == KIND_SESSION.to_bytes(2, "little")
+    assert sorted(p.name for p in tmp_path.iterdir()) == ["sise_20260105.wj", "sise_20260106.wj"]
+
+
+def test_unused_prepared_file_is_removed_on_close(tmp_path, clock):
+    clock.current = datetime(2026, 1, 5, 23, 59, 30)
+    with TickJournal(tmp_path, chunk_size=4096) as journal:
+        write(journal, 0, 3)
+    assert [p.name for p in tmp_path.iterdir()] == ["sise_20260105.wj"]
+
+
+def test_rotation_disabled(tmp_path, clock):
+    with TickJournal(tmp_path, chunk_size=4096, rotate_daily=False) as journal:
+        clock.current = datetime(2026, 1, 6, 0, 0, 1)
+        write(journal, 0, 3)
+        assert journal.path.name == "sise_20260105.wj"
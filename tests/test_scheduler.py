@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+QueryScheduler 테스트 (DLL 불필요)
+
+    - 한도(RateLimit) 안에서의 전송 간격, 우선순위 순서
+    - wmcaQuery 호출 실패(RuntimeError) 재시도
+    - close(cancel_pending=False/True)
+    - SimulatorTransport + WMCAAgent로 응답까지 받는 경로
+
+실행:
+    uv run pytest tests/test_scheduler.py
+"""
+import threading
+import time
+
+import pytest
+
+from pynamuh import WMCAAgent
+from pynamuh.structures.ord.c8201 import CTc8201InBlock
+from pynamuh.wmca_correlator import QueryFuture, QueryResult
+from pynamuh.wmca_scheduler import Priority, QueryScheduler, RateLimit
+from pynamuh.wmca_simulator import SimulatorTransport
+
+# time.monotonic() 해상도/스레드 깨움 지연 여유
+SLACK = 0.01
+
+
+class FakeInBlock:
+    """to_c_struct()만 있는 InBlock 대용"""
+
+    def to_c_struct(self):
+        return CTc8201InBlock(b"x" * 44, b" ", b"1", b" ")
+
+
+class StubAgent:
+    """submit_query() 호출 기록. fail이 남아 있으면 그 횟수만큼 RuntimeError, gate가 있으면 첫 호출에서 대기"""
+
+    threaded = True
+
+    def __init__(self, fail: int = 0, gate: threading.Event = None):
+        self.fail = fail
+        self.gate = gate
+        self.calls = []             # (TR 코드, 호출 시각)
+        self._tr_index = 0
+
+    def submit_query(self, tr_code, szInput, nAccountIndex=0):
+        self.calls.append((tr_code, time.monotonic()))
+        if self.gate is not None:
+            self.gate.wait(5.0)
+            self.gate = None
+        if self.fail:
+            self.fail -= 1
+            raise RuntimeError("wmcaQuery 호출 실패")
+        self._tr_index += 1
+        future = QueryFuture(self._tr_index, tr_code)
+        future.set_result(QueryResult(self._tr_index, tr_code))
+        return future
+
+    @property
+    def codes(self):
+        return [code for code, _ in self.calls]
+
+
+def wait_all(futures, timeout: float = 5.0):
+    return [future.result(timeout=timeout) for future in futures]
+
+
+# ============================================================================
+# 한도
+# ============================================================================
+
+def test_rate_window_paces_dispatch():
+    agent = StubAgent()
+    with QueryScheduler(agent, limits={"c8201": RateLimit(2, 0.2)}) as scheduler:
+        futures = [scheduler.submit("c8201", FakeInBlock()) for _ in range(6)]
+        wait_all(futures)
+
+    times = [at for _, at in agent.calls]
+    for earlier, later in zip(times, times[2:]):
+        assert later - earlier >= 0.2 - SLACK      # 0.2초 동안 최대 2건
+    dispatched = [future.dispatched_at for future in futures]
+    assert dispatched == sorted(dispatched)
+    assert futures[-1].wait_ns >= (0.4 - SLACK) * 1e9
+    assert scheduler.stats.dispatched == 6 and scheduler.stats.throttled > 0
+    assert scheduler.stats.wait_by_code["c8201"].count == 6
+
+
+def test_throttled_code_does_not_block_other_codes():
+    agent = StubAgent()
+    with QueryScheduler(agent, limits={"c8201": RateLimit(1, 0.3)}) as scheduler:
+        looks = [scheduler.submit("c8201", FakeInBlock()) for _ in range(3)]
+        other = scheduler.submit("c1101", FakeInBlock())
+        wait_all(looks + [other])
+    assert agent.codes.index("c1101") < 2
+    assert other.wait_ns < looks[1].wait_ns
+
+
+def test_global_limit_spans_codes():
+    agent = StubAgent()
+    with QueryScheduler(agent, global_limit=RateLimit(2, 0.2)) as scheduler:
+        futures = [scheduler.submit(code, FakeInBlock()) for code in ("c8201", "c1101", "c1151", "c8201")]
+        wait_all(futures)
+    times = [at for _, at in agent.calls]
+    assert times[2] - times[0] >= 0.2 - SLACK and times[3] - times[1] >= 0.2 - SLACK
+
+
+# ============================================================================
+# 우선순위
+# ============================================================================
+
+def test_priority_order():
+    gate = threading.Event()
+    agent = StubAgent(gate=gate)
+    with QueryScheduler(agent) as scheduler:
+        first = scheduler.submit("c1101", FakeInBlock())        # 전송 스레드를 붙잡아 둠
+        while not agent.calls:
+            time.sleep(0.005)
+        low = scheduler.submit("c1151", FakeInBlock(), priority=Priority.LOW)
+        normal1 = scheduler.submit("c8201", FakeInBlock())
+        normal2 = scheduler.submit("c1101", FakeInBlock())
+        high = scheduler.submit("c1153", FakeInBlock(), priority=Priority.HIGH)
+        order = scheduler.submit("c8102", FakeInBlock())         # 주문 TR: Priority.ORDER
+        assert order.priority == Priority.ORDER and scheduler.queue_depth == 5
+        gate.set()
+        wait_all([first, low, normal1, normal2, high, order])
+
+    assert agent.codes == ["c1101", "c8102", "c1153", "c8201", "c1101", "c1151"]
+    dispatched = [f.dispatched_at for f in (order, high, normal1, normal2, low)]
+    assert dispatched == sorted(dispatched)
+
+
+def test_cancel_before_dispatch_skips_request():
+    gate = threading.Event()
+    agent = StubAgent(gate=gate)
+    with QueryScheduler(agent) as scheduler:
+        first = scheduler.submit("c1101", FakeInBlock())
+        while not agent.calls:
+            time.sleep(0.005)
+        cancelled = scheduler.submit("c8201", FakeInBlock())
+        kept = scheduler.submit("c1151", FakeInBlock())
+        assert cancelled.cancel()
+        gate.set()
+        wait_all([first, kept])
+    assert agent.codes == ["c1101", "c1151"]
+    assert cancelled.wait_ns is None and scheduler.stats.cancelled == 1
+
+
+# ============================================================================
+# 재시도
+# ============================================================================
+
+def test_retry_after_runtime_error():
+    agent = StubAgent(fail=2)
+    with QueryScheduler(agent, max_retries=2, retry_delay=0.05) as scheduler:
+        future = scheduler.submit("c8201", FakeInBlock())
+        result = future.result(timeout=5.0)
+    assert result.tr_code == "c8201"
+    assert future.attempts == 3 and future.tr_index == result.tr_index
+    times = [at for _, at in agent.calls]
+    assert all(later - earlier >= 0.05 - SLACK for earlier, later in zip(times, times[1:]))
+    assert (scheduler.stats.retries, scheduler.stats.failed, scheduler.stats.dispatched) == (2, 0, 1)
+
+
+def test_retries_exhausted_fails_future():
+    agent = StubAgent(fail=5)
+    with QueryScheduler(agent, max_retries=2, retry_delay=0.01) as scheduler:
+        future = scheduler.submit("c8201", FakeInBlock())
+        with pytest.raises(RuntimeError, match="wmcaQuery"):
+            future.result(timeout=5.0)
+    assert future.attempts == 3 and len(agent.calls) == 3
+    assert (scheduler.stats.retries, scheduler.stats.failed) == (2, 1)
+
+
+def test_retry_keeps_queue_position():
+    """재시도 요청은 같은 우선순위/TR 코드 큐의 맨 앞으로 돌아감"""
+    agent = StubAgent(fail=1)
+    with QueryScheduler(agent, retry_delay=0.05) as scheduler:
+        futures = [scheduler.submit("c8201", FakeInBlock()) for _ in range(3)]
+        wait_all(futures)
+    dispatched = [future.dispatched_at for future in futures]
+    assert dispatched == sorted(dispatched) and futures[0].attempts == 2
+
+
+# ============================================================================
+# 종료
+# ============================================================================
+
+def test_close_drains_pending_requests():
+    agent = StubAgent(fail=1)
+    scheduler = QueryScheduler(agent, limits={"c8201": RateLimit(1, 0.05)}, retry_delay=0.02)
+    futures = [scheduler.submit("c8201", FakeInBlock()) for _ in range(5)]
+    scheduler.close(cancel_pending=False)
+    assert all(future.done() and not future.cancelled() for future in futures)
+    assert scheduler.stats.dispatched == 5 and scheduler.queue_depth == 0
+    with pytest.raises(RuntimeError):
+        scheduler.submit("c8201", FakeInBlock())
+
+
+def test_close_cancels_pending_requests():
+    gate = threading.Event()
+    agent = StubAgent(gate=gate)
+    scheduler = QueryScheduler(agent)
+    first = scheduler.submit("c1101", FakeInBlock())
+    while not agent.calls:
+        time.sleep(0.005)
+    pending = [scheduler.submit("c8201", FakeInBlock()) for _ in range(3)]
+    threading.Timer(0.1, gate.set).start()
+    scheduler.close()
+    assert first.result(timeout=1.0).tr_code == "c1101"
+    assert all(future.cancelled() for future in pending)
+    assert agent.codes == ["c1101"] and scheduler.stats.cancelled == 3
+
+
+# ============================================================================
+# SimulatorTransport
+# ============================================================================
+
+def test_scheduler_with_simulator():
+    with WMCAAgent(transport=SimulatorTransport(latency=0.002), threaded=True) as agent:
+        agent.connect("u", "p", "c")
+        agent.receive_batch(timeout=1.0)
+        with QueryScheduler(agent, limits={"c8201": RateLimit(3, 0.2)}) as scheduler:
+            futures = [scheduler.submit("c8201", FakeInBlock(), 1) for _ in range(7)]
+            results = wait_all(futures)
+
+    assert all("c8201OutBlock" in result.blocks for result in results)
+    assert [result.tr_index for result in results] == [future.tr_index for future in futures]
+    assert len({result.tr_index for result in results}) == 7
+    dispatched = [future.dispatched_at for future in futures]
+    assert dispatched[3] - dispatched[0] >= 0.2 - SLACK and dispatched[6] - dispatched[3] >= 0.2 - SLACK
+    assert futures[-1].wait_ns >= (0.4 - SLACK) * 1e9
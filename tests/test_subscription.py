@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+SubscriptionManager 테스트 (wmcaAttach/wmcaDetach 호출을 기록하는 가짜 agent 사용)
+
+실행:
+    uv run pytest tests/test_subscription.py
+"""
+from pynamuh.wmca_subscription import SubscriptionManager
+
+
+class FakeAgent:
+    """attach()/detach() 호출 기록. fail_attach/fail_detach가 남아 있으면 그 횟수만큼 실패"""
+
+    def __init__(self):
+        self.calls = []
+        self.fail_attach = 0
+        self.fail_detach = 0
+
+    def _call(self, kind, bc, text, code_len, total):
+        codes = [text[i:i + code_len] for i in range(0, total, code_len)]
+        self.calls.append((kind, bc, codes))
+        attr = f"fail_{kind}"
+        if getattr(self, attr):
+            setattr(self, attr, getattr(self, attr) - 1)
+            return False
+        return True
+
+    def attach(self, bc, text, code_len, total):
+        return self._call("attach", bc, text, code_len, total)
+
+    def detach(self, bc, text, code_len, total):
+        return self._call("detach", bc, text, code_len, total)
+
+
+def test_refcount_attaches_and_detaches_once():
+    agent = FakeAgent()
+    subs = SubscriptionManager(agent)
+    assert subs.subscribe("a", "j8", ["005930", "000660"]) == 2
+    assert subs.subscribe("b", "j8", ["005930", "035420"]) == 1
+    assert subs.unsubscribe("a", "j8", ["005930"]) == 0
+    assert subs.refcount("j8", "005930") == 1
+    assert subs.release("b") == 2                 # 005930, 035420
+    assert subs.active() == {("j8", "000660")}
+    assert [kind for kind, _, _ in agent.calls] == ["attach", "attach", "detach"]
+
+
+def test_batches_split_by_size_and_code_length():
+    agent = FakeAgent()
+    subs = SubscriptionManager(agent, max_codes_per_call=2)
+    subs.subscribe("a", "j8", ["000001", "000002", "000003", "KR4101"])
+    subs.subscribe("a", "j1", ["A1234"])
+    assert agent.calls == [
+        ("attach", "j8", ["000001", "000002"]),
+        ("attach", "j8", ["000003", "KR4101"]),
+        ("attach", "j1", ["A1234"]),
+    ]
+
+
+def test_failed_attach_is_retried_by_sync():
+    agent = FakeAgent()
+    agent.fail_attach = 1
+    subs = SubscriptionManager(agent)
+    assert subs.subscribe("a", "j8", ["005930"]) == 0
+    assert subs.active() == set() and subs.stats.failed == 1
+    assert subs.sync() == (1, 0)
+    assert subs.active() == {("j8", "005930")}
+
+
+def test_failed_detach_stays_active_and_is_retried_by_sync():
+    agent = FakeAgent()
+    subs = SubscriptionManager(agent)
+    subs.subscribe("a", "j8", ["005930", "000660"])
+    agent.fail_detach = 1
+    assert subs.unsubscribe("a", "j8", ["005930"]) == 0
+    # 서버에는 아직 구독이 남아 있음
+    assert subs.active() == {("j8", "005930"), ("j8", "000660")}
+    assert subs.stats.failed == 1 and subs.stats.detached == 0
+    assert subs.sync() == (0, 1)
+    assert subs.active() == {("j8", "000660")}
+    assert agent.calls[-1] == ("detach", "j8", ["005930"])
+    assert subs.sync() == (0, 0)
+
+
+def test_failed_detach_is_not_reattached_when_subscribed_again():
+    agent = FakeAgent()
+    subs = SubscriptionManager(agent)
+    subs.subscribe("a", "j8", ["005930"])
+    agent.fail_detach = 1
+    subs.unsubscribe("a", "j8")
+    calls = len(agent.calls)
+    assert subs.subscribe("b", "j8", ["005930"]) == 0   # 서버 구독이 남아 있어 wmcaAttach 불필요
+    assert len(agent.calls) == calls
+    assert subs.sync() == (0, 0)
+
+
+def test_set_watchlist_applies_difference_and_resubscribe_reattaches():
+    agent = FakeAgent()
+    subs = SubscriptionManager(agent)
+    subs.set_watchlist("a", "j8", ["000001", "000002"])
+    assert subs.set_watchlist("a", "j8", ["000002", "000003"]) == (1, 1)
+    agent.calls.clear()
+    assert subs.resubscribe() == 2
+    assert agent.calls == [("attach", "j8", ["000002", "000003"])]
+    assert subs.close() == 2
+    assert subs.active() == set()
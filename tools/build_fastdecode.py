@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+선택적 C 확장 모듈(pynamuh.structures._fastdecode) 빌드
+
+소스 트리 안(src/pynamuh/structures/)에 확장 모듈을 빌드합니다.
+빌드하지 않아도 pynamuh는 순수 Python 디코더로 동작합니다.
+
+실행:
+    uv run --with setuptools python tools/build_fastdecode.py
+"""
+import sys
+import tempfile
+from pathlib import Path
+
+from setuptools import Extension
+from setuptools.dist import Distribution
+
+ROOT = Path(__file__).resolve().parent.parent
+SRC = ROOT / "src"
+
+
+def main() -> int:
+    extension = Extension(
+        "pynamuh.structures._fastdecode",
+        sources=[str(Path("src") / "pynamuh" / "structures" / "_fastdecode.c")],
+        # gcc/clang 경고를 모두 표시 (경고 없이 빌드되어야 함)
+        extra_compile_args=[] if sys.platform == "win32" else ["-Wall", "-Wextra"],
+    )
+    dist = Distribution({"name": "pynamuh-fastdecode", "ext_modules": [extension]})
+    dist.package_dir = {"": "src"}
+
+    with tempfile.TemporaryDirectory() as build_temp:
+        cmd = dist.get_command_obj("build_ext")
+        cmd.inplace = True
+        cmd.build_temp = build_temp
+        cmd.build_lib = build_temp
+        cmd.ensure_finalized()
+        cmd.run()
+
+    output = Path(cmd.get_ext_fullpath(extension.name)).resolve()
+    print(f"built: {output.relative_to(ROOT)}")
+    return 0
+
+
+if __name__ == "__main__":
+    import os
+
+    os.chdir(ROOT)
+    sys.exit(main())
@@ -0,0 +1,456 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+나무증권 SPEC 헤더(trio_*.h) → 블록 정의 모듈 생성기
+
+헤더의 typedef struct 블록을 읽어 TR 코드별 Python 모듈을 생성합니다.
+    - CT* : ctypes 구조체 (속성 바이트 포함, 헤더 레이아웃 그대로)
+    - T*  : InBlock(pydantic) 또는 OutBlock(dataclass) DTO (속성 바이트 제외)
+    - register_block() 호출 (등록 시점에 블록 전용 디코더가 생성됨)
+
+헤더 예시:
+    // 주식잔고조회 보유종목 (occurs)
+    typedef struct {
+        char    issue_codez6    [6];    char    _issue_codez6;      // 종목번호
+        char    issue_namez40   [40];   char    _issue_namez40;     // 종목명
+    } Tc8201OutBlock1;
+
+    - 블록명은 구조체 이름에서 앞의 'T'를 뺀 것 (Tc8201OutBlock1 → c8201OutBlock1)
+    - 2글자 코드의 OutBlock은 실시간 블록으로 코드 자체를 블록명으로 등록 (Tj8OutBlock → j8)
+    - typedef 바로 앞 주석에 'occurs' 또는 '반복'이 있거나 --array로 지정하면 반복 블록
+
+실행:
+    python tools/gen_blocks.py SDK/trio_ord.h                 # src/pynamuh/structures/ord/<TR코드>.py
+    python tools/gen_blocks.py SDK/trio_inv.h --infer-types   # 필드명으로 int/Decimal/time 추정
+    python tools/gen_blocks.py SDK/trio_ord.h --array c1101OutBlock2 --force
+
+생성된 모듈은 structures/__init__.py에서 import해야 등록됩니다. (생성기가 import 문을 출력)
+기존 파일은 --force 없이는 덮어쓰지 않습니다.
+"""
+import argparse
+import keyword
+import re
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional
+
+ROOT = Path(__file__).resolve().parent.parent
+STRUCTURES = ROOT / "src" / "pynamuh" / "structures"
+
+# C 타입 → ctypes (wmca.dll은 32비트이므로 long은 4바이트)
+C_TYPES = {
+    "char": "ctypes.c_char",
+    "short": "ctypes.c_int16",
+    "int": "ctypes.c_int32",
+    "long": "ctypes.c_int32",
+}
+
+_DEFINE = re.compile(r"^#\s*define\s+(\w+)\s+\(?\s*(\d+)\s*\)?\s*$")
+_PRAGMA_PACK = re.compile(r"^#\s*pragma\s+pack\s*\(\s*(?:push\s*,\s*)?(\d+)?\s*\)")
+_PRAGMA_POP = re.compile(r"^#\s*pragma\s+pack\s*\(\s*pop\s*\)")
+_TYPEDEF = re.compile(r"^typedef\s+struct\b\s*\w*\s*(\{)?")
+_STRUCT_END = re.compile(r"^\}\s*([^;]*);")
+_DECL = re.compile(
+    r"(?:unsigned\s+|signed\s+)?(char|short|int|long)\s+(\w+)\s*(?:\[\s*(\w+)\s*\])?\s*;"
+)
+_BLOCK_NAME = re.compile(r"^T?(?P<code>[A-Za-z0-9]+?)(?P<kind>InBlock|OutBlock)(?P<index>\d*)$")
+
+
+# ============================================================================
+# 헤더 파싱
+# ============================================================================
+
+@dataclass
+class CField:
+    """C 구조체 필드"""
+    name: str
+    ctype: str      # char, short, int, long
+    length: int     # 배열 길이 (배열이 아니면 1)
+    comment: str = ""
+
+    @property
+    def is_attribute(self) -> bool:
+        """속성 바이트 필드 (_필드명)"""
+        return self.name.startswith("_")
+
+
+@dataclass
+class CStruct:
+    """C 구조체 (typedef struct)"""
+    name: str
+    fields: List[CField]
+    comment: str = ""
+    pack: Optional[int] = None
+    line: int = 0
+
+    @property
+    def block_match(self) -> Optional[re.Match]:
+        return _BLOCK_NAME.match(self.name)
+
+
+@dataclass
+class _ParseState:
+    defines: Dict[str, int] = field(default_factory=dict)
+    pack_stack: List[Optional[int]] = field(default_factory=lambda: [None])
+    last_comment: str = ""
+
+
+def _strip_block_comments(text: str) -> str:
+    """/* */ 주석을 // 주석으로 변환 (여러 줄 주석은 줄 수를 유지하며 제거)"""
+    def replace(match: re.Match) -> str:
+        body = match.group(1)
+        if "\n" in body:
+            return "\n" * body.count("\n")
+        return f"// {body.strip()}"
+    return re.sub(r"/\*(.*?)\*/", replace, text, flags=re.S)
+
+
+def parse_header(text: str, source: str = "<header>") -> List[CStruct]:
+    """헤더 텍스트에서 typedef struct 목록 추출
+
+    Raises:
+        ValueError: 해석할 수 없는 필드 선언 (줄 번호 포함)
+    """
+    state = _ParseState()
+    structs: List[CStruct] = []
+    current: Optional[CStruct] = None
+    waiting_brace = False
+
+    for lineno, raw_line in enumerate(_strip_block_comments(text).splitlines(), start=1):
+        code, _, comment = raw_line.partition("//")
+        code = code.strip()
+        comment = comment.strip()
+
+        if current is None:
+            if not code:
+                # 주석만 있는 줄은 다음 typedef의 설명으로 사용
+                if comment:
+                    state.last_comment = comment
+                continue
+            if match := _DEFINE.match(code):
+                state.defines[match.group(1)] = int(match.group(2))
+            elif _PRAGMA_POP.match(code):
+                if len(state.pack_stack) > 1:
+                    state.pack_stack.pop()
+            elif match := _PRAGMA_PACK.match(code):
+                value = int(match.group(1)) if match.group(1) else None
+                if "push" in code:
+                    state.pack_stack.append(value)
+                else:
+                    state.pack_stack[-1] = value
+            elif match := _TYPEDEF.match(code):
+                current = CStruct(
+                    name="", fields=[], comment=comment or state.last_comment,
+                    pack=state.pack_stack[-1], line=lineno,
+                )
+                waiting_brace = match.group(1) is None
+                code = code[match.end():].strip()
+                if not code:
+                    state.last_comment = ""
+                    continue
+            else:
+                state.last_comment = ""
+                continue
+            if current is None:
+                state.last_comment = ""
+                continue
+
+        if waiting_brace:
+            if not code.startswith("{"):
+                if code:
+                    raise ValueError(f"{source}:{lineno}: typedef struct 뒤에 '{{'가 없습니다")
+                continue
+            waiting_brace = False
+            code = code[1:].strip()
+
+        # 한 줄에 필드 선언과 닫는 괄호가 같이 있을 수 있음
+        closing = None
+        if "}" in code:
+            code, closing = code[:code.index("}")].strip(), code[code.index("}"):]
+
+        declarations = list(_DECL.finditer(code))
+        leftover = _DECL.sub("", code).strip()
+        if leftover:
+            raise ValueError(f"{source}:{lineno}: 해석할 수 없는 선언: {raw_line.strip()}")
+        for i, decl in enumerate(declarations):
+            ctype, name, size = decl.groups()
+            if size is None:
+                length = 1
+            elif size.isdigit():
+                length = int(size)
+            elif size in state.defines:
+                length = state.defines[size]
+            else:
+                raise ValueError(f"{source}:{lineno}: 알 수 없는 배열 크기: {size}")
+            if ctype != "char" and size is not None:
+                raise ValueError(f"{source}:{lineno}: char 이외 타입의 배열은 지원하지 않습니다: {name}")
+            # 줄 끝 주석은 첫 번째(속성 바이트가 아닌) 필드의 설명
+            current.fields.append(CField(name, ctype, length, comment if i == 0 else ""))
+
+        if closing is not None:
+            match = _STRUCT_END.match(closing)
+            names = [name.strip() for name in match.group(1).split(",")] if match else []
+            names = [name for name in names if name and not name.startswith("*")]
+            if not names:
+                raise ValueError(f"{source}:{lineno}: 구조체 이름이 없습니다")
+            current.name = names[0]
+            structs.append(current)
+            current = None
+            state.last_comment = ""
+
+    if current is not None:
+        raise ValueError(f"{source}:{current.line}: 닫히지 않은 typedef struct")
+    return structs
+
+
+# ============================================================================
+# 필드 타입 추정 (--infer-types)
+# ============================================================================
+
+_INT_TOKENS = ("qty", "amt", "price", "prc", "cnt", "pls", "volume", "vol", "value",
+               "high", "low", "open", "offer", "bid", "change")
+_DECIMAL_TOKENS = ("rt", "ratio")
+
+
+def infer_type(name: str) -> str:
+    """필드명으로 어노테이션 타입 추정 (생성 후 SPEC 문서와 대조 필요)
+
+    필드명을 '_'로 나눈 토큰에서 폭 접미사(z16, 1z16 등)를 뗀 뒤 판단합니다.
+    """
+    if name == "time":
+        return "dtime"
+    tokens = [re.sub(r"[z\d]+$", "", token) for token in name.lower().split("_")]
+    if any(token.endswith("rate") or token in _DECIMAL_TOKENS for token in tokens):
+        return "Decimal"
+    if any(token.endswith(_INT_TOKENS) for token in tokens if token):
+        return "int"
+    return "str"
+
+
+# ============================================================================
+# 코드 생성
+# ============================================================================
+
+def block_name(struct: CStruct) -> Optional[str]:
+    """레지스트리 블록명 (InBlock이거나 블록 이름 형식이 아니면 None)"""
+    match = struct.block_match
+    if match is None or match.group("kind") != "OutBlock":
+        return None
+    code = match.group("code")
+    if len(code) == 2 and not match.group("index"):
+        return code  # 실시간 블록 (예: j8)
+    return f"{code}OutBlock{match.group('index')}"
+
+
+def _quote(text: str) -> str:
+    """큰따옴표 문자열 리터럴"""
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def _check_identifier(struct: CStruct, name: str) -> None:
+    if not name.isidentifier() or keyword.iskeyword(name):
+        raise ValueError(f"{struct.name}: Python 식별자로 사용할 수 없는 필드명: {name}")
+
+
+def _aligned(lines: List[tuple[str, str]], indent: str) -> List[str]:
+    """(코드, 주석) 목록을 주석 열을 맞춰 출력"""
+    width = max((len(code) for code, comment in lines if comment), default=0)
+    result = []
+    for code, comment in lines:
+        if comment:
+            result.append(f"{indent}{code.ljust(width)}  # {comment}")
+        else:
+            result.append(f"{indent}{code}")
+    return result
+
+
+def render_ctypes(struct: CStruct, description: str) -> List[str]:
+    out = [
+        f"class CT{struct.name.removeprefix('T')}(ctypes.Structure):",
+        f'    """{description} C 구조체"""',
+    ]
+    if struct.pack is not None:
+        out.append(f"    _pack_ = {struct.pack}")
+    entries = []
+    for f in struct.fields:
+        _check_identifier(struct, f.name)
+        ctype = C_TYPES[f.ctype]
+        spec = f"{ctype} * {f.length}" if f.ctype == "char" else ctype
+        entries.append((f'("{f.name}", {spec}),', f.comment))
+    out.append("    _fields_ = [")
+    out.extend(_aligned(entries, "        "))
+    out.append("    ]")
+    return out
+
+
+def render_outblock(struct: CStruct, description: str, infer: bool, is_array: bool) -> List[str]:
+    model = struct.name if struct.name.startswith("T") else f"T{struct.name}"
+    note = "\n\n    Note:\n        - 반복 레코드\n    " if is_array else ""
+    out = ["@dataclass(slots=True)", f"class {model}(OutBlock):", f'    """{description}{note}"""', ""]
+
+    data_fields = [f for f in struct.fields if not f.is_attribute]
+    names = {f.name for f in data_fields}
+    types = {f.name: (infer_type(f.name) if infer and f.ctype == "char" else
+                      "str" if f.ctype == "char" else "int") for f in data_fields}
+
+    # j8 등 실시간 시세: 등락부호 필드가 있으면 등락폭/등락률에 부호 적용
+    if infer and "sign" in names:
+        signed = [name for name in ("change", "chrate") if types.get(name) in ("int", "Decimal")]
+        if signed:
+            out.append('    SIGN_FIELD: ClassVar[Optional[str]] = "sign"')
+            names_literal = ", ".join(_quote(name) for name in signed) + ("," if len(signed) == 1 else "")
+            out.append(f"    SIGNED_FIELDS: ClassVar[Tuple[str, ...]] = ({names_literal})")
+            out.append("")
+
+    # 타입을 추정한 문자 필드는 빈 필드/형식 오류면 None으로 디코딩됨
+    def annotation(f: CField) -> str:
+        kind = types[f.name]
+        return f"Optional[{kind}]" if f.ctype == "char" and kind != "str" else kind
+
+    out.extend(_aligned([(f"{f.name}: {annotation(f)}", f.comment) for f in data_fields], "    "))
+    return out
+
+
+def render_inblock(struct: CStruct, description: str) -> List[str]:
+    model = struct.name if struct.name.startswith("T") else f"T{struct.name}"
+    out = [
+        f"class {model}(InBlock):",
+        f'    """{description}"""',
+        "",
+        f"    C_STRUCT: ClassVar[Type[ctypes.Structure]] = CT{struct.name.removeprefix('T')}",
+        "",
+    ]
+    for f in struct.fields:
+        if f.is_attribute:
+            continue
+        if f.ctype != "char":
+            raise ValueError(f"{struct.name}: InBlock은 char 필드만 지원합니다: {f.name}")
+        description_arg = f", description={_quote(f.comment)}" if f.comment else ""
+        out.append(f"    {f.name}: str = Field(max_length={f.length}{description_arg})")
+    return out
+
+
+def render_module(code: str, structs: List[CStruct], source: str, infer: bool, arrays: set) -> str:
+    """TR 코드 1개의 모듈 소스"""
+    has_in = any(s.block_match.group("kind") == "InBlock" for s in structs)
+    body: List[str] = []
+    registrations: List[str] = []
+    exports: List[str] = []
+
+    for struct in structs:
+        match = struct.block_match
+        description = struct.comment or f"{code} {match.group('kind')}{match.group('index')}"
+        ct_name = f"CT{struct.name.removeprefix('T')}"
+        model = struct.name if struct.name.startswith("T") else f"T{struct.name}"
+
+        body.extend(["", ""])
+        body.extend(render_ctypes(struct, description))
+        body.extend(["", ""])
+        if match.group("kind") == "InBlock":
+            body.extend(render_inblock(struct, description))
+        else:
+            name = block_name(struct)
+            is_array = name in arrays or bool(re.search(r"occurs|반복", struct.comment, re.I))
+            body.extend(render_outblock(struct, description, infer, is_array))
+            array_arg = ", is_array=True" if is_array else ""
+            registrations.append(f'register_block("{name}", {ct_name}, {model}{array_arg})')
+        exports.extend([ct_name, model])
+
+    text = "\n".join(body)
+    imports = ["import ctypes", "from dataclasses import dataclass"]
+    if "dtime" in text:
+        imports.append("from datetime import time as dtime")
+    if "Decimal" in text:
+        imports.append("from decimal import Decimal")
+    typing_names = sorted(
+        name for name in ("ClassVar", "Optional", "Tuple", "Type") if f"{name}[" in text
+    )
+    if typing_names:
+        imports.append(f"from typing import {', '.join(typing_names)}")
+    if has_in:
+        imports.extend(["", "from pydantic import Field"])
+    imports.append("")
+    bases = ", ".join(name for name, used in (("InBlock", has_in), ("OutBlock", bool(registrations))) if used)
+    imports.append(f"from ..common import {bases}")
+    if registrations:
+        imports.append("from ..parser_info import register_block")
+
+    lines = [
+        f'"""{code} 블록 정의 ({source} 기반)',
+        "",
+        "tools/gen_blocks.py로 생성된 파일입니다. 직접 수정하지 말고 헤더에서 다시 생성하세요.",
+        '"""',
+        "",
+        *imports,
+        text,
+    ]
+    if registrations:
+        lines.extend([
+            "", "",
+            "# " + "=" * 78,
+            "# 파서 등록",
+            "# " + "=" * 78,
+            "",
+            *registrations,
+        ])
+    lines.extend(["", "", "__all__ = ["])
+    lines.extend(f'    "{name}",' for name in exports)
+    lines.append("]")
+    return "\n".join(lines) + "\n"
+
+
+def package_for(header: Path) -> str:
+    """헤더 파일명으로 출력 패키지 결정 (trio_ord.h → ord)"""
+    return header.stem.removeprefix("trio_").lower()
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    parser = argparse.ArgumentParser(description="SPEC 헤더(trio_*.h)에서 블록 정의 모듈 생성")
+    parser.add_argument("headers", nargs="+", type=Path, help="trio_*.h 헤더 파일")
+    parser.add_argument("--out", type=Path, default=None,
+                        help="출력 디렉터리 (기본값: src/pynamuh/structures/<헤더명>)")
+    parser.add_argument("--array", action="append", default=[], metavar="BLOCK",
+                        help="반복 블록으로 등록할 블록명 (여러 번 지정 가능)")
+    parser.add_argument("--infer-types", action="store_true",
+                        help="필드명으로 int/Decimal/time 타입 추정 (기본값: 모두 str)")
+    parser.add_argument("--encoding", default="cp949", help="헤더 인코딩 (기본값: cp949)")
+    parser.add_argument("--force", action="store_true", help="기존 파일 덮어쓰기")
+    args = parser.parse_args(argv)
+
+    arrays = set(args.array)
+    written: List[str] = []
+    for header in args.headers:
+        try:
+            structs = parse_header(header.read_text(encoding=args.encoding), header.name)
+        except (UnicodeDecodeError, ValueError) as e:
+            print(f"헤더 해석 실패: {header}: {e}", file=sys.stderr)
+            return 1
+        out_dir = args.out or STRUCTURES / package_for(header)
+
+        by_code: Dict[str, List[CStruct]] = {}
+        for struct in structs:
+            match = struct.block_match
+            if match is None:
+                print(f"건너뜀 (블록 이름 형식 아님): {struct.name}", file=sys.stderr)
+                continue
+            by_code.setdefault(match.group("code"), []).append(struct)
+
+        out_dir.mkdir(parents=True, exist_ok=True)
+        for code, group in by_code.items():
+            path = out_dir / f"{code}.py"
+            if path.exists() and not args.force:
+                print(f"건너뜀 (이미 존재, --force로 덮어쓰기): {path}", file=sys.stderr)
+                continue
+            path.write_text(render_module(code, group, header.name, args.infer_types, arrays), encoding="utf-8")
+            print(f"생성: {path}")
+            written.append(f"from .{out_dir.name} import {code} as _{code}  # noqa: F401")
+
+    if written:
+        print("\nstructures/__init__.py에 다음 import를 추가하세요:")
+        print("\n".join(written))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())